@@ -0,0 +1,122 @@
+//----------------------------------------------------------------------
+//
+//  Project:  Kionix driver demo
+//
+//     File:  latency-histogram.c
+//
+//  SPDX-License-Identifier: Apache-2.0
+//
+//----------------------------------------------------------------------
+
+#include <stdint.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+#include "latency-histogram.h"
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - routines
+//----------------------------------------------------------------------
+
+static uint32_t bucket_for(const uint32_t latency_us)
+{
+    uint32_t bucket = 0;
+
+    if ( latency_us == 0 )
+        { return 0; }
+
+    bucket = ( 32 - __builtin_clz(latency_us) );
+    return MIN(bucket, ( LATENCY_HISTOGRAM_BUCKETS - 1 ));
+}
+
+
+
+// Upper edge of bucket in microseconds:
+static uint32_t bucket_limit_us(const uint32_t bucket)
+{
+    return ( 1u << bucket );
+}
+
+
+
+void latency_histogram_add(struct latency_histogram* histogram, const uint32_t latency_us)
+{
+    atomic_val_t max = atomic_get(&histogram->max_us);
+
+    atomic_inc(&histogram->buckets[bucket_for(latency_us)]);
+    atomic_inc(&histogram->count);
+
+// Another context may raise max between get and set, so retry until ours holds or is beaten:
+    while ( ( latency_us > (uint32_t)max ) && !atomic_cas(&histogram->max_us, max, latency_us) )
+        { max = atomic_get(&histogram->max_us); }
+}
+
+
+
+static uint32_t percentile_limit_us(struct latency_histogram* histogram, const uint32_t count, const uint32_t percent)
+{
+    const uint32_t wanted = ( ( ( count * percent ) + 99 ) / 100 );
+    uint32_t seen = 0;
+    uint32_t i = 0;
+
+    for ( i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++ )
+    {
+        seen += (uint32_t)atomic_get(&histogram->buckets[i]);
+        if ( seen >= wanted )
+            { break; }
+    }
+
+    return bucket_limit_us(MIN(i, ( LATENCY_HISTOGRAM_BUCKETS - 1 )));
+}
+
+
+
+void latency_histogram_report(struct latency_histogram* histogram)
+{
+    const uint32_t count = (uint32_t)atomic_get(&histogram->count);
+    uint32_t in_bucket = 0;
+    uint32_t i = 0;
+
+    if ( count == 0 )
+    {
+        printk("- latency - %s:  no samples yet\n", histogram->name);
+        return;
+    }
+
+    printk("- latency - %s:  %u samples, p50 under %u us, p99 under %u us, max %u us\n",
+      histogram->name, count,
+      percentile_limit_us(histogram, count, 50),
+      percentile_limit_us(histogram, count, 99),
+      (uint32_t)atomic_get(&histogram->max_us));
+
+    for ( i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++ )
+    {
+        in_bucket = (uint32_t)atomic_get(&histogram->buckets[i]);
+        if ( in_bucket == 0 )
+            { continue; }
+
+        if ( i == ( LATENCY_HISTOGRAM_BUCKETS - 1 ) )
+            { printk("     %6u us and up    %u\n", ( bucket_limit_us(i) >> 1 ), in_bucket); }
+        else
+            { printk("     %6u to %6u us  %u\n", ( i == 0 ? 0 : ( bucket_limit_us(i) >> 1 ) ), bucket_limit_us(i), in_bucket); }
+    }
+}
+
+
+
+void latency_histogram_reset(struct latency_histogram* histogram)
+{
+    uint32_t i = 0;
+
+    for ( i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++ )
+        { atomic_clear(&histogram->buckets[i]); }
+    atomic_clear(&histogram->count);
+    atomic_clear(&histogram->max_us);
+}
+
+
+
+// --- EOF ---
@@ -0,0 +1,43 @@
+#ifndef KIONIX_KX132_DEMO__LATENCY_HISTOGRAM_H
+#define KIONIX_KX132_DEMO__LATENCY_HISTOGRAM_H
+
+//----------------------------------------------------------------------
+//
+//  Project:  Kionix driver demo
+//
+//     File:  latency-histogram.h
+//
+//    Brief:  Log bucketed latency histograms, safe to add to from
+//            interrupt and thread context alike.  Bucket 0 counts
+//            latencies under 1 us, bucket n counts 2^(n-1) us up to
+//            2^n us, and last bucket counts everything longer.
+//
+//----------------------------------------------------------------------
+
+#include <stdint.h>
+
+#include <zephyr/sys/atomic.h>
+
+#define LATENCY_HISTOGRAM_BUCKETS (18)     // last bucket holds 65536 us and up
+
+struct latency_histogram
+{
+    const char* name;
+    atomic_t buckets[LATENCY_HISTOGRAM_BUCKETS];
+    atomic_t count;
+    atomic_t max_us;
+};
+
+#define LATENCY_HISTOGRAM_DEFINE(var, label) \
+    static struct latency_histogram var = { .name = label }
+
+void latency_histogram_add(struct latency_histogram* histogram, const uint32_t latency_us);
+
+// Prints count, p50, p99 and max, then each non-empty bucket:
+void latency_histogram_report(struct latency_histogram* histogram);
+
+void latency_histogram_reset(struct latency_histogram* histogram);
+
+
+
+#endif // KIONIX_KX132_DEMO__LATENCY_HISTOGRAM_H
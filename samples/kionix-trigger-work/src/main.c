@@ -29,6 +29,31 @@
 #define DEV_TEST__KX132_ENABLE_SYNC_READINGS_WITH_HW_INTERRUPT (0)
 #define DEV_TEST__SET_KX132_1211_OUTPUT_DATA_RATE              (0)
 
+// Time KX132 data ready path, from DRDY edge through trigger handler to
+// x,y,z readings in RAM, and report histograms every so many loops:
+#define DEV_TEST__KX132_DRDY_LATENCY_HISTOGRAMS                (1)
+#define LATENCY_REPORT_EVERY_N_LOOPS                           (10)
+
+// KX132 trigger handler hands readings off to a work queue, which reads
+// x,y,z into a sample ring.  Triggers arriving while a read is queued
+// fold into that one read.  This flag sets ODR for interrupt paced
+// readings and reports them each main loop:
+#define DEV_TEST__KX132_WORK_QUEUE_READINGS                    (1)
+#define KX132_WORK_QUEUE_OUTPUT_DATA_RATE                      KX132_ODR_3200_HZ
+#define KX132_WORK_QUEUE_STACK_SIZE                            (1024)
+#define KX132_WORK_QUEUE_PRIORITY                              K_PRIO_COOP(2)
+#define KX132_SAMPLE_RING_CAPACITY                             (1024)
+
+// Rather than one SPI read per DRDY trigger, let KX132 collect readings
+// in its sample buffer and raise INT1 at a watermark, then drain whole
+// buffer in one SPI burst.  Needs DEV_TEST__KX132_WORK_QUEUE_READINGS:
+#define DEV_TEST__KX132_BUFFER_WATERMARK_STREAMING             (1)
+#define KX132_BUFFER_WATERMARK_SAMPLES                         (32)
+
+#if ( DEV_TEST__KX132_BUFFER_WATERMARK_STREAMING == 1 ) && ( DEV_TEST__KX132_WORK_QUEUE_READINGS != 1 )
+#error "KX132 buffer watermark streaming needs DEV_TEST__KX132_WORK_QUEUE_READINGS"
+#endif
+
 #define DEV_TEST__XYZ_READINGS_VIA_DIRECT_SPI_API_CALL
 //#define DEV_TEST__XYZ_READINGS_VIA_SEPARATE_REGISTER_READS
 
@@ -38,6 +63,8 @@
 #define SPI_MSBIT_SET     SPI_MSBIT_AUTOINC_REG_ADDR_SET
 #define SPI_MSBIT_CLEARED SPI_MSBIT_AUTOINC_REG_ADDR_CLEARED
 
+#define KX132_XYZ_BYTES (6)     // XOUT_L through ZOUT_H
+
 
 
 //----------------------------------------------------------------------
@@ -45,6 +72,7 @@
 //----------------------------------------------------------------------
 
 #include <stdio.h>                 // to provide snprintf()
+#include <errno.h>                 // to provide EINVAL
 
 #include <zephyr/kernel.h>
 
@@ -53,6 +81,9 @@
 #include <zephyr/drivers/sensor.h> // to provide 'struct sensor_value'
 
 #include <zephyr/drivers/spi.h>
+#include <zephyr/drivers/gpio.h>   // to provide gpio_add_callback()
+
+#include <zephyr/timing/timing.h>  // to provide timing_counter_get() and related
 
 // https://docs.zephyrproject.org/latest/services/logging/index.html#c.LOG_MODULE_REGISTER
 #include <zephyr/logging/log.h>
@@ -66,6 +97,11 @@ LOG_MODULE_REGISTER(kionix_driver_demo, LOG_LEVEL_DBG);
 //  outside the larger accelerometer device nested data structures:
 #include "int-gpio-inst.h"
 #include "main.h"
+#include "latency-histogram.h"
+
+// From Kionix Driver Demo app sources, in ../../src:
+#include "common.h"                // to provide struct acc_reading_triplet
+#include "sample-ring.h"
 
 
 
@@ -73,6 +109,34 @@ LOG_MODULE_REGISTER(kionix_driver_demo, LOG_LEVEL_DBG);
 // - SECTION - file scoped
 //----------------------------------------------------------------------
 
+// KX132 sample buffer and interrupt control, from KX132-1211 Technical
+// Reference Manual, for driver headers which do not define them:
+
+#ifndef KX132_BUF_CNTL1
+#define KX132_INT_REL     (0x1A)
+#define KX132_CNTL1       (0x1B)
+#define KX132_INC1        (0x1C)
+#define KX132_INC4        (0x1F)
+#define KX132_BUF_CNTL1   (0x5E)
+#define KX132_BUF_CNTL2   (0x5F)
+#define KX132_BUF_STATUS_1 (0x60)
+#define KX132_BUF_STATUS_2 (0x61)
+#define KX132_BUF_CLEAR   (0x62)
+#define KX132_BUF_READ    (0x63)
+#endif
+
+#define KX132_CNTL1_PC1           (1 << 7)   // operating mode, cleared for standby while configuring
+#define KX132_INC1_IEN1           (1 << 5)   // enable INT1 pin
+#define KX132_INC1_IEA1           (1 << 4)   // INT1 active high, left clear IEL1 latches it until INT_REL read
+#define KX132_INC4_WMI1           (1 << 5)   // buffer watermark interrupt on INT1
+#define KX132_BUF_CNTL2_BUFE      (1 << 7)   // sample buffer enabled
+#define KX132_BUF_CNTL2_BRES      (1 << 6)   // 16-bit samples in buffer
+#define KX132_BUF_CNTL2_BM_STREAM (0x01)     // stream mode, oldest sample dropped when full
+
+// Buffer holds 86 sixteen bit samples, and BUF_STATUS reports its level in bytes:
+#define KX132_BUFFER_MAX_SAMPLES  (86)
+#define KX132_BUFFER_LEVEL_MASK   (0x03FF)
+
 #if BUILD_FOR_SPI_CONNECTED_SENSOR == 1
 #define SIZE_SPI_TX_BUFFER 32
 #define SIZE_SPI_RX_BUFFER 32
@@ -80,6 +144,9 @@ LOG_MODULE_REGISTER(kionix_driver_demo, LOG_LEVEL_DBG);
 uint8_t spi_tx_buffer[SIZE_SPI_TX_BUFFER] = { 0 };
 uint8_t spi_rx_buffer[SIZE_SPI_RX_BUFFER] = { 0 };
 
+// SPI buffers above serve main loop and KX132 trigger handler thread alike:
+K_MUTEX_DEFINE(spi_buffers_lock);
+
 // # REF zephyr/samples/drivers/spi_bitbang/src/main.c line 63
 const int stride = sizeof(spi_tx_buffer[0]);
 
@@ -112,6 +179,49 @@ union generic_data_four_bytes_union_t {
 #ifdef CONFIG_KX132_TRIGGER
 #warning "compiling KX132 sensor_trigger file scoped instance,"
 static struct sensor_trigger trig;
+
+// Readings are taken by work item on a cooperative work queue, which
+// therefore runs each read to completion ahead of driver's trigger
+// thread.  Trigger handler only stamps, counts and submits:
+K_THREAD_STACK_DEFINE(kx132_work_queue_stack, KX132_WORK_QUEUE_STACK_SIZE);
+static struct k_work_q kx132_work_queue;
+static struct k_work kx132_readings_work;
+static const struct device *kx132_readings_device;
+
+static atomic_t kx132_pending_triggers = ATOMIC_INIT(0);
+static atomic_t kx132_trigger_cycles = ATOMIC_INIT(0);     // cycle count of latest trigger
+static atomic_t kx132_coalesced_triggers = ATOMIC_INIT(0);
+static uint32_t kx132_reading_sequence = 0;                // work queue owned
+
+// Latest readings taken by work item:
+static uint8_t latest_xyz_raw[KX132_XYZ_BYTES];
+
+SAMPLE_RING_DEFINE(kx132_sample_ring, KX132_SAMPLE_RING_CAPACITY);
+
+#if DEV_TEST__KX132_BUFFER_WATERMARK_STREAMING == 1
+static uint8_t kx132_buffer_bytes[( KX132_BUFFER_MAX_SAMPLES * KX132_XYZ_BYTES )];
+static struct acc_sample_record kx132_buffer_records[KX132_BUFFER_MAX_SAMPLES];
+static uint32_t kx132_buffer_drain_count = 0;
+static uint32_t kx132_buffer_full_count = 0;   // drains which found buffer full, readings may be lost
+#endif
+#endif
+
+#if ( DEV_TEST__KX132_DRDY_LATENCY_HISTOGRAMS == 1 ) && defined(CONFIG_KX132_TRIGGER)
+// Our GPIO callback rides along with the driver's on the DRDY pin, only
+// to stamp each edge.  When handler runs late and a second edge arrives
+// first, the stamp is of the newer edge:
+static struct gpio_callback drdy_stamp_callback;
+static volatile timing_t drdy_edge_stamp;
+static volatile uint32_t drdy_edge_stamped = 0;
+
+// Stamps of latest trigger, for work item which reads its data:
+static timing_t trigger_stamp;
+static timing_t trigger_edge_stamp;
+static uint32_t trigger_edge_stamped = 0;
+
+LATENCY_HISTOGRAM_DEFINE(drdy_to_trigger_latency, "DRDY edge to trigger handler");
+LATENCY_HISTOGRAM_DEFINE(trigger_to_data_latency, "trigger handler to data in RAM");
+LATENCY_HISTOGRAM_DEFINE(drdy_to_data_latency, "DRDY edge to data in RAM");
 #endif
 
 
@@ -120,22 +230,166 @@ static struct sensor_trigger trig;
 // - SECTION - routines
 //----------------------------------------------------------------------
 
+#if ( DEV_TEST__KX132_DRDY_LATENCY_HISTOGRAMS == 1 ) && defined(CONFIG_KX132_TRIGGER)
+static void drdy_edge_stamp_handler(const struct device *port, struct gpio_callback *cb, uint32_t pins)
+{
+    drdy_edge_stamp = timing_counter_get();
+    drdy_edge_stamped = 1;
+}
+
+
+
+static uint32_t latency_in_us(volatile timing_t* start, volatile timing_t* end)
+{
+    return (uint32_t)( timing_cycles_to_ns(timing_cycles_get(start, end)) / 1000 );
+}
+#endif
+
+
+
+static uint32_t read_registers(const struct device *dev, const uint8_t* device_register,
+                               uint8_t* data, uint8_t len, uint8_t option);
+
 #ifdef CONFIG_KX132_TRIGGER
+#if DEV_TEST__KX132_BUFFER_WATERMARK_STREAMING == 1
+static uint32_t read_buffer_burst(const struct device *dev, uint8_t* data, const uint16_t len);
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Read KX132 buffer level, drain every sample it holds with
+ *           one SPI burst, and push readings to KX132 sample ring, all
+ *           stamped with cycle count of watermark trigger.  Reading
+ *           INT_REL afterwards releases latched INT1 for next
+ *           watermark.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+static void kx132_drain_sample_buffer(void)
+{
+    const uint8_t status_register[1] = { KX132_BUF_STATUS_1 };
+    const uint8_t int_rel_register[1] = { KX132_INT_REL };
+    const uint32_t timestamp = (uint32_t)atomic_get(&kx132_trigger_cycles);
+    uint8_t status[2] = { 0, 0 };
+    uint8_t released = 0;
+    uint32_t samples = 0;
+    uint32_t i = 0;
+
+    read_registers(kx132_readings_device, status_register, status, 2, SPI_MSBIT_CLEARED);
+    samples = ( ( ( status[0] | ( status[1] << 8 ) ) & KX132_BUFFER_LEVEL_MASK ) / KX132_XYZ_BYTES );
+    samples = MIN(samples, KX132_BUFFER_MAX_SAMPLES);
+
+    if ( samples == KX132_BUFFER_MAX_SAMPLES )
+        { kx132_buffer_full_count++; }
+
+    if ( samples > 0 )
+    {
+        read_buffer_burst(kx132_readings_device, kx132_buffer_bytes, ( samples * KX132_XYZ_BYTES ));
+
+        for ( i = 0; i < samples; i++ )
+        {
+            const uint8_t* raw = &kx132_buffer_bytes[( i * KX132_XYZ_BYTES )];
+
+            kx132_buffer_records[i].timestamp = timestamp;
+            kx132_buffer_records[i].sequence = kx132_reading_sequence++;
+            kx132_buffer_records[i].xyz.x = (uint16_t)( raw[0] | ( raw[1] << 8 ) );
+            kx132_buffer_records[i].xyz.y = (uint16_t)( raw[2] | ( raw[3] << 8 ) );
+            kx132_buffer_records[i].xyz.z = (uint16_t)( raw[4] | ( raw[5] << 8 ) );
+            sample_ring_push(&kx132_sample_ring, &kx132_buffer_records[i]);
+        }
+
+        memcpy(latest_xyz_raw, &kx132_buffer_bytes[( ( samples - 1 ) * KX132_XYZ_BYTES )], KX132_XYZ_BYTES);
+    }
+
+    read_registers(kx132_readings_device, int_rel_register, &released, 1, SPI_MSBIT_CLEARED);
+    kx132_buffer_drain_count++;
+}
+#endif
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Burst read XOUT_L..ZOUT_H once for however many triggers
+ *           arrived since last read, and push timestamped reading to
+ *           KX132 sample ring.  Sequence advances by trigger count,
+ *           so a consumer sees coalesced triggers as sequence gaps.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+static void kx132_readings_work_handler(struct k_work *work)
+{
+    const uint32_t triggers = (uint32_t)atomic_set(&kx132_pending_triggers, 0);
+#if DEV_TEST__KX132_BUFFER_WATERMARK_STREAMING == 0
+    const uint8_t xyz_register[1] = { KX132_XOUT_L };
+    struct acc_sample_record record;
+#endif
+#if DEV_TEST__KX132_DRDY_LATENCY_HISTOGRAMS == 1
+    timing_t data_in_ram;
+#endif
+
+// Trigger counted by an earlier run of this work item:
+    if ( triggers == 0 )
+        { return; }
+
+#if DEV_TEST__KX132_BUFFER_WATERMARK_STREAMING == 1
+    kx132_drain_sample_buffer();
+#else
+    read_registers(kx132_readings_device, xyz_register, latest_xyz_raw, KX132_XYZ_BYTES, SPI_MSBIT_CLEARED);
+#endif
+
+#if DEV_TEST__KX132_DRDY_LATENCY_HISTOGRAMS == 1
+    data_in_ram = timing_counter_get();
+    latency_histogram_add(&trigger_to_data_latency, latency_in_us(&trigger_stamp, &data_in_ram));
+    if ( trigger_edge_stamped )
+        { latency_histogram_add(&drdy_to_data_latency, latency_in_us(&trigger_edge_stamp, &data_in_ram)); }
+#endif
+
+    if ( triggers > 1 )
+        { atomic_add(&kx132_coalesced_triggers, (atomic_val_t)( triggers - 1 )); }
+
+#if DEV_TEST__KX132_BUFFER_WATERMARK_STREAMING == 0
+    kx132_reading_sequence += triggers;
+    record.timestamp = (uint32_t)atomic_get(&kx132_trigger_cycles);
+    record.sequence = ( kx132_reading_sequence - 1 );
+    record.xyz.x = (uint16_t)( latest_xyz_raw[0] | ( latest_xyz_raw[1] << 8 ) );
+    record.xyz.y = (uint16_t)( latest_xyz_raw[2] | ( latest_xyz_raw[3] << 8 ) );
+    record.xyz.z = (uint16_t)( latest_xyz_raw[4] | ( latest_xyz_raw[5] << 8 ) );
+
+    sample_ring_push(&kx132_sample_ring, &record);
+#endif
+}
+
+
+
 #warning "- In demo main.c - compiling KX132 trigger handler,"
 static void trigger_handler(const struct device *dev, 
                             const struct sensor_trigger *trig)
 
 {
-//    struct sensor_value xyz_readings;
-//    static size_t cnt;
-//    int rc;
+#if DEV_TEST__KX132_DRDY_LATENCY_HISTOGRAMS == 1
+    timing_t edge = drdy_edge_stamp;
+    timing_t triggered = timing_counter_get();
+
+    trigger_stamp = triggered;
+    trigger_edge_stamp = edge;
+    trigger_edge_stamped = drdy_edge_stamped;
+    if ( trigger_edge_stamped )
+        { latency_histogram_add(&drdy_to_trigger_latency, latency_in_us(&edge, &triggered)); }
+#endif
 
 // # REF https://github.com/zephyrproject-rtos/zephyr/blob/main/include/zephyr/drivers/sensor.h#L61
 #if 0
     printk("\n- KX132 demo app - interrupt of type SENSOR_TRIG_DATA_READY detected,\n");
     printk("- KX132 demo app - for sensor channel SENSOR_CHAN_ACCEL_XYZ\n\n");
-#endif
     printk("- DEV 1206 - sensor interrupt / trigger handler called!\n");
+#endif
+
+    kx132_readings_device = dev;
+    atomic_set(&kx132_trigger_cycles, (atomic_val_t)k_cycle_get_32());
+    atomic_inc(&kx132_pending_triggers);
+
+// Already queued work item stays queued once, which is what coalesces triggers:
+    k_work_submit_to_queue(&kx132_work_queue, &kx132_readings_work);
 }
 #endif
 
@@ -165,6 +419,8 @@ static uint32_t read_registers(const struct device *dev,       // Zephyr pointer
         return rstatus;
     }
 
+    k_mutex_lock(&spi_buffers_lock, K_FOREVER);
+
     memset(spi_rx_buffer, 0, SIZE_SPI_RX_BUFFER);
     rx_set.buffers = &rx_buf;
     rx_set.count = 1;
@@ -190,6 +446,8 @@ static uint32_t read_registers(const struct device *dev,       // Zephyr pointer
 
     memcpy(data, &spi_rx_buffer[1], len);
 
+    k_mutex_unlock(&spi_buffers_lock);
+
 // * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 
 #if 0
@@ -289,6 +547,34 @@ printk("\n");
 
 
 
+#if ( DEV_TEST__KX132_BUFFER_WATERMARK_STREAMING == 1 ) && defined(CONFIG_KX132_TRIGGER)
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Read len bytes from KX132 BUF_READ in one SPI transaction.
+ *           BUF_READ address does not advance, so each further byte
+ *           comes from sample buffer.  Reads straight into caller's
+ *           buffer, not through 32 byte spi_rx_buffer.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+static uint32_t read_buffer_burst(const struct device *dev, uint8_t* data, const uint16_t len)
+{
+    const struct kx132_device_config *cfg = dev->config;
+    uint8_t buffer_read_addr = ( KX132_BUF_READ | 0x80 );  // 0x80 read bit
+    const struct spi_buf burst_tx_buf = { .buf = &buffer_read_addr, .len = 1 };
+    const struct spi_buf burst_rx_bufs[2] = {
+        { .buf = NULL, .len = 1 },   // byte clocked in while address goes out
+        { .buf = data, .len = len }
+    };
+    const struct spi_buf_set burst_tx = { .buffers = &burst_tx_buf, .count = 1 };
+    const struct spi_buf_set burst_rx = { .buffers = burst_rx_bufs, .count = 2 };
+
+    return spi_transceive(cfg->spi.bus, &cfg->spi.config, &burst_tx, &burst_rx);
+}
+#endif
+
+
+
 //----------------------------------------------------------------------
 // - SECTION - tests
 //----------------------------------------------------------------------
@@ -485,6 +771,77 @@ uint32_t tests_of_macro_GPIO_DT_SPEC_INST_GET_OR(void)
 
 
 
+#ifdef CONFIG_KX132_TRIGGER
+uint32_t test__kx132_start_readings_work_queue(void)
+{
+    const struct k_work_queue_config config = { .name = "kx132_work_q" };
+
+    k_work_init(&kx132_readings_work, kx132_readings_work_handler);
+    k_work_queue_start(&kx132_work_queue, kx132_work_queue_stack,
+                       K_THREAD_STACK_SIZEOF(kx132_work_queue_stack), KX132_WORK_QUEUE_PRIORITY, &config);
+
+    return KX132_DEMO_ROUTINE_OK;
+}
+#endif
+
+
+
+#if ( DEV_TEST__KX132_BUFFER_WATERMARK_STREAMING == 1 ) && defined(CONFIG_KX132_TRIGGER)
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Put KX132 in standby, enable 16-bit stream mode sample
+ *           buffer with watermark interrupt latched on INT1, in place
+ *           of data ready, and return sensor to operating mode.  ODR
+ *           and range settings stay as they were.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+uint32_t test__kx132_enable_buffer_watermark_streaming(const struct device *dev, const uint8_t watermark)
+{
+    uint8_t reg[1] = { 0 };
+    uint8_t value[2] = { 0, 0 };
+    uint8_t cntl1 = 0;
+    uint32_t rstatus = 0;
+
+    if ( dev == NULL ) { return KX132_DEMO__ZEPHYR_DEVICE_POINTER_NULL; }
+
+    printk("- MARK 4 - enabling KX132 buffer, watermark %u readings . . .\n", watermark);
+
+    reg[0] = KX132_CNTL1;
+    rstatus |= read_registers(dev, reg, &cntl1, 1, SPI_MSBIT_CLEARED);
+    value[0] = ( cntl1 & ~KX132_CNTL1_PC1 );
+    rstatus |= write_registers(dev, reg, value, 1, SPI_MSBIT_CLEARED);
+
+    reg[0] = KX132_BUF_CNTL1;
+    value[0] = MIN(watermark, KX132_BUFFER_MAX_SAMPLES);
+    rstatus |= write_registers(dev, reg, value, 1, SPI_MSBIT_CLEARED);
+
+    reg[0] = KX132_BUF_CNTL2;
+    value[0] = ( KX132_BUF_CNTL2_BUFE | KX132_BUF_CNTL2_BRES | KX132_BUF_CNTL2_BM_STREAM );
+    rstatus |= write_registers(dev, reg, value, 1, SPI_MSBIT_CLEARED);
+
+    reg[0] = KX132_INC1;
+    value[0] = ( KX132_INC1_IEN1 | KX132_INC1_IEA1 );
+    rstatus |= write_registers(dev, reg, value, 1, SPI_MSBIT_CLEARED);
+
+    reg[0] = KX132_INC4;
+    value[0] = KX132_INC4_WMI1;
+    rstatus |= write_registers(dev, reg, value, 1, SPI_MSBIT_CLEARED);
+
+    reg[0] = KX132_BUF_CLEAR;
+    value[0] = 0;
+    rstatus |= write_registers(dev, reg, value, 1, SPI_MSBIT_CLEARED);
+
+    reg[0] = KX132_CNTL1;
+    value[0] = ( cntl1 | KX132_CNTL1_PC1 );
+    rstatus |= write_registers(dev, reg, value, 1, SPI_MSBIT_CLEARED);
+
+    return rstatus;
+}
+#endif
+
+
+
 uint32_t test__kx132_assign_routine_to_sensor_interrupt(const struct device *dev)
 {
     int rstatus = 0;
@@ -510,6 +867,41 @@ uint32_t test__kx132_assign_routine_to_sensor_interrupt(const struct device *dev
 
 
 
+#if ( DEV_TEST__KX132_DRDY_LATENCY_HISTOGRAMS == 1 ) && defined(CONFIG_KX132_TRIGGER)
+uint32_t test__kx132_stamp_drdy_edges(void)
+{
+    int rstatus = 0;
+
+    if ( int_gpio_diag1.port == NULL )
+    {
+        printk("- main.c - no DRDY GPIO in devicetree, latency from DRDY edge not measured\n");
+        return KX132_DEMO__DRDY_GPIO_UNAVAILABLE;
+    }
+
+    timing_init();
+    timing_start();
+
+// Added after driver's own callback, so runs ahead of it on each edge:
+    gpio_init_callback(&drdy_stamp_callback, drdy_edge_stamp_handler, BIT(int_gpio_diag1.pin));
+    rstatus = gpio_add_callback(int_gpio_diag1.port, &drdy_stamp_callback);
+    printk("- main.c - DRDY edge stamp callback added, status %d\n", rstatus);
+
+    return rstatus;
+}
+
+
+
+static void report_drdy_latency_histograms(void)
+{
+    latency_histogram_report(&drdy_to_trigger_latency);
+    latency_histogram_report(&trigger_to_data_latency);
+    latency_histogram_report(&drdy_to_data_latency);
+    printk("\n");
+}
+#endif
+
+
+
 uint32_t test__check_possibly_reinit_sensor_interrupt_port(const struct device *dev)
 {
     struct sensor_value requested_config;   // we use sensor_value struct to pass requested sensor configuration defined values
@@ -589,88 +981,71 @@ enum kx132_acceleration_resolutions_e
 #endif // KX132_ACCELEROMETER_RANGE_DEFINES
 
 
-enum acceleration_units_of_measure_e
-{
-    ACCELERATION_IN_G,
-    ACCELERATION_IN_M_PER_S_SQUARED
-};
+// Full scale range in milli-g, indexed by enum kx132_acceleration_ranges_e:
+static const int32_t kx132_full_scale_in_milli_g[KX132_ACCEL_RANGES_END] = { 0, 2000, 4000, 8000, 16000 };
+
+// Sixteen bit readings span -32768 to 32767 across the full scale range:
+#define KX132_RANGE_RES_HIGH_SHIFT_TO_MILLI_G (15)
 
-// https://en.wikipedia.org/wiki/Gravitational_acceleration
-// https://en.wikipedia.org/wiki/Standard_gravity
-#define ACCELERATION_OF_GRAVITY_AT_EARTH_MEAN_SURFACE 9.8067
 
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Convert a block of two's complement KX132 readings to
+ *           milli-g.  Range and resolution looked up once per block,
+ *           readings converted with one integer multiply and shift.
+ *           In 8-bit low resolution mode only high byte holds data.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
 
-float reading_in_g(const uint32_t reading_in_dec_counts,
-                   const enum kx132_acceleration_resolutions_e resolution,
-                   const enum kx132_acceleration_ranges_e range,
-                   const enum acceleration_units_of_measure_e desired_units)
+int kx132_readings_to_milli_g(const int16_t* readings,
+                              int32_t* readings_in_milli_g,
+                              const uint32_t reading_count,
+                              const enum kx132_acceleration_resolutions_e resolution,
+                              const enum kx132_acceleration_ranges_e range)
 {
-    int32_t decimal_count_max = 0;
-    int32_t decimal_count_min = 0;
-    float units_of_g_range_max = 0.0;
-    float units_of_g_range_min = 0.0;
-    float reading = 0.0;
+    int32_t full_scale = 0;
+    int32_t mask = ( resolution == KX132_ACCEL_RESOLUTION_LOW ? ~0xFF : ~0 );
+    uint32_t i = 0;
 
-// For 16-bit, high resolution readings:
+    if ( ( range <= KX132_ACCEL_RANGES_BEGIN ) || ( range >= KX132_ACCEL_RANGES_END ) )
     {
-// NEED to consider bounds check on reading to keep within unsigned 0x0000 to 0xFFFF, 16-bit range of values.
-
-        decimal_count_max = KX132_RANGE_RES_HIGH_DECIMAL_COUNTS_MAX;
-        decimal_count_min = KX132_RANGE_RES_HIGH_DECIMAL_COUNTS_MIN;
-
-        switch (range)
-        {
-            case KX132_RANGE_PLUS_MINUS_2G:
-                units_of_g_range_max = KX132_RANGE_RES_HIGH_2G_MAX;
-                units_of_g_range_min = KX132_RANGE_RES_HIGH_2G_MIN;
-                break;
-
-            case KX132_RANGE_PLUS_MINUS_4G:
-                units_of_g_range_max = KX132_RANGE_RES_HIGH_4G_MAX;
-                units_of_g_range_min = KX132_RANGE_RES_HIGH_4G_MIN;
-                break;
-
-            case KX132_RANGE_PLUS_MINUS_8G:
-                units_of_g_range_max = KX132_RANGE_RES_HIGH_8G_MAX;
-                units_of_g_range_min = KX132_RANGE_RES_HIGH_8G_MIN;
-                break;
-
-            case KX132_RANGE_PLUS_MINUS_16G:
-                units_of_g_range_max = KX132_RANGE_RES_HIGH_16G_MAX;
-                units_of_g_range_min = KX132_RANGE_RES_HIGH_16G_MIN;
-                break;
-
-            default:
-                printk("- WARNING - unsupported KX132 ");
-                return reading;
-        }
+        printk("- WARNING - unsupported KX132 range %u\n", range);
+        return -EINVAL;
     }
 
-// NEED to add low-res conversion code - TMH
+    full_scale = kx132_full_scale_in_milli_g[range];
 
-// For 8-bit, high resolution readings:
+    for ( i = 0; i < reading_count; i++ )
     {
-// NEED to consider bounds check on reading to keep within unsigned 0x00 to 0xFF, 8-bit range of values.
+        readings_in_milli_g[i] = ( ( ( (int32_t)readings[i] & mask ) * full_scale ) >> KX132_RANGE_RES_HIGH_SHIFT_TO_MILLI_G );
     }
 
+    return 0;
+}
 
-// Incoming reading in two's compliment needs to be scaled by a factor of
-//
-//   units of G range
-// --------------------
-// decimal counts range
 
-    reading = ( (int16_t)reading_in_dec_counts * ( (units_of_g_range_max - units_of_g_range_min) /
-                ((float)decimal_count_max - (float)decimal_count_min)
-              ) );
 
-    if ( desired_units == ACCELERATION_IN_M_PER_S_SQUARED )
-    {
-        reading *= ACCELERATION_OF_GRAVITY_AT_EARTH_MEAN_SURFACE;
-    }
+#if ( DEV_TEST__KX132_WORK_QUEUE_READINGS == 1 ) && defined(CONFIG_KX132_TRIGGER)
+static void report_kx132_work_queue_readings(void)
+{
+    int16_t xyz_raw[3] = { 0 };
+    int32_t xyz_in_milli_g[3] = { 0 };
+    uint32_t i = 0;
+
+    for ( i = 0; i < 3; i++ )
+        { xyz_raw[i] = (int16_t)( latest_xyz_raw[(2 * i)] | ( latest_xyz_raw[(2 * i) + 1] << 8 ) ); }
+    kx132_readings_to_milli_g(xyz_raw, xyz_in_milli_g, 3, KX132_ACCEL_RESOLUTION_HIGH, KX132_RANGE_PLUS_MINUS_2G);
 
-    return reading;
+    printk("- main.c - work queue read %u readings, %u triggers coalesced, %u ring overflows,\n",
+      kx132_reading_sequence, (uint32_t)atomic_get(&kx132_coalesced_triggers),
+      sample_ring_overflow_count(&kx132_sample_ring));
+#if DEV_TEST__KX132_BUFFER_WATERMARK_STREAMING == 1
+    printk("- main.c - %u buffer drains, %u found buffer full,\n", kx132_buffer_drain_count, kx132_buffer_full_count);
+#endif
+    printk("- main.c - latest x,y,z in milli-g:  %d, %d, %d\n\n",
+      xyz_in_milli_g[0], xyz_in_milli_g[1], xyz_in_milli_g[2]);
 }
+#endif
 
 
 
@@ -748,7 +1123,11 @@ void main(void)
 
 
 #ifdef CONFIG_KX132_TRIGGER
+    rstatus = test__kx132_start_readings_work_queue();
     rstatus = test__kx132_assign_routine_to_sensor_interrupt(dev_kx132_1);
+#if DEV_TEST__KX132_DRDY_LATENCY_HISTOGRAMS == 1
+    rstatus = test__kx132_stamp_drdy_edges();
+#endif
 #endif
 
 
@@ -761,6 +1140,14 @@ void main(void)
     printk("\n\n- DEV 1205 - main.c, testing stub for local SPI writes . . .\n");
     rstatus = update_output_data_rate(dev_kx132_1);
 
+#if ( DEV_TEST__KX132_WORK_QUEUE_READINGS == 1 ) && defined(CONFIG_KX132_TRIGGER)
+// Test above leaves ODR at 50 Hz, so set rate for interrupt paced readings after it:
+    rstatus = test__set_kx132_output_data_rate(dev_kx132_1, KX132_WORK_QUEUE_OUTPUT_DATA_RATE);
+#if DEV_TEST__KX132_BUFFER_WATERMARK_STREAMING == 1
+    rstatus = test__kx132_enable_buffer_watermark_streaming(dev_kx132_1, KX132_BUFFER_WATERMARK_SAMPLES);
+#endif
+#endif
+
 
 //
 // ----------
@@ -771,6 +1158,8 @@ void main(void)
     char data[SIZE_OF_SPI_TEST_DATA_BUFFER] = { 0 };
     memset(data, 0, SIZE_OF_SPI_TEST_DATA_BUFFER);
     char *data_ptr = data;
+    int16_t xyz_raw[3] = { 0 };
+    int32_t xyz_in_milli_g[3] = { 0 };
 // ----------
 //
 
@@ -858,10 +1247,11 @@ void main(void)
               (data[0]+(data[1]<<8)), (data[2]+(data[3]<<8)), (data[4]+(data[5]<<8)));
             printk("%s", lbuf);
 
-            printk("- DEV 1207 - reading of z-axis acceleration in g:  %3.2f m/s^2\n",
-              (reading_in_g(data[4] + (data[5] << 8), KX132_ACCEL_RESOLUTION_HIGH, KX132_RANGE_PLUS_MINUS_2G,
-               ACCELERATION_IN_M_PER_S_SQUARED))
-            );
+            for ( i = 0; i < 3; i++ )
+                { xyz_raw[i] = (int16_t)( (uint8_t)data[(2 * i)] | ( (uint8_t)data[(2 * i) + 1] << 8 ) ); }
+            kx132_readings_to_milli_g(xyz_raw, xyz_in_milli_g, 3, KX132_ACCEL_RESOLUTION_HIGH, KX132_RANGE_PLUS_MINUS_2G);
+            printk("- DEV 1207 - x,y,z acceleration in milli-g:  %d, %d, %d\n",
+              xyz_in_milli_g[0], xyz_in_milli_g[1], xyz_in_milli_g[2]);
             printk("\n\n");
 #endif
 
@@ -878,6 +1268,15 @@ void main(void)
             printk("%s", lbuf);
         } // if dev_kx132_1 != NULL
 
+#if ( DEV_TEST__KX132_DRDY_LATENCY_HISTOGRAMS == 1 ) && defined(CONFIG_KX132_TRIGGER)
+        if ( ( main_loop_count % LATENCY_REPORT_EVERY_N_LOOPS ) == 0 )
+            { report_drdy_latency_histograms(); }
+#endif
+
+#if ( DEV_TEST__KX132_WORK_QUEUE_READINGS == 1 ) && defined(CONFIG_KX132_TRIGGER)
+        report_kx132_work_queue_readings();
+#endif
+
         k_msleep(SLEEP_TIME_MS);
         ++main_loop_count;
 
@@ -8,6 +8,7 @@ enum kionix_demo_return_values_e
     KX132_DEMO_ROUTINE_OK,
     KX132_DEMO__ZEPHYR_DEVICE_POINTER_NULL,
     KX132_DEMO__SENSOR_TRIGGER_ROUTINE_SET_FAILED,
+    KX132_DEMO__DRDY_GPIO_UNAVAILABLE,
 
     KX132_DEMO__LAST_ENUMERATED_RETURN_VALUE
 };
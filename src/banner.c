@@ -53,6 +53,8 @@ uint32_t cli__kd_version(const char* args)
     return rstatus;
 }
 
+KD_CLI_COMMAND_DEFINE(version, "version", "show this Kionix Driver Demo version info", &cli__kd_version);
+
 
 
 uint32_t cli__banner_message(const char* args)
@@ -70,6 +72,8 @@ uint32_t cli__banner_message(const char* args)
     return rstatus;
 }
 
+KD_CLI_COMMAND_DEFINE(banner, "banner", "show brief project identifier string for this Zephyr based app", &cli__banner_message);
+
 
 
 
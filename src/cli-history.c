@@ -0,0 +1,199 @@
+/*
+ * ---------------------------------------------------------------------
+ *
+ *  @Project   Kionix Driver Demo
+ *
+ *  @File      cli-history.c
+ *
+ *  @Brief     Command line history in one byte ring, entries stored
+ *   as a length byte, the command text, then the length byte again.
+ *   Leading length lets oldest entry be evicted from tail, trailing
+ *   length lets recall walk back from newest entry at head.
+ *
+ *  @Note      Indices are free running 32-bit counters masked with
+ *   (KD_APP_CLI_HISTORY_BYTES - 1), as in sample-ring.c.
+ *
+ * ---------------------------------------------------------------------
+ */
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - pound includes
+//----------------------------------------------------------------------
+
+#include <stdint.h>                // to provide define of uint32_t
+#include <string.h>                // to provide memset()
+
+#include <zephyr.h>                // to provide BUILD_ASSERT() and STRINGIFY()
+
+#include "cli-history.h"
+#include "kd-app-config.h"
+#include "return-values.h"
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - pound defines
+//----------------------------------------------------------------------
+
+// Longest entry fits a one byte length:
+#define CLI_HISTORY_MAX_ENTRY_LENGTH (255)
+
+#define CLI_HISTORY_MASK (KD_APP_CLI_HISTORY_BYTES - 1)
+
+BUILD_ASSERT((KD_APP_CLI_HISTORY_BYTES & CLI_HISTORY_MASK) == 0, "CLI history size must be power of two");
+BUILD_ASSERT(KD_APP_CLI_HISTORY_BYTES >= 64, "CLI history too small to be useful");
+
+#pragma message("CLI history ring uses " STRINGIFY(KD_APP_CLI_HISTORY_BYTES) " bytes of RAM")
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - file scoped variables
+//----------------------------------------------------------------------
+
+static uint8_t history_bytes[KD_APP_CLI_HISTORY_BYTES];
+static uint32_t history_head;      // free running, where next entry starts
+static uint32_t history_tail;      // free running, where oldest entry starts
+static uint32_t history_entries;
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - routine definitions
+//----------------------------------------------------------------------
+
+static inline uint8_t byte_at(const uint32_t index)
+{
+    return history_bytes[index & CLI_HISTORY_MASK];
+}
+
+
+
+void cli_history_init(void)
+{
+    memset(history_bytes, 0, sizeof(history_bytes));
+    history_head = 0;
+    history_tail = 0;
+    history_entries = 0;
+}
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Append command line to history, evicting oldest entries
+ *           until it fits.  Empty lines and repeats of newest entry
+ *           are not stored.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+uint32_t cli_history_add(const char* line, const uint32_t length)
+{
+    uint32_t needed = length + 2;
+    uint32_t newest_length = 0;
+    uint32_t i = 0;
+
+    if ( length == 0 )
+    {
+        return ROUTINE_OK;
+    }
+
+    if (( length > CLI_HISTORY_MAX_ENTRY_LENGTH ) || ( needed > KD_APP_CLI_HISTORY_BYTES ))
+    {
+        return KD__CLI_HISTORY_ENTRY_TOO_LONG;
+    }
+
+    if ( history_entries > 0 )
+    {
+        newest_length = byte_at(history_head - 1);
+        if ( newest_length == length )
+        {
+            for ( i = 0; i < length; i++ )
+            {
+                if ( byte_at(history_head - 1 - length + i) != (uint8_t)line[i] )
+                    { break; }
+            }
+            if ( i == length )
+                { return ROUTINE_OK; }
+        }
+    }
+
+    while ( ( (history_head - history_tail) + needed ) > KD_APP_CLI_HISTORY_BYTES )
+    {
+        history_tail += (byte_at(history_tail) + 2);
+        history_entries--;
+    }
+
+    history_bytes[history_head & CLI_HISTORY_MASK] = (uint8_t)length;
+    for ( i = 0; i < length; i++ )
+    {
+        history_bytes[(history_head + 1 + i) & CLI_HISTORY_MASK] = (uint8_t)line[i];
+    }
+    history_bytes[(history_head + 1 + length) & CLI_HISTORY_MASK] = (uint8_t)length;
+
+    history_head += needed;
+    history_entries++;
+
+    return ROUTINE_OK;
+}
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Copy history entry to caller's buffer, null terminated and
+ *           truncated to fit line_size.  'back' of 1 is newest entry.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+uint32_t cli_history_entry(const uint32_t back, char* line, const uint32_t line_size, uint32_t* length)
+{
+    uint32_t end = history_head;
+    uint32_t entry_length = 0;
+    uint32_t i = 0;
+
+    if (( back == 0 ) || ( back > history_entries ) || ( line_size == 0 ))
+    {
+        return KD__CLI_HISTORY_NO_SUCH_ENTRY;
+    }
+
+    for ( i = 1; i < back; i++ )
+    {
+        end -= (byte_at(end - 1) + 2);
+    }
+
+    entry_length = byte_at(end - 1);
+    if ( entry_length > (line_size - 1) )
+    {
+        entry_length = (line_size - 1);
+    }
+
+    for ( i = 0; i < entry_length; i++ )
+    {
+        line[i] = (char)byte_at(end - 1 - byte_at(end - 1) + i);
+    }
+    line[entry_length] = 0;
+    *length = entry_length;
+
+    return ROUTINE_OK;
+}
+
+
+
+uint32_t cli_history_count(void)
+{
+    return history_entries;
+}
+
+
+
+uint32_t cli_history_bytes_used(void)
+{
+    return (history_head - history_tail);
+}
+
+
+
+// --- EOF ---
@@ -0,0 +1,41 @@
+#ifndef _CLI_HISTORY_H
+#define _CLI_HISTORY_H
+
+/*
+ * ---------------------------------------------------------------------
+ *
+ *  @Project   Kionix Driver Demo
+ *
+ *  @File      cli-history.h
+ *
+ *  @Brief     Command line history held in one byte ring of
+ *   KD_APP_CLI_HISTORY_BYTES.  Each entry costs its length plus two
+ *   bytes, so many short commands or a few long ones fit in same
+ *   space.  Oldest entries are evicted to make room for newest.
+ *   Used by CLI thread only, no locking.
+ *
+ * ---------------------------------------------------------------------
+ */
+
+#include <stdint.h>                // to provide define of uint32_t
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - routine prototypes
+//----------------------------------------------------------------------
+
+void cli_history_init(void);
+
+uint32_t cli_history_add(const char* line, const uint32_t length);
+
+// Copy entry 'back' steps from newest, 1 being newest, to caller's buffer:
+uint32_t cli_history_entry(const uint32_t back, char* line, const uint32_t line_size, uint32_t* length);
+
+uint32_t cli_history_count(void);
+
+uint32_t cli_history_bytes_used(void);
+
+
+
+#endif // _CLI_HISTORY_H
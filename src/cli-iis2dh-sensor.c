@@ -20,15 +20,22 @@
 #include "module-ids.h"
 #include "return-values.h"
 #include "scoreboard.h"
+#include "sample-ring.h"
 
 #include "kionix-demo-errors.h"
+#include "kd-app-channels.h"       // to provide temperature request and reading channels
 
 // sensor specific (this CLI command deals with STMicro IIS2DH):
 #include "thread-iis2dh.h"
+#include "thread-sample-log.h"
 
 // this source file part of 'simple CLI' module in app:
 #include "thread-simple-cli.h"     // to provide prototype for printk_cli()
 
+#ifdef CONFIG_I2C_EMUL
+#include "emul-iis2dh.h"
+#endif
+
 
 
 //----------------------------------------------------------------------
@@ -37,6 +44,9 @@
 
 // extern uint32_t argument_count;
 
+// Replies to `temp` command, subscribed on first use:
+KD_CHANNEL_SUBSCRIBER_DEFINE(cli_temperature_subscriber, 2);
+
 enum iis2dh_flexible_commands
 {
     KD__IIS2DH_CMD__FIRST_ENUM_ELEMENT,
@@ -64,7 +74,6 @@ uint32_t cli__iis2dh_sensor_handler(const char* args)
 
 // for generalized command parsing:
     uint32_t match = 0;
-    char argument[SUPPORTED_ARG_LENGTH];
     uint32_t placeholder_decimal_value = 0;
     enum iis2dh_flexible_commands command_to_execute = KD__IIS2DH_CMD__FIRST_ENUM_ELEMENT;
 
@@ -82,9 +91,8 @@ uint32_t cli__iis2dh_sensor_handler(const char* args)
 // GENERALIZED COMMAND PARSING MACROS - ALLOW FOR CERTAIN ONE-LINE ARGUMENT CHECKS:
 // (Note:  these macros depend on local variables in 'generalized command parsing' section top of this routine.)
 
-#define STRNCMP_ARGUMENT(index_to_argument, pattern, up_to_byte_length) \
-rstatus = arg_n(index_to_argument, argument); \
-match += strncmp(argument, pattern, up_to_byte_length);
+#define COMPARE_ARGUMENT(index_to_argument, pattern) \
+match += arg_compare(index_to_argument, pattern);
 
 #define CHECK_IF_DECIMAL_AT_ARG_INDEX(n) \
 match += arg_is_decimal(n, &placeholder_decimal_value);
@@ -101,7 +109,7 @@ match += arg_is_decimal(n, &placeholder_decimal_value);
     else if ( argument_count == 3 )
     {
 //        printk_cli("checking for `iis2dh write <reg> <data>` command...\n\r");
-        STRNCMP_ARGUMENT(0, "write", SUPPORTED_ARG_LENGTH);
+        COMPARE_ARGUMENT(0, "write");
         CHECK_IF_DECIMAL_AT_ARG_INDEX(1);   // <-- here expect peripheral register address
         CHECK_IF_DECIMAL_AT_ARG_INDEX(2);   // <-- here expect byte value to write to peripheral register
         if ( match == 0 )
@@ -113,9 +121,9 @@ match += arg_is_decimal(n, &placeholder_decimal_value);
 // 2021-11-18 - check for input of the form "iis2dh read n from n":
     else if ( argument_count == 4 )
     {
-        STRNCMP_ARGUMENT(0, "read", SUPPORTED_ARG_LENGTH);
+        COMPARE_ARGUMENT(0, "read");
         CHECK_IF_DECIMAL_AT_ARG_INDEX(1);
-        STRNCMP_ARGUMENT(2, "from", SUPPORTED_ARG_LENGTH);
+        COMPARE_ARGUMENT(2, "from");
         CHECK_IF_DECIMAL_AT_ARG_INDEX(3);
 
         if ( match == 0 )
@@ -197,20 +205,241 @@ memset(binary_rep, 0, BINARY_REPRESENTATION_EIGHT_BITS_AS_STRING);
 
 } // end routine cli__iis2dh_sensor_handler()
 
+KD_CLI_COMMAND_DEFINE(iis2dh, "iis2dh", "IMPLEMENTATION UNDERWAY - general purpose iis2dh configuration command", &cli__iis2dh_sensor_handler);
 
 
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Request one IIS2DH temperature reading and show it.  IIS2DH
+ *           thread answers between FIFO drains, so wait up to its
+ *           longest loop period for the reply.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
 uint32_t cli__request_temperature_reading(const char* args)
 {
+#define CLI_TEMPERATURE_REPLY_TIMEOUT_MS (2500)
+
+// --- VAR BEGIN ---
+    uint32_t rstatus = ROUTINE_OK;
+    char lbuf[DEFAULT_MESSAGE_SIZE];
+    char temperature_in_binary[BINARY_REPRESENTATION_EIGHT_BITS_AS_STRING];
+    static uint32_t cli_temperature_subscribed = 0;
+    struct temperature_request* request = NULL;
+    const struct temperature_reading* reading = NULL;
+// --- VAR END ---
+
+    if ( cli_temperature_subscribed == 0 )
+    {
+        rstatus = kd_channel_subscribe(&temperature_channel, &cli_temperature_subscriber);
+        if ( rstatus != ROUTINE_OK )
+        {
+            printk_cli("\n\rno free temperature channel subscriber slots,\n\r");
+            return rstatus;
+        }
+        cli_temperature_subscribed = 1;
+    }
+
+// Readings answering other modules' requests are not ours to show:
+    while ( kd_channel_receive(&cli_temperature_subscriber, (const void**)&reading, K_NO_WAIT) == ROUTINE_OK )
+        { kd_channel_release(reading); }
+
+    request = kd_channel_claim(&temperature_request_channel, K_NO_WAIT);
+    if ( request == NULL )
+    {
+        printk_cli("\n\rtemperature request already pending,\n\r");
+        return KD__CHANNEL_POOL_EMPTY;
+    }
+    request->timestamp = k_cycle_get_32();
+    kd_channel_publish(request);
+
+    rstatus = kd_channel_receive(&cli_temperature_subscriber, (const void**)&reading, K_MSEC(CLI_TEMPERATURE_REPLY_TIMEOUT_MS));
+    if ( rstatus != ROUTINE_OK )
+    {
+        printk_cli("\n\rno temperature reading from IIS2DH thread,\n\r");
+        return rstatus;
+    }
+
+    memset(temperature_in_binary, 0, BINARY_REPRESENTATION_EIGHT_BITS_AS_STRING);
+    integer_to_binary_string((uint8_t)reading->relative_degrees_c, temperature_in_binary, BINARY_REPRESENTATION_EIGHT_BITS_AS_STRING);
+    snprintf(lbuf, DEFAULT_MESSAGE_SIZE, "\n\rtemperature reading raw %d, equal to 0b%s, relative to factory reference\n\r",
+      reading->relative_degrees_c, temperature_in_binary);
+    printk_cli(lbuf);
+
+    kd_channel_release(reading);
+    return rstatus;
+}
+
+KD_CLI_COMMAND_DEFINE(temp, "temp", "request iis2dh temperature reading", &cli__request_temperature_reading);
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Show readings gathered since this command last ran.  CLI
+ *           attaches as one more reader of the IIS2DH sample ring, and
+ *           between calls is simply lapped, never holding up the
+ *           IIS2DH thread or other readers.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+uint32_t cli__iis2dh_sample_ring_readings(const char* args)
+{
+#define CLI_SAMPLES_SHOWN_PER_COMMAND (8)
+
 // --- VAR BEGIN ---
     uint32_t rstatus = ROUTINE_OK;
     char lbuf[DEFAULT_MESSAGE_SIZE];
+    struct sample_ring* ring = thread_iis2dh__sample_ring();
+    static uint32_t cli_reader_id = 0;
+    static uint32_t cli_reader_attached = 0;
+    struct acc_sample_record records[CLI_SAMPLES_SHOWN_PER_COMMAND];
+    struct acc_reading_triplet raw[CLI_SAMPLES_SHOWN_PER_COMMAND];
+    struct acc_reading_triplet_milli_g in_milli_g[CLI_SAMPLES_SHOWN_PER_COMMAND];
+    struct acc_milli_g_scale scale;
+    uint32_t waiting = 0;
+    uint32_t count_pulled = 0;
 // --- VAR END ---
 
-    scoreboard__update_flag__temperature_reading_requested(SET_FLAG);
+    if ( cli_reader_attached == 0 )
+    {
+        rstatus = sample_ring_attach_reader(ring, &cli_reader_id);
+        if ( rstatus != ROUTINE_OK )
+        {
+            printk_cli("\n\rno free sample ring reader slots,\n\r");
+            return rstatus;
+        }
+        cli_reader_attached = 1;
+        printk_cli("\n\rCLI attached to IIS2DH sample ring, readings show from next call on,\n\r");
+        return rstatus;
+    }
+
+    waiting = sample_ring_count_available(ring, cli_reader_id);
+    snprintf(lbuf, DEFAULT_MESSAGE_SIZE, "\n\r%u readings waiting, %u missed by CLI while idle, latest few:\n\r",
+      waiting, sample_ring_reader_overflow_count(ring, cli_reader_id));
+    printk_cli(lbuf);
+
+// Skip ahead so only the newest readings are formatted.  Ring keeps
+// filling meanwhile, so check what is left on each pass:
+    while ( ( waiting = sample_ring_count_available(ring, cli_reader_id) ) > CLI_SAMPLES_SHOWN_PER_COMMAND )
+    {
+        uint32_t to_skip = ( waiting - CLI_SAMPLES_SHOWN_PER_COMMAND );
+        rstatus = sample_ring_pull(ring, cli_reader_id, records,
+          ( to_skip < CLI_SAMPLES_SHOWN_PER_COMMAND ? to_skip : CLI_SAMPLES_SHOWN_PER_COMMAND ), &count_pulled);
+    }
+
+    rstatus = sample_ring_pull(ring, cli_reader_id, records, CLI_SAMPLES_SHOWN_PER_COMMAND, &count_pulled);
+
+    thread_iis2dh__milli_g_scale(&scale);
+
+    for ( int i = 0; i < count_pulled; i++ )
+        { raw[i] = records[i].xyz; }
+    readings_to_milli_g(raw, in_milli_g, count_pulled, &scale);
+
+    for ( int i = 0; i < count_pulled; i++ )
+    {
+        snprintf(lbuf, DEFAULT_MESSAGE_SIZE, "  %10u @ %10u cycles:  0x%04X 0x%04X 0x%04X  --  %6d %6d %6d mg\n\r",
+          records[i].sequence, records[i].timestamp, records[i].xyz.x, records[i].xyz.y, records[i].xyz.z,
+          in_milli_g[i].x, in_milli_g[i].y, in_milli_g[i].z);
+        printk_cli(lbuf);
+    }
 
     return rstatus;
 }
 
+KD_CLI_COMMAND_DEFINE(samples, "samples", "show latest iis2dh readings from sample ring", &cli__iis2dh_sample_ring_readings);
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   `binlog on` and `binlog off` start and stop binary sample
+ *           records on console UART, no argument shows log counters.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+uint32_t cli__iis2dh_binary_sample_log(const char* args)
+{
+// --- VAR BEGIN ---
+    uint32_t rstatus = ROUTINE_OK;
+    char lbuf[DEFAULT_MESSAGE_SIZE];
+    uint32_t argument_count = argument_count_from_cli_module();
+// --- VAR END ---
+
+    if ( argument_count == 1 )
+    {
+        if ( arg_compare(0, "on") == 0 )
+        {
+            sample_log__set_output(SAMPLE_LOG_OUTPUT_CONSOLE);
+            sample_log__set_enabled(1);
+        }
+        else if ( arg_compare(0, "off") == 0 )
+            { sample_log__set_enabled(0); }
+        else
+            { printk_cli("\n\rusage:  binlog [on|off]\n\r"); }
+    }
+
+    snprintf(lbuf, DEFAULT_MESSAGE_SIZE, "\n\rbinary sample log %s, %u records holding %u readings sent,\n\r",
+      ( sample_log__is_enabled() ? "on" : "off" ), sample_log__records_sent(), sample_log__triplets_sent());
+    printk_cli(lbuf);
+
+    return rstatus;
+}
+
+KD_CLI_COMMAND_DEFINE(binlog, "binlog", "binary iis2dh readings on console UART, on or off", &cli__iis2dh_binary_sample_log);
+
+
+#ifdef CONFIG_I2C_EMUL
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   `emul` shows emulated IIS2DH counters, `emul reset` clears
+ *           them, `emul temp N` sets reported temperature.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+uint32_t cli__iis2dh_emulator(const char* args)
+{
+// --- VAR BEGIN ---
+    uint32_t rstatus = ROUTINE_OK;
+    char lbuf[DEFAULT_MESSAGE_SIZE];
+    char argument[SUPPORTED_ARG_LENGTH];
+    uint32_t argument_count = argument_count_from_cli_module();
+    struct emul_iis2dh_stats stats;
+// --- VAR END ---
+
+    if ( argument_count >= 1 )
+    {
+        if ( arg_compare(0, "reset") == 0 )
+        {
+            emul_iis2dh_reset_stats();
+        }
+        else if (( arg_compare(0, "temp") == 0 ) && ( argument_count == 2 ))
+        {
+            rstatus = arg_n(1, argument);
+            emul_iis2dh_set_temperature((int8_t)atoi(argument));
+        }
+        else
+        {
+            printk_cli("\n\rusage:  emul [reset | temp N]\n\r");
+            return rstatus;
+        }
+    }
+
+    emul_iis2dh_stats(&stats);
+    snprintf(lbuf, DEFAULT_MESSAGE_SIZE, "\n\remulated iis2dh:  %u readings generated, %u read, %u lost,\n\r",
+      stats.readings_generated, stats.readings_read, stats.readings_lost);
+    printk_cli(lbuf);
+    snprintf(lbuf, DEFAULT_MESSAGE_SIZE, "%u FIFO overruns, %u bus transfers, %u INT1 assertions\n\r",
+      stats.fifo_overruns, stats.bus_transfers, stats.int1_assertions);
+    printk_cli(lbuf);
+
+    return rstatus;
+}
+
+KD_CLI_COMMAND_DEFINE(emul, "emul", "emulated iis2dh counters, `emul reset`, `emul temp N`", &cli__iis2dh_emulator);
+#endif // CONFIG_I2C_EMUL
+
 
 
 //----------------------------------------------------------------------
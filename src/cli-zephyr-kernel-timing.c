@@ -49,6 +49,9 @@ uint32_t cli__show_zephyr_kernel_runtime_cycle_count(const char* args)
     return ROUTINE_OK;
 };
 
+KD_CLI_COMMAND_DEFINE(cyc, "cyc", "show Zephyr kernel run time cycles count", &cli__show_zephyr_kernel_runtime_cycle_count);
+KD_CLI_COMMAND_DEFINE(cycles, "cycles", "alias to `cyc`", &cli__show_zephyr_kernel_runtime_cycle_count);
+
 
 
 // --- EOF ---
@@ -19,6 +19,7 @@
 #include <stdint.h>                // to provide define of uint32_t
 #include <string.h>                // to provide strlen()
 #include <stdio.h>                 // to provide snprintf() and related
+#include <stdlib.h>                // to provide atoi()
 
 // Zephyr RTOS project includes:
 #include <sys/printk.h>
@@ -41,9 +42,11 @@ extern int arch_irq_connect_dynamic(unsigned int irq, unsigned int priority,
 
 // Kionix Driver Demo headers:
 #include "common.h"
+#include "kd-app-config.h"
 #include "return-values.h"
 #include "diagnostic.h"
 #include "thread-simple-cli.h"
+#include "thread-telemetry.h"
 
 
 //----------------------------------------------------------------------
@@ -88,17 +91,86 @@ void kd_thread_print_cb(struct thread_analyzer_info *info)
 
 
 
+static void print_telemetry_summary(const uint32_t window)
+{
+    char lbuf[SIZE_OF_MESSAGE_MEDIUM] = { 0 };
+    struct thread_telemetry_summary summary;
+    uint32_t samples = thread_telemetry_sample_count();
+
+    if (( window > 0 ) && ( window < samples ))
+        { samples = window; }
+
+    snprintf(lbuf, SIZE_OF_MESSAGE_MEDIUM, "   last %u samples, cpu %% min/avg/max, switches per sample min/avg/max:\n\r\n\r",
+      samples);
+    printk_cli(lbuf);
+
+    for ( uint32_t slot = 0; slot < KD_APP_TELEMETRY_MAX_THREADS; slot++ )
+    {
+        if ( thread_telemetry_summary(slot, window, &summary) != ROUTINE_OK )
+            { continue; }
+
+        snprintf(lbuf, SIZE_OF_MESSAGE_MEDIUM,
+          "   '%s' %*sstack %u of %u bytes, %u%%   cpu %u.%u/%u.%u/%u.%u   switches %u/%u/%u\n\r",
+          summary.name,
+          (WIDTH_THREAD_NAME - strlen(summary.name)),
+          " ",
+          summary.stack_used_max, summary.stack_size,
+          ( summary.stack_size ? ((100 * summary.stack_used_max) / summary.stack_size) : 0 ),
+          (summary.cpu_permille_min / 10), (summary.cpu_permille_min % 10),
+          (summary.cpu_permille_avg / 10), (summary.cpu_permille_avg % 10),
+          (summary.cpu_permille_max / 10), (summary.cpu_permille_max % 10),
+          summary.switches_min, summary.switches_avg, summary.switches_max
+        );
+        printk_cli(lbuf);
+    }
+}
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   `st` summarizes all telemetry history, `st N` latest N
+ *           samples, `st now` runs Zephyr thread analyzer once.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
 uint32_t cli__zephyr_2p6p0_stack_statistics(const char* args)
 {
+    char argument[SUPPORTED_ARG_LENGTH];
+    uint32_t window = 0;
+
     if ( strlen(args) == 0 ) { } // trivial test to start, to avoid compiler warning - TMH
 
     printk_cli(TWO_NEWLINES);
-//    thread_analyzer_print();  // <-- this routine prints to Zephyr app's preferred console UART
-    thread_analyzer_run(kd_thread_print_cb);
+
+    if (( argument_count_from_cli_module() == 1 ) && ( arg_compare(0, "now") == 0 ))
+    {
+//        thread_analyzer_print();  // <-- this routine prints to Zephyr app's preferred console UART
+        thread_analyzer_run(kd_thread_print_cb);
+        return ROUTINE_OK;
+    }
+
+    if ( argument_count_from_cli_module() == 1 )
+    {
+        arg_n(0, argument);
+        window = (uint32_t)atoi(argument);
+    }
+
+    if ( thread_telemetry_sample_count() == 0 )
+    {
+        printk_cli("   no telemetry samples yet, showing thread analyzer:\n\r\n\r");
+        thread_analyzer_run(kd_thread_print_cb);
+        return ROUTINE_OK;
+    }
+
+    print_telemetry_summary(window);
 
     return ROUTINE_OK;
 }
 
+KD_CLI_COMMAND_DEFINE(st, "st", "thread cpu and stack telemetry, `st N` latest N samples, `st now` analyzer", &cli__zephyr_2p6p0_stack_statistics);
+KD_CLI_COMMAND_DEFINE(stacks, "stacks", "alias to `st`", &cli__zephyr_2p6p0_stack_statistics);
+
 
 
 // --- EOF ---
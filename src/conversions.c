@@ -25,6 +25,8 @@
 // App specific includes . . .
 #include "conversions.h"
 #include "diagnostic.h"
+#include "iis2dh-registers.h"      // to provide ACC_FULL_SCALE_MASK, LOW_POWER_ENABLE and related
+#include "return-values.h"
 
 // this source file part of 'simple CLI' module in app:
 #include "thread-simple-cli.h"     // to provide prototype for printk_cli()
@@ -72,6 +74,90 @@ printk(" - PASSED VALUE %u -", reading_in_twos_comp);
 
 
 
+//----------------------------------------------------------------------
+// - SECTION - integer conversion of readings blocks
+//----------------------------------------------------------------------
+
+// IIS2DH sensitivity in milli-g per digit, iis2dh.pdf table 4, indexed
+// by resolution and then by CTRL_REG4 FS1:FS0:
+static const int32_t iis2dh_milli_g_per_digit[ACC_RESOLUTION_COUNT][4] =
+{
+//     2g   4g   8g  16g
+    {  16,  32,  64, 192 },        // 8-bit, low power mode
+    {   4,   8,  16,  48 },        // 10-bit, normal mode
+    {   1,   2,   4,  12 }         // 12-bit, high resolution mode
+};
+
+// Readings left justified in 16 bits, shift right to drop unused bits:
+static const uint32_t right_shift_for_resolution[ACC_RESOLUTION_COUNT] = { 8, 6, 4 };
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Per iis2dh.pdf table 9, LPEN set gives 8-bit readings, HR
+ *           set gives 12-bit readings, neither gives 10-bit readings.
+ *           Both set is not allowed, treat as low power.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+enum acc_resolutions_e iis2dh_resolution_from_control_registers(const uint8_t ctrl_reg1, const uint8_t ctrl_reg4)
+{
+    if ( ctrl_reg1 & LOW_POWER_ENABLE )
+        { return ACC_RESOLUTION_8_BIT; }
+
+    if ( ctrl_reg4 & HIGH_RESOLUTION_ENABLE )
+        { return ACC_RESOLUTION_12_BIT; }
+
+    return ACC_RESOLUTION_10_BIT;
+}
+
+
+
+uint32_t iis2dh_milli_g_scale(const uint8_t full_scale_bits,
+                              const enum acc_resolutions_e resolution,
+                              struct acc_milli_g_scale* scale)
+{
+    uint32_t range_index = ( ( full_scale_bits & ACC_FULL_SCALE_MASK ) >> 4 );
+
+    if ( resolution >= ACC_RESOLUTION_COUNT )
+        { return KD__CONVERSION_UNSUPPORTED_RESOLUTION; }
+
+    scale->right_shift = right_shift_for_resolution[resolution];
+    scale->milli_g_per_digit = iis2dh_milli_g_per_digit[resolution][range_index];
+
+    return ROUTINE_OK;
+}
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Convert a block of raw x,y,z readings to milli-g.  Signed
+ *           right shift sign extends each reading, so no per reading
+ *           branches and no floating point.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+void readings_to_milli_g(const struct acc_reading_triplet* raw,
+                         struct acc_reading_triplet_milli_g* converted,
+                         const uint32_t triplet_count,
+                         const struct acc_milli_g_scale* scale)
+{
+    const uint32_t shift = scale->right_shift;
+    const int32_t per_digit = scale->milli_g_per_digit;
+    uint32_t i = 0;
+
+    for ( i = 0; i < triplet_count; i++ )
+    {
+        converted[i].x = (int16_t)( ( (int32_t)(int16_t)raw[i].x >> shift ) * per_digit );
+        converted[i].y = (int16_t)( ( (int32_t)(int16_t)raw[i].y >> shift ) * per_digit );
+        converted[i].z = (int16_t)( ( (int32_t)(int16_t)raw[i].z >> shift ) * per_digit );
+    }
+}
+
+
+
 /*
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
  *
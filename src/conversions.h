@@ -1,6 +1,10 @@
 #ifndef _CONVERSIONS_H
 #define _CONVERSIONS_H
 
+#include <stdint.h>                // to provide define of int32_t
+
+#include "common.h"                // to provide struct acc_reading_triplet
+
 
 #define APPR_ACCELERATION_OF_GRAVITY (9.80665)
 
@@ -10,9 +14,48 @@
 #define BINARY_REPRESENTATION_THIRTY_TWO_BITS_AS_STRING (32 + 1)
 
 
+// Accelerometer readings resolution, IIS2DH low power, normal and high
+// resolution modes give 8-, 10- and 12-bit readings respectively:
+enum acc_resolutions_e
+{
+    ACC_RESOLUTION_8_BIT,
+    ACC_RESOLUTION_10_BIT,
+    ACC_RESOLUTION_12_BIT,
+    ACC_RESOLUTION_COUNT
+};
+
+// Scale factors for one full scale range and resolution, found once per
+// block of readings so that per reading conversion needs no branches:
+struct acc_milli_g_scale
+{
+    uint32_t right_shift;          // drops unused low bits of left justified 16-bit reading
+    int32_t milli_g_per_digit;     // sensitivity after shift, per sensor datasheet
+};
+
+struct acc_reading_triplet_milli_g
+{
+    int16_t x;
+    int16_t y;
+    int16_t z;
+};
+
+
 
 float reading_in_g(const uint32_t reading_in_twos_comp, const uint32_t full_scale, const uint32_t resolution_in_bits);
 
+// Resolution IIS2DH gives with these CTRL_REG1 LPEN and CTRL_REG4 HR settings:
+enum acc_resolutions_e iis2dh_resolution_from_control_registers(const uint8_t ctrl_reg1, const uint8_t ctrl_reg4);
+
+// Full scale bits as they sit in IIS2DH_CTRL_REG4, e.g. ACC_FULL_SCALE_4G:
+uint32_t iis2dh_milli_g_scale(const uint8_t full_scale_bits,
+                              const enum acc_resolutions_e resolution,
+                              struct acc_milli_g_scale* scale);
+
+void readings_to_milli_g(const struct acc_reading_triplet* raw,
+                         struct acc_reading_triplet_milli_g* converted,
+                         const uint32_t triplet_count,
+                         const struct acc_milli_g_scale* scale);
+
 void integer_to_binary_string(const uint32_t integer, char* string, const uint32_t str_length);
 
 
@@ -23,6 +23,8 @@
 #define NN_DEV__ENABLE_THREAD_LIS2DH_SENSOR               (0)
 #define NN_DEV__ENABLE_THREAD_SIMPLE_CLI                  (1)
 #define NN_DEV__ENABLE_THREAD_LED                         (1)
+#define NN_DEV__ENABLE_THREAD_SAMPLE_LOG                  (1)
+#define NN_DEV__ENABLE_THREAD_TELEMETRY                   (1)
 
 #define NN_DEV__ENABLE_IIS2DH_TEMPERATURE_READGINGS       (0)
 
@@ -46,6 +48,45 @@
 #define DEFINE_FOR_USE__ACCELERATOR_START_ACQUISITION_NO_FIFO (0)
 #define DEFINE_FOR_USE__READ_OF_IIS2DH_ACC_STATUS_REGISTER    (1)
 
+// When enabled and IIS2DH node has 'drdy-gpios' in devicetree, IIS2DH thread
+// sleeps until FIFO watermark interrupt on INT1 rather than polling:
+#define KD_DEV__IIS2DH_FIFO_WATERMARK_INTERRUPT_ENABLED       (1)
+
+// When enabled IIS2DH thread configures sensor once and polls FIFO at a
+// period set by ODR, rather than stopping and restarting acquisition each
+// cycle.  Watermark interrupt mode always streams:
+#define KD_DEV__IIS2DH_CONTINUOUS_STREAMING                   (1)
+
+// When enabled IIS2DH thread starts each FIFO drain as an I2C transfer
+// with completion callback, and unpacks the previous drained block while
+// that transfer is in flight.  Needs CONFIG_I2C_CALLBACK, falls back to
+// blocking transfer when bus driver lacks callback support:
+#define KD_DEV__IIS2DH_ASYNC_FIFO_DRAIN                       (1)
+
+// Test builds only, see tests/iis2dh-emul:  i2c-emul has no callback
+// support, so route asynchronous FIFO drains through emulator's deferred
+// transfer instead, and completion callback runs as it would on hardware:
+#ifndef KD_TEST__EMUL_ASYNC_FIFO_DRAIN
+#define KD_TEST__EMUL_ASYNC_FIFO_DRAIN                        (0)
+#endif
+
+// Per reading hex and float printk from IIS2DH thread.  Slow, blocks
+// sensor thread on console, use binary sample log instead:
+#define KD_DEV__IIS2DH_PRINTK_EACH_READING                    (0)
+
+// When enabled KD_TRACE_BEGIN() and KD_TRACE_END() stamp cycle counts of
+// IIS2DH FIFO service spans for CLI `trace`.  Disabled they compile to
+// nothing:
+#define KD_DEV__TRACE_POINTS_ENABLED                          (1)
+
+
+// When enabled CLI thread receives through UART RX interrupt into a ring
+// buffer and sleeps until input arrives, rather than polling UART every
+// SLEEP_TIME__SIMPLE_CLI__MS, and printk_cli() queues output for UART TX
+// interrupt to send.  Needs CONFIG_UART_INTERRUPT_DRIVEN, falls back to
+// polling when CLI UART driver lacks interrupt support:
+#define KD_DEV__CLI_UART_INTERRUPT_DRIVEN                     (1)
+
 
 
 // Scoreboard related:
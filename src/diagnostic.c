@@ -5,56 +5,227 @@
  */
 
 
+#include <stdarg.h>                // to provide va_list and related
+#include <stdio.h>                 // to provide snprintf(), vsnprintf()
+
+#include <zephyr.h>
+#include <sys/atomic.h>            // to provide atomic_t and related
 #include <sys/printk.h>
 
 #include "diagnostic.h"
 
+#include "kd-app-config.h"
+#include "return-values.h"
+#include "scoreboard.h"            // to provide get_diag_messaging_level()
 #include "thread-simple-cli.h"
 
 
 
+#define DIAG_MS_PER_TOKEN ( 1000 / KD_APP_DIAG_LINES_PER_SECOND )
+
+BUILD_ASSERT(KD_APP_DIAG_LINES_PER_SECOND > 0, "diagnostic line rate must be at least one per second");
+
+// Call site buckets are small and updated from any thread, one lock serves all:
+static struct k_spinlock diag_rate_limit_lock;
+
+static atomic_t diag_suppressed_total = ATOMIC_INIT(0);
+
+
+
+static uint32_t diag_runtime_level(void)
+{
+    enum nn_diagnostic_levels level = DIAG_NORMAL;
+
+    get_diag_messaging_level(&level);
+    return (uint32_t)level;
+}
+
+
+
+// Destination bits of 'option' pick UART, CLI UART when none given:
+static void diag_send(const char* message, const uint32_t option)
+{
+    if ( option & KD_DIAG_OPTION_TO_DEFAULT_UART )
+    {
+        printk("%s", message);
+    }
+
+    if (( option & KD_DIAG_OPTION_TO_CLI_UART ) || !( option & KD_DIAG_OPTION_TO_DEFAULT_UART ))
+    {
+        printk_cli(message);
+    }
+}
+
+
+
 /*
  *----------------------------------------------------------------------
  * @brief     Wrapper function about Zephyr printk().
  * @purpose   To provide easy way to disable messages on chosen UART
  *            peripheral for Zephyr console, shell-uart, uart-mcumgr
- *            and similar.           
+ *            and similar.  Level bits of 'option' are checked against
+ *            runtime diagnostic level, a message with no level bits
+ *            is always sent.
  *----------------------------------------------------------------------
  */
 
 void dmsg(const char* message, int option)
 {
+    if ((( option & KD_DIAG_LEVEL_MASK ) != 0 ) && (( option & diag_runtime_level() ) == 0 ))
+    {
+        return;
+    }
+
+    diag_send(message, (uint32_t)option);
+}
+
+
+
+/*
+ *----------------------------------------------------------------------
+ * @brief     Token bucket check, TRUE when call site may send a line.
+ *            Bucket counts tokens spent rather than tokens held, so a
+ *            zero initialized call site starts with a full bucket.
+ *----------------------------------------------------------------------
+ */
+
+static uint32_t diag_rate_limit_take(struct diag_rate_limit* call_site, uint32_t* suppressed_before)
+{
+    uint32_t now = k_uptime_get_32();
+    uint32_t refills = 0;
+    uint32_t allowed = 0;
+    k_spinlock_key_t key = k_spin_lock(&diag_rate_limit_lock);
 
-#if 0
-    if ( option | KD_DIAG_OPTION_TO_DEFAULT_UART )
+    refills = ( now - call_site->last_refill_ms ) / DIAG_MS_PER_TOKEN;
+    if ( refills > 0 )
     {
-        printk("%s", message);
+        call_site->tokens_spent = ( refills >= call_site->tokens_spent ) ? 0 : ( call_site->tokens_spent - refills );
+        call_site->last_refill_ms += ( refills * DIAG_MS_PER_TOKEN );
     }
-#endif
 
-//    if ( option | KD_DIAG_OPTION_TO_CLI_UART )
-    if ( 1 )
+    if ( call_site->tokens_spent < KD_APP_DIAG_BURST )
     {
-       printk_cli(message);
+        call_site->tokens_spent++;
+        *suppressed_before = call_site->suppressed;
+        call_site->suppressed = 0;
+        allowed = 1;
     }
+    else
+    {
+        call_site->suppressed++;
+    }
+
+    k_spin_unlock(&diag_rate_limit_lock, key);
 
-#if 0
-    switch (option)
+    return allowed;
+}
+
+
+
+void dmsg_rate_limited(struct diag_rate_limit* call_site, const char* module_id, const uint32_t level,
+                       const char* format, ...)
+{
+    char lbuf[DEFAULT_MESSAGE_SIZE];
+    uint32_t suppressed_before = 0;
+    int length = 0;
+    va_list args;
+
+    if (( level & diag_runtime_level() ) == 0 )
+    {
+        return;
+    }
+
+    if ( !diag_rate_limit_take(call_site, &suppressed_before) )
+    {
+        atomic_inc(&diag_suppressed_total);
+        return;
+    }
+
+    length = snprintf(lbuf, sizeof(lbuf), "- %s - %s", module_id,
+      ( level & KD_DIAG_ERRORS ) ? "ERROR - " : ( level & KD_DIAG_WARNINGS ) ? "WARNING - " : "" );
+
+    va_start(args, format);
+    length += vsnprintf(&lbuf[length], ( sizeof(lbuf) - length ), format, args);
+    va_end(args);
+
+    if (( suppressed_before > 0 ) && ( length < sizeof(lbuf) ))
+    {
+        length += snprintf(&lbuf[length], ( sizeof(lbuf) - length ), " (%u more like this dropped)", suppressed_before);
+    }
+
+// Keep room for line ending when message was truncated:
+    if ( length > ( sizeof(lbuf) - 3 ) )
     {
-       case ( option | KD_DIAG_OPTION_TO_DEFAULT_UART ):
-           printk("%s", message);
-           break;
+        length = ( sizeof(lbuf) - 3 );
+    }
+    lbuf[length++] = '\n';
+    lbuf[length++] = '\r';
+    lbuf[length] = '\0';
+
+    diag_send(lbuf, PROJECT_DIAG_LEVEL);
+}
 
-       case ( option | KD_DIAG_OPTION_TO_CLI_UART ):
-           printk_cli(message);
-           break;
 
-       default:
+
+uint32_t dmsg_suppressed_count(void)
+{
+    return (uint32_t)atomic_get(&diag_suppressed_total);
+}
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - command handlers
+//----------------------------------------------------------------------
+
+/*
+ *----------------------------------------------------------------------
+ * @brief     `diag off|minimal|normal|verbose` sets runtime diagnostic
+ *            level, only among levels compiled in per module.  No
+ *            argument shows level and rate limited line count.
+ *----------------------------------------------------------------------
+ */
+
+uint32_t cli__diag(const char* args)
+{
+    static const struct { const char* name; uint32_t level; } levels[] =
+    {
+        { "off",     DIAG_OFF },
+        { "minimal", DIAG_MINIMAL },
+        { "normal",  DIAG_NORMAL },
+        { "verbose", DIAG_VERBOSE }
+    };
+    char lbuf[SIZE_OF_MESSAGE_MEDIUM];
+    uint32_t level = diag_runtime_level();
+    const char* level_name = "custom";
+
+    if ( argument_count_from_cli_module() == 1 )
+    {
+        for ( uint32_t i = 0; i < ARRAY_SIZE(levels); i++ )
+        {
+            if ( arg_compare(0, levels[i].name) == 0 )
+            {
+                set_diag_messaging_level((enum nn_diagnostic_levels)levels[i].level);
+                level = levels[i].level;
+            }
+        }
     }
-#endif
 
+    for ( uint32_t i = 0; i < ARRAY_SIZE(levels); i++ )
+    {
+        if ( levels[i].level == level )
+            { level_name = levels[i].name; }
+    }
+
+    snprintf(lbuf, sizeof(lbuf), "\n\rdiagnostics %s, %u lines dropped by rate limits,\n\r",
+      level_name, dmsg_suppressed_count());
+    printk_cli(lbuf);
+
+    return ROUTINE_OK;
 }
 
+KD_CLI_COMMAND_DEFINE(diag, "diag", "diagnostic level off, minimal, normal or verbose", &cli__diag);
+
 
 
 
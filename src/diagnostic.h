@@ -7,6 +7,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <stdint.h>                // to provide define of uint32_t
+
 
 
 // NOTE:  developers make sure last entry does not exceed integer value of 31 - TMH
@@ -29,6 +31,8 @@ enum nn_diagnostic_levels
 #define DIAG_NORMAL  ( KD_DIAG_ERRORS | KD_DIAG_WARNINGS )
 #define DIAG_VERBOSE ( KD_DIAG_ERRORS | KD_DIAG_WARNINGS | KD_DIAG_INFO )
 
+#define KD_DIAG_LEVEL_MASK ( ( 1 << _NN_DIAG_LEVEL__LAST_ENTRY ) - 1 )
+
 
 // NOTE:  developers make sure last entry does not exceed integer value of 31 - TMH
 enum nn_diagnostic_message_options
@@ -62,12 +66,60 @@ enum nn_diagnostic_message_options
 
 
 
+//----------------------------------------------------------------------
+// - SECTION - compile time filtered, rate limited messages
+//----------------------------------------------------------------------
+
+/*
+ *  DMSG(module, level, format, ...) sends one formatted line, prefixed
+ *  with module's ID from module-ids.h, when 'level' is among levels
+ *  MODULE_DIAG_LEVEL__<module> enables.  That test is between
+ *  constants, so calls of disabled levels compile to nothing, format
+ *  strings included.  For example:
+ *
+ *    DMSG(THREAD_IIS2DH, KD_DIAG_WARNINGS, "FIFO overrun at reading %u", index);
+ *
+ *  Each call site gets its own token bucket, KD_APP_DIAG_BURST lines
+ *  deep refilling at KD_APP_DIAG_LINES_PER_SECOND, so a message in a
+ *  hot path cannot flood a UART.  Lines dropped are counted and noted
+ *  on call site's next line sent.  Runtime level, `diag` command,
+ *  further filters lines compiled in.
+ */
+
+struct diag_rate_limit
+{
+    uint32_t tokens_spent;
+    uint32_t last_refill_ms;
+    uint32_t suppressed;           // lines dropped since last line sent
+};
+
+#define DMSG(module, level, ...) \
+do { \
+    if ( ( (level) & MODULE_DIAG_LEVEL__##module ) != 0 ) \
+    { \
+        static struct diag_rate_limit diag_call_site; \
+        dmsg_rate_limited(&diag_call_site, MODULE_ID__##module, (level), __VA_ARGS__); \
+    } \
+} while (0)
+
+
+
 //----------------------------------------------------------------------
 // - SECTION - Function prototypes
 //----------------------------------------------------------------------
 
 void dmsg(const char* message, int option);
 
+void dmsg_rate_limited(struct diag_rate_limit* call_site, const char* module_id, const uint32_t level,
+                       const char* format, ...) __attribute__((format(printf, 4, 5)));
+
+uint32_t dmsg_suppressed_count(void);
+
+
+
+// Module IDs and per module levels DMSG() refers to:
+#include "module-ids.h"
+
 
 
 #endif // _DIAGNOSTIC_H
@@ -0,0 +1,653 @@
+/*
+ * ---------------------------------------------------------------------
+ *
+ *  @Project   Kionix Driver Demo
+ *
+ *  @File      emul-iis2dh.c
+ *
+ *  @Brief     IIS2DH behavioral model on Zephyr emulated I2C bus.  See
+ *   header for overview.  Model advances in whole readings each time
+ *   it is touched, by bus transfer or by INT1 poll timer, from uptime
+ *   elapsed and ODR in CTRL_REG1.
+ *
+ *  @Reference iis2dh.pdf DocID027668 Rev 2, section 6.1 I2C auto
+ *   increment, section 7 FIFO modes, section 8 register descriptions.
+ *
+ * ---------------------------------------------------------------------
+ */
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - pound includes
+//----------------------------------------------------------------------
+
+#include <stdint.h>                // to provide define of uint32_t
+#include <string.h>                // to provide memset()
+
+#include <zephyr.h>
+#include <device.h>
+#include <devicetree.h>
+#include <drivers/emul.h>
+#include <drivers/i2c.h>
+#include <drivers/i2c_emul.h>
+#include <drivers/gpio.h>
+#include <drivers/gpio/gpio_emul.h>
+
+#include "return-values.h"
+#include "iis2dh-registers.h"
+#include "emul-iis2dh.h"
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - defines
+//----------------------------------------------------------------------
+
+#define DT_DRV_COMPAT st_iis2dh
+
+#define EMUL_IIS2DH_REGISTER_COUNT   (0x40)
+#define EMUL_IIS2DH_FIFO_DEPTH       (32)
+#define EMUL_IIS2DH_AUTO_INCREMENT   (0x80)
+
+// Register addresses, per iis2dh.pdf table 16:
+#define REG_STATUS_REG_AUX   (0x07)
+#define REG_WHO_AM_I         (0x0F)
+#define REG_CTRL_REG1        (0x20)
+#define REG_CTRL_REG3        (0x22)
+#define REG_CTRL_REG5        (0x24)
+#define REG_STATUS_REG       (0x27)
+#define REG_OUT_X_L          (0x28)
+#define REG_OUT_Z_H          (0x2D)
+#define REG_FIFO_CTRL_REG    (0x2E)
+#define REG_FIFO_SRC_REG     (0x2F)
+
+#define WHO_AM_I_VALUE       (0x33)
+#define CTRL_REG1_RESET      (0x07)
+#define CTRL_REG5_BOOT       ( 1 << 7 )
+#define FIFO_MODE_MASK       ( 3 << 6 )
+#define TEMPERATURE_DATA_AVAILABLE ( 1 << 2 )
+
+// Z axis rests at 1 g, 1000 mg at 1 mg per digit in 12-bit +/-2 g mode,
+// left justified in 16 bits:
+#define MODEL_Z_AXIS_AT_ONE_G ( 1000 << 4 )
+
+// Longest span of readings worth generating, older ones would be overwritten anyway:
+#define MODEL_MAX_CATCH_UP_READINGS ( 2 * EMUL_IIS2DH_FIFO_DEPTH )
+
+// INT1 pin model re-evaluated at this period when drdy-gpios present:
+#define MODEL_INT1_POLL_PERIOD_MS (2)
+
+// Bus clock and bits per byte, ACK included, for deferred transfer timing:
+#define MODEL_I2C_BUS_HZ (400000)
+#define MODEL_I2C_BITS_PER_BYTE (9)
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - file scoped
+//----------------------------------------------------------------------
+
+struct emul_iis2dh_reading
+{
+    int16_t x;
+    int16_t y;
+    int16_t z;
+};
+
+struct emul_iis2dh_cfg
+{
+    uint16_t addr;
+    struct gpio_dt_spec int1;
+};
+
+struct emul_iis2dh_data
+{
+    const struct emul_iis2dh_cfg* cfg;
+    struct k_spinlock lock;
+    struct k_timer int1_timer;
+
+    uint8_t regs[EMUL_IIS2DH_REGISTER_COUNT];
+    uint8_t register_pointer;
+
+    struct emul_iis2dh_reading fifo[EMUL_IIS2DH_FIFO_DEPTH];
+    uint32_t fifo_oldest;
+    uint32_t fifo_level;
+    uint32_t flag_fifo_overrun;
+    struct emul_iis2dh_reading latest;
+
+    uint32_t next_x;
+    int64_t last_update_ms;
+    uint32_t milli_readings_accrued;   // fraction of one reading carried between updates, in 1/1000 readings
+    int8_t temperature;
+    uint32_t int1_level;
+
+    struct emul_iis2dh_stats stats;
+};
+
+// Single sensor modelled, found here by public API routines:
+static struct emul_iis2dh_data* emul_iis2dh_instance = NULL;
+
+#ifdef CONFIG_I2C_CALLBACK
+// Transfer deferred by emul_iis2dh_transfer_cb(), one in flight at a time:
+struct emul_deferred_transfer
+{
+    const struct device* bus;
+    struct i2c_msg* msgs;
+    uint8_t num_msgs;
+    uint16_t addr;
+    i2c_callback_t callback;
+    void* userdata;
+    atomic_t in_flight;
+    uint32_t stall_ms;
+};
+
+static struct emul_deferred_transfer deferred_transfer;
+
+static void emul_iis2dh_run_deferred_transfer(struct k_work* work);
+
+K_WORK_DELAYABLE_DEFINE(deferred_transfer_work, emul_iis2dh_run_deferred_transfer);
+#endif
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - routines model
+//----------------------------------------------------------------------
+
+static void model_reset_registers(struct emul_iis2dh_data* data)
+{
+    memset(data->regs, 0, sizeof(data->regs));
+    data->regs[REG_WHO_AM_I] = WHO_AM_I_VALUE;
+    data->regs[REG_CTRL_REG1] = CTRL_REG1_RESET;
+    data->fifo_oldest = 0;
+    data->fifo_level = 0;
+    data->flag_fifo_overrun = 0;
+}
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Readings per second from ODR3:0 of CTRL_REG1.  Top index
+ *           rate depends on LPEN, iis2dh.pdf table 25.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+static uint32_t model_odr_in_hz(const uint8_t ctrl_reg1)
+{
+    static const uint32_t odr_in_hz[] = { 0, 1, 10, 25, 50, 100, 200, 400, 1620, 1344 };
+    uint32_t odr_index = ( ctrl_reg1 >> 4 );
+
+    if ( odr_index > HIGHEST_DATA_RATE_INDEX )
+        { return 0; }
+
+    if ( ( odr_index == HIGHEST_DATA_RATE_INDEX ) && ( ctrl_reg1 & LOW_POWER_ENABLE ) )
+        { return 5376; }
+
+    return odr_in_hz[odr_index];
+}
+
+
+
+static uint32_t model_fifo_collecting(const struct emul_iis2dh_data* data)
+{
+    return ( ( data->regs[REG_CTRL_REG5] & FIFO_ENABLE ) && ( ( data->regs[REG_FIFO_CTRL_REG] & FIFO_MODE_MASK ) != FIFO_MODE_BYPASS ) );
+}
+
+
+
+static void model_store_reading(struct emul_iis2dh_data* data, const struct emul_iis2dh_reading* reading)
+{
+    data->latest = *reading;
+    data->stats.readings_generated++;
+
+    if ( !model_fifo_collecting(data) )
+        { return; }
+
+    if ( data->fifo_level == EMUL_IIS2DH_FIFO_DEPTH )
+    {
+        if ( data->flag_fifo_overrun == 0 )
+            { data->stats.fifo_overruns++; }
+        data->flag_fifo_overrun = 1;
+        data->stats.readings_lost++;
+
+// FIFO mode stops collecting when full, stream modes discard oldest reading:
+        if ( ( data->regs[REG_FIFO_CTRL_REG] & FIFO_MODE_MASK ) == FIFO_MODE_FIFO )
+            { return; }
+
+        data->fifo_oldest = ( ( data->fifo_oldest + 1 ) % EMUL_IIS2DH_FIFO_DEPTH );
+        data->fifo_level--;
+    }
+
+    data->fifo[( ( data->fifo_oldest + data->fifo_level ) % EMUL_IIS2DH_FIFO_DEPTH )] = *reading;
+    data->fifo_level++;
+}
+
+
+
+static void model_update(struct emul_iis2dh_data* data)
+{
+    struct emul_iis2dh_reading reading;
+    int64_t now_ms = k_uptime_get();
+    uint32_t elapsed_ms = (uint32_t)( now_ms - data->last_update_ms );
+    uint32_t odr_in_hz = model_odr_in_hz(data->regs[REG_CTRL_REG1]);
+    uint32_t readings_due = 0;
+
+    data->last_update_ms = now_ms;
+
+    if ( odr_in_hz == 0 )
+    {
+        data->milli_readings_accrued = 0;
+        return;
+    }
+
+    data->milli_readings_accrued += ( elapsed_ms * odr_in_hz );
+    readings_due = ( data->milli_readings_accrued / 1000 );
+    data->milli_readings_accrued %= 1000;
+
+// Readings older than twice FIFO depth would only be overwritten, count them as lost:
+    if ( readings_due > MODEL_MAX_CATCH_UP_READINGS )
+    {
+        data->stats.readings_generated += ( readings_due - MODEL_MAX_CATCH_UP_READINGS );
+        if ( model_fifo_collecting(data) )
+            { data->stats.readings_lost += ( readings_due - MODEL_MAX_CATCH_UP_READINGS ); }
+        data->next_x += ( readings_due - MODEL_MAX_CATCH_UP_READINGS );
+        readings_due = MODEL_MAX_CATCH_UP_READINGS;
+    }
+
+    while ( readings_due > 0 )
+    {
+        reading.x = (int16_t)( ( data->next_x & 0x0FFF ) << 4 );
+        reading.y = 0;
+        reading.z = MODEL_Z_AXIS_AT_ONE_G;
+        data->next_x++;
+
+        model_store_reading(data, &reading);
+        readings_due--;
+    }
+
+    data->regs[REG_STATUS_REG] = ( data->stats.readings_generated > 0 ? IIS2DH_XYZ_DATA_AVAILABLE_FLAG : 0 );
+    data->regs[REG_STATUS_REG_AUX] = TEMPERATURE_DATA_AVAILABLE;
+}
+
+
+
+static uint8_t model_fifo_src(const struct emul_iis2dh_data* data)
+{
+    uint8_t watermark = ( data->regs[REG_FIFO_CTRL_REG] & FIFO_TRIGGER_THRESHHOLD_MASK );
+    uint8_t fifo_src = 0;
+
+// FSS field holds 0..31, a full FIFO of 32 reads as 31 with OVRN_FIFO set:
+    fifo_src = ( ( data->fifo_level >= EMUL_IIS2DH_FIFO_DEPTH ) ? FIFO_SRC_FSS_MASK : data->fifo_level );
+
+    if ( ( watermark > 0 ) && ( data->fifo_level >= watermark ) )
+        { fifo_src |= FIFO_SOURCE_WATERMARK; }
+
+    if ( data->flag_fifo_overrun )
+        { fifo_src |= FIFO_SOURCE_OVERRUN; }
+
+    if ( data->fifo_level == 0 )
+        { fifo_src |= FIFO_SOURCE_EMPTY; }
+
+    return fifo_src;
+}
+
+
+
+static void model_pop_fifo(struct emul_iis2dh_data* data)
+{
+    if ( data->fifo_level == 0 )
+        { return; }
+
+    data->fifo_oldest = ( ( data->fifo_oldest + 1 ) % EMUL_IIS2DH_FIFO_DEPTH );
+    data->fifo_level--;
+    data->flag_fifo_overrun = 0;
+    data->stats.readings_read++;
+}
+
+
+
+static uint8_t model_read_register(struct emul_iis2dh_data* data, const uint8_t register_addr)
+{
+    const struct emul_iis2dh_reading* reading = &data->latest;
+    uint8_t offset = 0;
+
+    if ( register_addr >= EMUL_IIS2DH_REGISTER_COUNT )
+        { return 0; }
+
+    switch ( register_addr )
+    {
+        case OUT_TEMP_L:
+            return 0;
+
+        case OUT_TEMP_H:
+            return (uint8_t)data->temperature;
+
+        case REG_FIFO_SRC_REG:
+            return model_fifo_src(data);
+
+        default:
+            break;
+    }
+
+    if ( ( register_addr < REG_OUT_X_L ) || ( register_addr > REG_OUT_Z_H ) )
+        { return data->regs[register_addr]; }
+
+// With FIFO collecting, output registers show oldest FIFO reading:
+    if ( model_fifo_collecting(data) && ( data->fifo_level > 0 ) )
+        { reading = &data->fifo[data->fifo_oldest]; }
+
+    offset = ( register_addr - REG_OUT_X_L );
+    switch ( offset / 2 )
+    {
+        case 0:  return (uint8_t)( (uint16_t)reading->x >> ( 8 * ( offset & 1 ) ) );
+        case 1:  return (uint8_t)( (uint16_t)reading->y >> ( 8 * ( offset & 1 ) ) );
+        default: return (uint8_t)( (uint16_t)reading->z >> ( 8 * ( offset & 1 ) ) );
+    }
+}
+
+
+
+static void model_write_register(struct emul_iis2dh_data* data, const uint8_t register_addr, const uint8_t value)
+{
+    if ( ( register_addr < TEMP_CONFIG_REGISTER ) || ( register_addr >= EMUL_IIS2DH_REGISTER_COUNT ) )
+        { return; }
+
+// Read-only registers in writable range:
+    if ( ( register_addr == REG_STATUS_REG ) || ( ( register_addr >= REG_OUT_X_L ) && ( register_addr <= REG_OUT_Z_H ) )
+      || ( register_addr == REG_FIFO_SRC_REG ) )
+        { return; }
+
+    if ( ( register_addr == REG_CTRL_REG5 ) && ( value & CTRL_REG5_BOOT ) )
+    {
+        model_reset_registers(data);
+        return;
+    }
+
+    data->regs[register_addr] = value;
+
+// Bypass mode empties FIFO, iis2dh.pdf section 7.1:
+    if ( ( register_addr == REG_FIFO_CTRL_REG ) && ( ( value & FIFO_MODE_MASK ) == FIFO_MODE_BYPASS ) )
+    {
+        data->fifo_level = 0;
+        data->flag_fifo_overrun = 0;
+    }
+}
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Note:  with register address MSb set the register pointer advances
+ *   after each byte.  Reading OUT_Z_H with FIFO collecting pops the
+ *   oldest reading and pointer wraps back to OUT_X_L, so one burst
+ *   read drains many readings.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+static uint8_t model_read_next(struct emul_iis2dh_data* data, const uint32_t auto_increment)
+{
+    uint8_t register_addr = data->register_pointer;
+    uint8_t value = model_read_register(data, register_addr);
+
+    if ( ( register_addr == REG_OUT_Z_H ) && model_fifo_collecting(data) )
+    {
+        model_pop_fifo(data);
+        if ( auto_increment )
+            { data->register_pointer = REG_OUT_X_L; }
+        return value;
+    }
+
+    if ( auto_increment )
+        { data->register_pointer++; }
+
+    return value;
+}
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - routines emulated bus and INT1
+//----------------------------------------------------------------------
+
+static int emul_iis2dh_transfer(const struct emul* target, struct i2c_msg* msgs, int num_msgs, int addr)
+{
+    struct emul_iis2dh_data* data = (struct emul_iis2dh_data*)target->data;
+    uint32_t flag_register_pointer_set = 0;
+    uint32_t auto_increment = 0;
+    k_spinlock_key_t key;
+    int i = 0;
+    uint32_t j = 0;
+
+    if ( addr != data->cfg->addr )
+        { return -EIO; }
+
+    key = k_spin_lock(&data->lock);
+    model_update(data);
+    data->stats.bus_transfers++;
+
+    for ( i = 0; i < num_msgs; i++ )
+    {
+        if ( msgs[i].flags & I2C_MSG_READ )
+        {
+            for ( j = 0; j < msgs[i].len; j++ )
+                { msgs[i].buf[j] = model_read_next(data, auto_increment); }
+            continue;
+        }
+
+        for ( j = 0; j < msgs[i].len; j++ )
+        {
+// First byte written in transaction is register address, later bytes are data:
+            if ( flag_register_pointer_set == 0 )
+            {
+                data->register_pointer = ( msgs[i].buf[j] & ~EMUL_IIS2DH_AUTO_INCREMENT );
+                auto_increment = ( msgs[i].buf[j] & EMUL_IIS2DH_AUTO_INCREMENT );
+                flag_register_pointer_set = 1;
+                continue;
+            }
+
+            model_write_register(data, data->register_pointer, msgs[i].buf[j]);
+            if ( auto_increment )
+                { data->register_pointer++; }
+        }
+    }
+
+    k_spin_unlock(&data->lock, key);
+
+    return 0;
+}
+
+
+
+// INT1 active while routed FIFO watermark or overrun condition holds, iis2dh.pdf CTRL_REG3:
+static void emul_iis2dh_int1_poll(struct k_timer* timer)
+{
+    struct emul_iis2dh_data* data = CONTAINER_OF(timer, struct emul_iis2dh_data, int1_timer);
+    uint8_t fifo_src = 0;
+    uint32_t level = 0;
+    k_spinlock_key_t key;
+
+    key = k_spin_lock(&data->lock);
+    model_update(data);
+    fifo_src = model_fifo_src(data);
+
+    level = ( ( ( data->regs[REG_CTRL_REG3] & FIFO_WATERMARK_INTERRUPT_ON_INT1_ENABLE ) && ( fifo_src & FIFO_SOURCE_WATERMARK ) )
+           || ( ( data->regs[REG_CTRL_REG3] & FIFO_OVERRUN_INTERRUPT_ON_INT1_ENABLE ) && ( fifo_src & FIFO_SOURCE_OVERRUN ) ) );
+
+    if ( level && !data->int1_level )
+        { data->stats.int1_assertions++; }
+    data->int1_level = level;
+    k_spin_unlock(&data->lock, key);
+
+    gpio_emul_input_set(data->cfg->int1.port, data->cfg->int1.pin, level);
+}
+
+
+
+static struct i2c_emul_api emul_iis2dh_api =
+{
+    .transfer = emul_iis2dh_transfer,
+};
+
+
+
+static int emul_iis2dh_init(const struct emul* target, const struct device* parent)
+{
+    struct emul_iis2dh_data* data = (struct emul_iis2dh_data*)target->data;
+    const struct emul_iis2dh_cfg* cfg = (const struct emul_iis2dh_cfg*)target->cfg;
+
+    ARG_UNUSED(parent);
+
+// Emulator framework registers this target on parent bus, per bus API given to EMUL_DEFINE():
+    data->cfg = cfg;
+    data->last_update_ms = k_uptime_get();
+    data->temperature = 25;
+    model_reset_registers(data);
+
+    if ( cfg->int1.port != NULL )
+    {
+        k_timer_init(&data->int1_timer, emul_iis2dh_int1_poll, NULL);
+        k_timer_start(&data->int1_timer, K_MSEC(MODEL_INT1_POLL_PERIOD_MS), K_MSEC(MODEL_INT1_POLL_PERIOD_MS));
+    }
+
+    emul_iis2dh_instance = data;
+
+    return 0;
+}
+
+
+
+#define EMUL_IIS2DH_DEFINE(n)                                                   \
+    static struct emul_iis2dh_data emul_iis2dh_data_##n;                        \
+    static const struct emul_iis2dh_cfg emul_iis2dh_cfg_##n =                   \
+    {                                                                           \
+        .addr = DT_INST_REG_ADDR(n),                                            \
+        .int1 = GPIO_DT_SPEC_INST_GET_OR(n, drdy_gpios, { 0 }),                 \
+    };                                                                          \
+    EMUL_DEFINE(emul_iis2dh_init, DT_DRV_INST(n), &emul_iis2dh_cfg_##n,         \
+                &emul_iis2dh_data_##n, &emul_iis2dh_api)
+
+DT_INST_FOREACH_STATUS_OKAY(EMUL_IIS2DH_DEFINE)
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - routines public API
+//----------------------------------------------------------------------
+
+uint32_t emul_iis2dh_stats(struct emul_iis2dh_stats* stats)
+{
+    k_spinlock_key_t key;
+
+    if ( emul_iis2dh_instance == NULL )
+        { return KD__DEVICE_POINTER_NULL; }
+
+    key = k_spin_lock(&emul_iis2dh_instance->lock);
+    model_update(emul_iis2dh_instance);
+    *stats = emul_iis2dh_instance->stats;
+    k_spin_unlock(&emul_iis2dh_instance->lock, key);
+
+    return ROUTINE_OK;
+}
+
+
+
+void emul_iis2dh_reset_stats(void)
+{
+    k_spinlock_key_t key;
+
+    if ( emul_iis2dh_instance == NULL )
+        { return; }
+
+    key = k_spin_lock(&emul_iis2dh_instance->lock);
+    memset(&emul_iis2dh_instance->stats, 0, sizeof(emul_iis2dh_instance->stats));
+    k_spin_unlock(&emul_iis2dh_instance->lock, key);
+}
+
+
+
+void emul_iis2dh_set_temperature(const int8_t temperature)
+{
+    if ( emul_iis2dh_instance != NULL )
+        { emul_iis2dh_instance->temperature = temperature; }
+}
+
+
+
+#ifdef CONFIG_I2C_CALLBACK
+static void emul_iis2dh_run_deferred_transfer(struct k_work* work)
+{
+    struct emul_deferred_transfer transfer = deferred_transfer;
+    k_spinlock_key_t key;
+    int result = 0;
+
+    ARG_UNUSED(work);
+
+    result = i2c_transfer(transfer.bus, transfer.msgs, transfer.num_msgs, transfer.addr);
+
+    if ( emul_iis2dh_instance != NULL )
+    {
+        key = k_spin_lock(&emul_iis2dh_instance->lock);
+        emul_iis2dh_instance->stats.callback_transfers++;
+        k_spin_unlock(&emul_iis2dh_instance->lock, key);
+    }
+
+// Free before callback, as a real driver is, so callback may start next transfer:
+    atomic_clear(&deferred_transfer.in_flight);
+    transfer.callback(transfer.bus, result, transfer.userdata);
+}
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Same contract as i2c_transfer_cb():  returns at once, and
+ *           messages and their buffers must stay valid until callback
+ *           runs.  Returns -EWOULDBLOCK while a transfer is in flight.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+int emul_iis2dh_transfer_cb(const struct device* bus,
+                            struct i2c_msg* msgs,
+                            const uint8_t num_msgs,
+                            const uint16_t addr,
+                            i2c_callback_t callback,
+                            void* userdata)
+{
+    uint32_t bytes = 0;
+    uint32_t delay_us = 0;
+    uint32_t i = 0;
+
+    if ( !atomic_cas(&deferred_transfer.in_flight, 0, 1) )
+        { return -EWOULDBLOCK; }
+
+    deferred_transfer.bus = bus;
+    deferred_transfer.msgs = msgs;
+    deferred_transfer.num_msgs = num_msgs;
+    deferred_transfer.addr = addr;
+    deferred_transfer.callback = callback;
+    deferred_transfer.userdata = userdata;
+
+// Address byte ahead of each message, then its data:
+    for ( i = 0; i < num_msgs; i++ )
+        { bytes += ( 1 + msgs[i].len ); }
+    delay_us = ( ( bytes * MODEL_I2C_BITS_PER_BYTE * 1000000U ) / MODEL_I2C_BUS_HZ );
+    delay_us += ( deferred_transfer.stall_ms * 1000U );
+
+    k_work_schedule(&deferred_transfer_work, K_USEC(delay_us));
+
+    return 0;
+}
+
+
+
+void emul_iis2dh_set_transfer_cb_stall(const uint32_t stall_ms)
+{
+    deferred_transfer.stall_ms = stall_ms;
+}
+#endif
+
+
+
+// --- EOF ---
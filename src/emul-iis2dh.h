@@ -0,0 +1,74 @@
+#ifndef _EMUL_IIS2DH_H
+#define _EMUL_IIS2DH_H
+
+/*
+ * ---------------------------------------------------------------------
+ *
+ *  @Project   Kionix Driver Demo
+ *
+ *  @File      emul-iis2dh.h
+ *
+ *  @Brief     Behavioral model of STMicro IIS2DH on a Zephyr emulated
+ *   I2C bus, for hardware-free targets such as native_posix.  Model
+ *   produces readings at configured ODR into a 32 level FIFO, honors
+ *   bypass, FIFO and stream modes, watermark and overrun flags, and
+ *   drives INT1 through gpio-emul when sensor node has 'drdy-gpios'.
+ *
+ *   X axis readings count up by one per reading generated, so a gap
+ *   in x values seen by consumers marks readings lost.
+ *
+ * ---------------------------------------------------------------------
+ */
+
+#include <stdint.h>                // to provide define of uint32_t
+
+#include <drivers/i2c.h>           // to provide struct i2c_msg, i2c_callback_t
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - symbols and structures to share with other modules
+//----------------------------------------------------------------------
+
+struct emul_iis2dh_stats
+{
+    uint32_t readings_generated;
+    uint32_t readings_read;        // readings popped from FIFO by bus reads
+    uint32_t readings_lost;        // overwritten in stream mode, or discarded with FIFO full
+    uint32_t fifo_overruns;        // times FIFO filled with readings unread
+    uint32_t bus_transfers;
+    uint32_t callback_transfers;   // transfers run by emul_iis2dh_transfer_cb()
+    uint32_t int1_assertions;
+};
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - routine prototypes
+//----------------------------------------------------------------------
+
+uint32_t emul_iis2dh_stats(struct emul_iis2dh_stats* stats);
+
+void emul_iis2dh_reset_stats(void);
+
+// Value reported in OUT_TEMP_H, per iis2dh.pdf a relative temperature in degrees C:
+void emul_iis2dh_set_temperature(const int8_t temperature);
+
+#ifdef CONFIG_I2C_CALLBACK
+// Zephyr 3.2 i2c-emul has no i2c_transfer_cb() support.  This stands in
+// for it in tests:  transfer runs on system work queue after time it
+// would take at 400 kHz, plus any stall set below, then callback runs:
+int emul_iis2dh_transfer_cb(const struct device* bus,
+                            struct i2c_msg* msgs,
+                            const uint8_t num_msgs,
+                            const uint16_t addr,
+                            i2c_callback_t callback,
+                            void* userdata);
+
+// Extra delay before each transfer above, to model a stuck bus:
+void emul_iis2dh_set_transfer_cb_stall(const uint32_t stall_ms);
+#endif
+
+
+
+#endif // _EMUL_IIS2DH_H
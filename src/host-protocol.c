@@ -0,0 +1,450 @@
+/*
+ * ---------------------------------------------------------------------
+ *
+ *  @Project   Kionix Driver Demo
+ *
+ *  @File      host-protocol.c
+ *
+ *  @Brief     COBS framed binary requests and replies on CLI UART,
+ *   frame layout in host-protocol.h.  Requests are decoded and handled
+ *   in CLI thread, sample records are framed by sample log thread, so
+ *   frame transmit is serialized by a mutex.
+ *
+ *  @Note      COBS, Consistent Overhead Byte Stuffing, replaces every
+ *   0x00 in a frame so 0x00 marks frame ends alone.  Overhead is one
+ *   byte per 254 bytes of frame.
+ *
+ * ---------------------------------------------------------------------
+ */
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - pound includes
+//----------------------------------------------------------------------
+
+#include <stdint.h>                // to provide define of uint32_t
+#include <stdio.h>                 // to provide snprintf()
+#include <string.h>                // to provide memcpy()
+
+#include <zephyr.h>
+#include <sys/crc.h>               // to provide crc16_itu_t()
+
+#include "common.h"                // to provide TRUE and FALSE
+#include "diagnostic.h"            // to provide SIZE_OF_MESSAGE_MEDIUM
+#include "host-protocol.h"
+#include "iis2dh-registers.h"      // to provide IIS2DH ODR enumeration, IIS2DH_I2C_AUTO_INCREMENT
+#include "kd-app-config.h"
+#include "return-values.h"
+#include "scoreboard.h"
+#include "thread-iis2dh.h"
+#include "thread-sample-log.h"
+#include "thread-simple-cli.h"     // to provide cli_uart_write_bytes()
+#include "version.h"
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - pound defines
+//----------------------------------------------------------------------
+
+#define HOST_PROTOCOL_HEADER_SIZE   (2)
+#define HOST_PROTOCOL_CRC_SIZE      (2)
+#define HOST_PROTOCOL_MAX_PAYLOAD   (HOST_PROTOCOL_HEADER_SIZE + HOST_PROTOCOL_MAX_DATA + HOST_PROTOCOL_CRC_SIZE)
+#define HOST_PROTOCOL_MAX_ENCODED   (HOST_PROTOCOL_MAX_PAYLOAD + (HOST_PROTOCOL_MAX_PAYLOAD / 254) + 1)
+
+// Seed giving CRC-16/CCITT-FALSE, as Python binascii.crc_hqx(data, 0xFFFF):
+#define HOST_PROTOCOL_CRC_SEED      (0xFFFF)
+
+// NACK reasons:
+#define HOST_NACK_BAD_FRAME         (1)
+#define HOST_NACK_UNKNOWN_MESSAGE   (2)
+#define HOST_NACK_BAD_ARGUMENT      (3)
+#define HOST_NACK_SENSOR_ERROR      (4)
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - file scoped variables
+//----------------------------------------------------------------------
+
+// Receive side, CLI thread only:
+static uint8_t rx_frame[HOST_PROTOCOL_MAX_ENCODED];
+static uint32_t rx_length;
+static uint32_t rx_active;
+static uint32_t rx_discarding;
+static int64_t rx_last_byte_ms;
+
+// Transmit side, any thread holding mutex.  Mutex guards frame buffers,
+// cli_uart_write_bytes() keeps each frame whole among other CLI output:
+K_MUTEX_DEFINE(host_protocol_tx_mutex);
+static uint8_t tx_payload[HOST_PROTOCOL_MAX_PAYLOAD];
+static uint8_t tx_encoded[HOST_PROTOCOL_MAX_ENCODED + 2];
+
+static uint32_t frames_received;
+static uint32_t frames_rejected;
+static uint32_t frames_sent;
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - COBS framing
+//----------------------------------------------------------------------
+
+static uint32_t cobs_encode(const uint8_t* input, const uint32_t length, uint8_t* output)
+{
+    uint32_t read = 0;
+    uint32_t write = 1;
+    uint32_t code_index = 0;
+    uint8_t code = 1;
+
+    while ( read < length )
+    {
+        if ( input[read] == 0 )
+        {
+            output[code_index] = code;
+            code = 1;
+            code_index = write++;
+            read++;
+        }
+        else
+        {
+            output[write++] = input[read++];
+            code++;
+            if ( code == 0xFF )
+            {
+                output[code_index] = code;
+                code = 1;
+                code_index = write++;
+            }
+        }
+    }
+
+    output[code_index] = code;
+    return write;
+}
+
+
+
+// Decodes in place safely, output never runs ahead of input:
+static uint32_t cobs_decode(const uint8_t* input, const uint32_t length, uint8_t* output, uint32_t* decoded_length)
+{
+    uint32_t read = 0;
+    uint32_t write = 0;
+    uint8_t code = 0;
+
+    while ( read < length )
+    {
+        code = input[read++];
+        if ( code == 0 )
+            { return KD__HOST_PROTOCOL_BAD_FRAME; }
+
+        for ( uint8_t i = 1; i < code; i++ )
+        {
+            if ( read >= length )
+                { return KD__HOST_PROTOCOL_BAD_FRAME; }
+            output[write++] = input[read++];
+        }
+
+        if (( code != 0xFF ) && ( read < length ))
+            { output[write++] = 0; }
+    }
+
+    *decoded_length = write;
+    return ROUTINE_OK;
+}
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - transmit
+//----------------------------------------------------------------------
+
+uint32_t host_protocol_send_frame(const uint8_t type, const uint8_t sequence,
+                                  const uint8_t* data, const uint32_t length)
+{
+    uint32_t rstatus = ROUTINE_OK;
+    uint32_t payload_length = HOST_PROTOCOL_HEADER_SIZE + length;
+    uint32_t encoded_length = 0;
+    uint16_t crc = 0;
+
+    if ( length > HOST_PROTOCOL_MAX_DATA )
+    {
+        return KD__HOST_PROTOCOL_FRAME_TOO_LONG;
+    }
+
+    k_mutex_lock(&host_protocol_tx_mutex, K_FOREVER);
+
+    tx_payload[0] = type;
+    tx_payload[1] = sequence;
+    if ( length > 0 )
+    {
+        memcpy(&tx_payload[HOST_PROTOCOL_HEADER_SIZE], data, length);
+    }
+    crc = crc16_itu_t(HOST_PROTOCOL_CRC_SEED, tx_payload, payload_length);
+    tx_payload[payload_length++] = (uint8_t)( crc );
+    tx_payload[payload_length++] = (uint8_t)( crc >> 8 );
+
+    encoded_length = cobs_encode(tx_payload, payload_length, &tx_encoded[1]);
+    tx_encoded[0] = 0;
+    tx_encoded[1 + encoded_length] = 0;
+
+    rstatus = cli_uart_write_bytes(tx_encoded, (encoded_length + 2));
+    frames_sent++;
+
+    k_mutex_unlock(&host_protocol_tx_mutex);
+
+    return rstatus;
+}
+
+
+
+static void send_nack(const uint8_t request_type, const uint8_t sequence, const uint8_t reason)
+{
+    uint8_t data[2] = { request_type, reason };
+
+    host_protocol_send_frame(HOST_MSG_NACK, sequence, data, sizeof(data));
+}
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - request handlers
+//----------------------------------------------------------------------
+
+static void handle_request(const uint8_t type, const uint8_t sequence, const uint8_t* data, const uint32_t length)
+{
+    uint8_t reply[HOST_PROTOCOL_MAX_DATA];
+    uint32_t rstatus = ROUTINE_OK;
+
+    switch (type)
+    {
+        case HOST_MSG_PING:
+        {
+            reply[0] = HOST_PROTOCOL_VERSION;
+            reply[1] = KD_VERSION_NUMBER_MAJOR;
+            reply[2] = KD_VERSION_NUMBER_MINOR;
+            reply[3] = KD_VERSION_NUMBER_BRANCH;
+            host_protocol_send_frame((type | HOST_MSG_REPLY), sequence, reply, 4);
+            break;
+        }
+
+        case HOST_MSG_READ_REGISTERS:
+        {
+            if (( length != 2 ) || ( data[1] == 0 ) || ( data[1] > (HOST_PROTOCOL_MAX_DATA - 2) ))
+            {
+                send_nack(type, sequence, HOST_NACK_BAD_ARGUMENT);
+                break;
+            }
+
+// IIS2DH returns consecutive registers only with auto-increment bit set:
+            rstatus = wrapper_iis2dh_register_read_multiple(
+              ( data[1] > 1 ? ( data[0] | IIS2DH_I2C_AUTO_INCREMENT ) : data[0] ), &reply[2], data[1]);
+            if ( rstatus != ROUTINE_OK )
+            {
+                send_nack(type, sequence, HOST_NACK_SENSOR_ERROR);
+                break;
+            }
+
+            reply[0] = data[0];
+            reply[1] = data[1];
+            host_protocol_send_frame((type | HOST_MSG_REPLY), sequence, reply, (2 + data[1]));
+            break;
+        }
+
+        case HOST_MSG_WRITE_REGISTER:
+        {
+            if ( length != 2 )
+            {
+                send_nack(type, sequence, HOST_NACK_BAD_ARGUMENT);
+                break;
+            }
+
+            rstatus = wrapper_iis2dh_register_write(data[0], data[1]);
+            reply[0] = (uint8_t)rstatus;
+            host_protocol_send_frame((type | HOST_MSG_REPLY), sequence, reply, 1);
+            break;
+        }
+
+        case HOST_MSG_SET_ODR:
+        {
+            if (( length != 1 ) || ( data[0] > HIGHEST_DATA_RATE_INDEX ))
+            {
+                send_nack(type, sequence, HOST_NACK_BAD_ARGUMENT);
+                break;
+            }
+
+// IIS2DH ODR flags are data rate index in CTRL_REG1 bits 7:4:
+            rstatus = scoreboard__set_requested_iis2dh_odr((enum iis2dh_output_data_rates_e)(data[0] << 4));
+            reply[0] = (uint8_t)rstatus;
+            host_protocol_send_frame((type | HOST_MSG_REPLY), sequence, reply, 1);
+            break;
+        }
+
+        case HOST_MSG_STREAM_SAMPLES:
+        {
+            if ( length != 1 )
+            {
+                send_nack(type, sequence, HOST_NACK_BAD_ARGUMENT);
+                break;
+            }
+
+            if ( data[0] )
+            {
+                sample_log__set_output(SAMPLE_LOG_OUTPUT_HOST_FRAMES);
+            }
+            sample_log__set_enabled(data[0]);
+            reply[0] = (uint8_t)sample_log__is_enabled();
+            host_protocol_send_frame((type | HOST_MSG_REPLY), sequence, reply, 1);
+            break;
+        }
+
+        default:
+            send_nack(type, sequence, HOST_NACK_UNKNOWN_MESSAGE);
+            break;
+    }
+}
+
+
+
+static void handle_frame(void)
+{
+    uint32_t decoded_length = 0;
+    uint16_t crc_received = 0;
+    uint16_t crc_computed = 0;
+
+    if (( cobs_decode(rx_frame, rx_length, rx_frame, &decoded_length) != ROUTINE_OK ) ||
+        ( decoded_length < (HOST_PROTOCOL_HEADER_SIZE + HOST_PROTOCOL_CRC_SIZE) ))
+    {
+        frames_rejected++;
+        return;
+    }
+
+    decoded_length -= HOST_PROTOCOL_CRC_SIZE;
+    crc_received = (uint16_t)( rx_frame[decoded_length] | ( rx_frame[decoded_length + 1] << 8 ) );
+    crc_computed = crc16_itu_t(HOST_PROTOCOL_CRC_SEED, rx_frame, decoded_length);
+
+    if ( crc_received != crc_computed )
+    {
+        frames_rejected++;
+        send_nack(rx_frame[0], rx_frame[1], HOST_NACK_BAD_FRAME);
+        return;
+    }
+
+    frames_received++;
+    handle_request(rx_frame[0], rx_frame[1], &rx_frame[HOST_PROTOCOL_HEADER_SIZE],
+                   (decoded_length - HOST_PROTOCOL_HEADER_SIZE));
+}
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - receive
+//----------------------------------------------------------------------
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Called by CLI with each received byte before text command
+ *           handling.  A 0x00 at an empty command line starts a frame,
+ *           next 0x00 ends it.  Frames stalled longer than
+ *           KD_APP_HOST_PROTOCOL_FRAME_TIMEOUT_MS are abandoned, so a
+ *           stray 0x00 never leaves CLI deaf to typed commands.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+uint32_t host_protocol_claims_byte(const uint8_t byte, const uint32_t command_line_empty)
+{
+    int64_t now = k_uptime_get();
+
+    if ( rx_active && ( (now - rx_last_byte_ms) > KD_APP_HOST_PROTOCOL_FRAME_TIMEOUT_MS ) )
+    {
+        rx_active = 0;
+        if ( rx_length > 0 )
+            { frames_rejected++; }
+    }
+
+    if ( !rx_active )
+    {
+        if (( byte != 0x00 ) || !command_line_empty )
+        {
+            return FALSE;
+        }
+
+        rx_active = 1;
+        rx_discarding = 0;
+        rx_length = 0;
+        rx_last_byte_ms = now;
+        return TRUE;
+    }
+
+    rx_last_byte_ms = now;
+
+    if ( byte == 0x00 )
+    {
+// Back to back delimiters are empty frames, keep waiting for data:
+        if (( rx_length == 0 ) && !rx_discarding )
+        {
+            return TRUE;
+        }
+
+        if ( !rx_discarding )
+        {
+            handle_frame();
+        }
+
+        rx_active = 0;
+        rx_length = 0;
+        return TRUE;
+    }
+
+    if ( rx_length >= sizeof(rx_frame) )
+    {
+        if ( !rx_discarding )
+            { frames_rejected++; }
+        rx_discarding = 1;
+        return TRUE;
+    }
+
+    rx_frame[rx_length++] = byte;
+    return TRUE;
+}
+
+
+
+uint32_t host_protocol_frames_received(void)
+{
+    return frames_received;
+}
+
+uint32_t host_protocol_frames_rejected(void)
+{
+    return frames_rejected;
+}
+
+uint32_t host_protocol_frames_sent(void)
+{
+    return frames_sent;
+}
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - command handlers
+//----------------------------------------------------------------------
+
+uint32_t cli__host_protocol(const char* args)
+{
+    char lbuf[SIZE_OF_MESSAGE_MEDIUM];
+
+    snprintf(lbuf, sizeof(lbuf), "\n\rhost protocol v%u:  %u frames received, %u rejected, %u sent\n\r",
+      HOST_PROTOCOL_VERSION, frames_received, frames_rejected, frames_sent);
+    printk_cli(lbuf);
+
+    return ROUTINE_OK;
+}
+
+KD_CLI_COMMAND_DEFINE(host, "host", "show binary host protocol frame counters", &cli__host_protocol);
+
+
+
+// --- EOF ---
@@ -0,0 +1,80 @@
+#ifndef _HOST_PROTOCOL_H
+#define _HOST_PROTOCOL_H
+
+/*
+ * ---------------------------------------------------------------------
+ *
+ *  @Project   Kionix Driver Demo
+ *
+ *  @File      host-protocol.h
+ *
+ *  @Brief     Binary framed protocol sharing CLI UART with text
+ *   commands, for host tools pulling register blocks and readings
+ *   without text formatting.  Frame, before COBS encoding:
+ *
+ *     offset  size  field
+ *     ------  ----  ----------------------------------------------
+ *          0     1  message type, see enum host_protocol_messages
+ *          1     1  sequence, echoed in reply
+ *          2     N  message data, 0 to HOST_PROTOCOL_MAX_DATA bytes
+ *        2+N     2  CRC-16/CCITT-FALSE of bytes 0 to 1+N, little endian
+ *
+ *   On the wire a frame is COBS encoded and followed by 0x00.  Host
+ *   sends 0x00 before each request too:  a 0x00 arriving at an empty
+ *   command line switches CLI to binary for one frame, then back to
+ *   text.  Replies carry request type with HOST_MSG_REPLY bit set.
+ *
+ *   Host side tool at tools/kd-host.py.
+ *
+ * ---------------------------------------------------------------------
+ */
+
+#include <stdint.h>                // to provide define of uint32_t
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - symbols and structures to share with other modules
+//----------------------------------------------------------------------
+
+#define HOST_PROTOCOL_VERSION   (1)
+#define HOST_PROTOCOL_MAX_DATA  (240)
+
+enum host_protocol_messages
+{
+// Requests from host, data noted after each:
+    HOST_MSG_PING            = 0x01,   // none, reply protocol and app versions
+    HOST_MSG_READ_REGISTERS  = 0x02,   // first register, count, reply both then values
+    HOST_MSG_WRITE_REGISTER  = 0x03,   // register, value, reply status
+    HOST_MSG_SET_ODR         = 0x04,   // ODR index 0 to 9 as for `odr` command, reply status
+    HOST_MSG_STREAM_SAMPLES  = 0x05,   // 1 = start and 0 = stop, reply state
+
+    HOST_MSG_REPLY           = 0x80,
+
+// Unsolicited, while streaming.  Data is sample log record less its
+// two sync bytes, see thread-sample-log.h:
+    HOST_MSG_SAMPLE_RECORD   = 0x90,
+
+// Reply to a request not understood, data is request type and reason:
+    HOST_MSG_NACK            = 0xFF
+};
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - routine prototypes
+//----------------------------------------------------------------------
+
+// CLI passes each received byte here first, returns TRUE when byte belongs to a binary frame:
+uint32_t host_protocol_claims_byte(const uint8_t byte, const uint32_t command_line_empty);
+
+uint32_t host_protocol_send_frame(const uint8_t type, const uint8_t sequence,
+                                  const uint8_t* data, const uint32_t length);
+
+uint32_t host_protocol_frames_received(void);
+uint32_t host_protocol_frames_rejected(void);
+uint32_t host_protocol_frames_sent(void);
+
+
+
+#endif // _HOST_PROTOCOL_H
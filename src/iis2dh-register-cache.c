@@ -0,0 +1,269 @@
+/*
+ * ---------------------------------------------------------------------
+ *
+ *  @Project   Kionix Driver Demo
+ *
+ *  @File      iis2dh-register-cache.c
+ *
+ *  @Brief     Shadow copy of IIS2DH register map with volatile versus
+ *   non-volatile classification and dirty tracking.  See header for
+ *   overview.
+ *
+ *  @Reference iis2dh.pdf DocID027668 Rev 2, table 16 register address
+ *   map and section 8 register reset values.
+ *
+ * ---------------------------------------------------------------------
+ */
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - pound includes
+//----------------------------------------------------------------------
+
+#include <stdint.h>                // to provide define of uint32_t
+#include <string.h>                // to provide memset()
+
+#include "iis2dh-register-cache.h"
+#include "return-values.h"
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - file scoped
+//----------------------------------------------------------------------
+
+struct iis2dh_register_description
+{
+    uint8_t address;
+    uint8_t register_class;        // enum iis2dh_register_classes_e
+    uint8_t reset_value;
+    const char* name;
+};
+
+// Registers of 0x07..0x3F not listed here are reserved:
+static const struct iis2dh_register_description iis2dh_registers[] =
+{
+    { 0x07, IIS2DH_REGISTER_VOLATILE,     0x00, "STATUS_REG_AUX" },
+    { 0x0C, IIS2DH_REGISTER_VOLATILE,     0x00, "OUT_TEMP_L" },
+    { 0x0D, IIS2DH_REGISTER_VOLATILE,     0x00, "OUT_TEMP_H" },
+    { 0x0F, IIS2DH_REGISTER_READ_ONLY,    0x33, "WHO_AM_I" },
+    { 0x1F, IIS2DH_REGISTER_NON_VOLATILE, 0x00, "TEMP_CFG_REG" },
+    { 0x20, IIS2DH_REGISTER_NON_VOLATILE, 0x07, "CTRL_REG1" },
+    { 0x21, IIS2DH_REGISTER_NON_VOLATILE, 0x00, "CTRL_REG2" },
+    { 0x22, IIS2DH_REGISTER_NON_VOLATILE, 0x00, "CTRL_REG3" },
+    { 0x23, IIS2DH_REGISTER_NON_VOLATILE, 0x00, "CTRL_REG4" },
+    { 0x24, IIS2DH_REGISTER_NON_VOLATILE, 0x00, "CTRL_REG5" },
+    { 0x25, IIS2DH_REGISTER_NON_VOLATILE, 0x00, "CTRL_REG6" },
+    { 0x26, IIS2DH_REGISTER_VOLATILE,     0x00, "REFERENCE" },       // read resets high pass filter
+    { 0x27, IIS2DH_REGISTER_VOLATILE,     0x00, "STATUS_REG" },
+    { 0x28, IIS2DH_REGISTER_VOLATILE,     0x00, "OUT_X_L" },
+    { 0x29, IIS2DH_REGISTER_VOLATILE,     0x00, "OUT_X_H" },
+    { 0x2A, IIS2DH_REGISTER_VOLATILE,     0x00, "OUT_Y_L" },
+    { 0x2B, IIS2DH_REGISTER_VOLATILE,     0x00, "OUT_Y_H" },
+    { 0x2C, IIS2DH_REGISTER_VOLATILE,     0x00, "OUT_Z_L" },
+    { 0x2D, IIS2DH_REGISTER_VOLATILE,     0x00, "OUT_Z_H" },
+    { 0x2E, IIS2DH_REGISTER_NON_VOLATILE, 0x00, "FIFO_CTRL_REG" },
+    { 0x2F, IIS2DH_REGISTER_VOLATILE,     0x00, "FIFO_SRC_REG" },
+    { 0x30, IIS2DH_REGISTER_NON_VOLATILE, 0x00, "INT1_CFG" },
+    { 0x31, IIS2DH_REGISTER_VOLATILE,     0x00, "INT1_SRC" },
+    { 0x32, IIS2DH_REGISTER_NON_VOLATILE, 0x00, "INT1_THS" },
+    { 0x33, IIS2DH_REGISTER_NON_VOLATILE, 0x00, "INT1_DURATION" },
+    { 0x34, IIS2DH_REGISTER_NON_VOLATILE, 0x00, "INT2_CFG" },
+    { 0x35, IIS2DH_REGISTER_VOLATILE,     0x00, "INT2_SRC" },
+    { 0x36, IIS2DH_REGISTER_NON_VOLATILE, 0x00, "INT2_THS" },
+    { 0x37, IIS2DH_REGISTER_NON_VOLATILE, 0x00, "INT2_DURATION" },
+    { 0x38, IIS2DH_REGISTER_NON_VOLATILE, 0x00, "CLICK_CFG" },
+    { 0x39, IIS2DH_REGISTER_VOLATILE,     0x00, "CLICK_SRC" },
+    { 0x3A, IIS2DH_REGISTER_NON_VOLATILE, 0x00, "CLICK_THS" },
+    { 0x3B, IIS2DH_REGISTER_NON_VOLATILE, 0x00, "TIME_LIMIT" },
+    { 0x3C, IIS2DH_REGISTER_NON_VOLATILE, 0x00, "TIME_LATENCY" },
+    { 0x3D, IIS2DH_REGISTER_NON_VOLATILE, 0x00, "TIME_WINDOW" },
+    { 0x3E, IIS2DH_REGISTER_NON_VOLATILE, 0x00, "ACT_THS" },
+    { 0x3F, IIS2DH_REGISTER_NON_VOLATILE, 0x00, "ACT_DUR" }
+};
+
+#define IIS2DH_REGISTERS_DESCRIBED ( sizeof(iis2dh_registers) / sizeof(iis2dh_registers[0]) )
+
+#define CACHE_INDEX(register_addr) ( (register_addr) - IIS2DH_REGISTER_CACHE_FIRST )
+#define CACHE_BIT(register_addr) ( (uint64_t)1 << CACHE_INDEX(register_addr) )
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - routines
+//----------------------------------------------------------------------
+
+static const struct iis2dh_register_description* description_of(const uint8_t register_addr)
+{
+    uint32_t i = 0;
+
+    for ( i = 0; i < IIS2DH_REGISTERS_DESCRIBED; i++ )
+    {
+        if ( iis2dh_registers[i].address == register_addr )
+            { return &iis2dh_registers[i]; }
+    }
+
+    return NULL;
+}
+
+
+
+uint32_t iis2dh_register_in_cache_range(const uint8_t register_addr)
+{
+    return ( ( register_addr >= IIS2DH_REGISTER_CACHE_FIRST ) && ( register_addr <= IIS2DH_REGISTER_CACHE_LAST ) );
+}
+
+
+
+enum iis2dh_register_classes_e iis2dh_register_class(const uint8_t register_addr)
+{
+    const struct iis2dh_register_description* description = description_of(register_addr);
+
+    if ( description == NULL )
+        { return IIS2DH_REGISTER_RESERVED; }
+
+    return (enum iis2dh_register_classes_e)description->register_class;
+}
+
+
+
+const char* iis2dh_register_name(const uint8_t register_addr)
+{
+    const struct iis2dh_register_description* description = description_of(register_addr);
+
+    if ( description == NULL )
+        { return "RESERVED"; }
+
+    return description->name;
+}
+
+
+
+void iis2dh_register_cache_init(struct iis2dh_register_cache* cache)
+{
+    uint32_t i = 0;
+
+    memset(cache, 0, sizeof(struct iis2dh_register_cache));
+
+    for ( i = 0; i < IIS2DH_REGISTERS_DESCRIBED; i++ )
+    {
+        uint8_t addr = iis2dh_registers[i].address;
+
+        cache->wanted[CACHE_INDEX(addr)] = iis2dh_registers[i].reset_value;
+        cache->on_sensor[CACHE_INDEX(addr)] = iis2dh_registers[i].reset_value;
+
+// Sensor may not have been reset along with MCU, so first flush sends every writable register:
+        if ( iis2dh_registers[i].register_class == IIS2DH_REGISTER_NON_VOLATILE )
+            { cache->dirty |= CACHE_BIT(addr); }
+    }
+}
+
+
+
+uint8_t iis2dh_register_cache_wanted(const struct iis2dh_register_cache* cache, const uint8_t register_addr)
+{
+    if ( !iis2dh_register_in_cache_range(register_addr) )
+        { return 0; }
+
+    return cache->wanted[CACHE_INDEX(register_addr)];
+}
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Set value firmware wants sensor register to hold.  Marks
+ *           register dirty unless sensor is known to hold it already.
+ *           Only non-volatile registers are settable.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+void iis2dh_register_cache_set(struct iis2dh_register_cache* cache, const uint8_t register_addr, const uint8_t value)
+{
+    if ( iis2dh_register_class(register_addr) != IIS2DH_REGISTER_NON_VOLATILE )
+        { return; }
+
+    cache->wanted[CACHE_INDEX(register_addr)] = value;
+
+    if ( ( cache->known & CACHE_BIT(register_addr) ) && ( cache->on_sensor[CACHE_INDEX(register_addr)] == value ) )
+        { cache->dirty &= ~CACHE_BIT(register_addr); }
+    else
+        { cache->dirty |= CACHE_BIT(register_addr); }
+}
+
+
+
+void iis2dh_register_cache_note_on_sensor(struct iis2dh_register_cache* cache, const uint8_t register_addr, const uint8_t value)
+{
+    if ( iis2dh_register_class(register_addr) != IIS2DH_REGISTER_NON_VOLATILE )
+        { return; }
+
+    cache->on_sensor[CACHE_INDEX(register_addr)] = value;
+    cache->known |= CACHE_BIT(register_addr);
+
+// A read back of a clean register may show a change made outside this cache:
+    if ( ( cache->dirty & CACHE_BIT(register_addr) ) == 0 )
+        { cache->wanted[CACHE_INDEX(register_addr)] = value; }
+
+    if ( cache->wanted[CACHE_INDEX(register_addr)] == value )
+        { cache->dirty &= ~CACHE_BIT(register_addr); }
+}
+
+
+
+uint32_t iis2dh_register_cache_lookup(const struct iis2dh_register_cache* cache, const uint8_t register_addr, uint8_t* value)
+{
+    enum iis2dh_register_classes_e register_class = iis2dh_register_class(register_addr);
+
+    if ( register_class == IIS2DH_REGISTER_READ_ONLY )
+    {
+        *value = description_of(register_addr)->reset_value;
+        return ROUTINE_OK;
+    }
+
+    if ( ( register_class != IIS2DH_REGISTER_NON_VOLATILE ) || ( ( cache->known & CACHE_BIT(register_addr) ) == 0 ) )
+        { return KD__IIS2DH_REGISTER_CACHE_MISS; }
+
+    *value = cache->on_sensor[CACHE_INDEX(register_addr)];
+    return ROUTINE_OK;
+}
+
+
+
+uint32_t iis2dh_register_cache_is_dirty(const struct iis2dh_register_cache* cache, const uint8_t register_addr)
+{
+    if ( !iis2dh_register_in_cache_range(register_addr) )
+        { return 0; }
+
+    return ( ( cache->dirty & CACHE_BIT(register_addr) ) != 0 );
+}
+
+
+
+uint32_t iis2dh_register_cache_dirty_span(const struct iis2dh_register_cache* cache,
+                                          const uint8_t first,
+                                          const uint8_t last,
+                                          uint8_t* span_first,
+                                          uint8_t* span_last)
+{
+    uint32_t found = 0;
+    uint8_t addr = 0;
+
+    for ( addr = first; ( addr <= last ) && iis2dh_register_in_cache_range(addr); addr++ )
+    {
+        if ( cache->dirty & CACHE_BIT(addr) )
+        {
+            if ( found == 0 )
+                { *span_first = addr; }
+            *span_last = addr;
+            found = 1;
+        }
+    }
+
+    return found;
+}
+
+
+
+// --- EOF ---
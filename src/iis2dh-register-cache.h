@@ -0,0 +1,92 @@
+#ifndef _IIS2DH_REGISTER_CACHE_H
+#define _IIS2DH_REGISTER_CACHE_H
+
+/*
+ * ---------------------------------------------------------------------
+ *
+ *  @Project   Kionix Driver Demo
+ *
+ *  @File      iis2dh-register-cache.h
+ *
+ *  @Brief     Shadow copy of IIS2DH register map 0x07..0x3F.  Each
+ *   register holds two values:  the value firmware wants the sensor to
+ *   hold, and the value the sensor is last known to hold.  A register
+ *   is dirty when the two may differ, and is flushed to the sensor by
+ *   IIS2DH thread.  Non-volatile registers, which only change when
+ *   written, are read from cache once their sensor value is known.
+ *   Volatile registers (status, data, interrupt source) always come
+ *   from the bus.
+ *
+ *   This module does no bus access and takes no locks itself.  Its
+ *   user serializes access, see iis2dh_register_shadow_lock in
+ *   thread-iis2dh.c.
+ *
+ * ---------------------------------------------------------------------
+ */
+
+#include <stdint.h>                // to provide define of uint32_t, uint64_t
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - symbols and structures to share with other modules
+//----------------------------------------------------------------------
+
+#define IIS2DH_REGISTER_CACHE_FIRST (0x07)
+#define IIS2DH_REGISTER_CACHE_LAST  (0x3F)
+#define IIS2DH_REGISTER_CACHE_SIZE  ( IIS2DH_REGISTER_CACHE_LAST - IIS2DH_REGISTER_CACHE_FIRST + 1 )
+
+enum iis2dh_register_classes_e
+{
+    IIS2DH_REGISTER_RESERVED,      // not to be read or written, per iis2dh.pdf table 16
+    IIS2DH_REGISTER_READ_ONLY,     // fixed value, e.g. WHO_AM_I
+    IIS2DH_REGISTER_VOLATILE,      // changed by sensor, or read has side effects
+    IIS2DH_REGISTER_NON_VOLATILE   // configuration, changes only when written
+};
+
+// Bit n of each mask refers to register ( IIS2DH_REGISTER_CACHE_FIRST + n ):
+struct iis2dh_register_cache
+{
+    uint8_t wanted[IIS2DH_REGISTER_CACHE_SIZE];
+    uint8_t on_sensor[IIS2DH_REGISTER_CACHE_SIZE];
+    uint64_t known;                // on_sensor value read back or written
+    uint64_t dirty;                // wanted value not known to be on sensor
+};
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - routine prototypes
+//----------------------------------------------------------------------
+
+// Wanted values start at datasheet reset defaults, all writable registers dirty:
+void iis2dh_register_cache_init(struct iis2dh_register_cache* cache);
+
+uint32_t iis2dh_register_in_cache_range(const uint8_t register_addr);
+
+enum iis2dh_register_classes_e iis2dh_register_class(const uint8_t register_addr);
+
+const char* iis2dh_register_name(const uint8_t register_addr);
+
+uint8_t iis2dh_register_cache_wanted(const struct iis2dh_register_cache* cache, const uint8_t register_addr);
+
+void iis2dh_register_cache_set(struct iis2dh_register_cache* cache, const uint8_t register_addr, const uint8_t value);
+
+// Record value just read from or written to sensor:
+void iis2dh_register_cache_note_on_sensor(struct iis2dh_register_cache* cache, const uint8_t register_addr, const uint8_t value);
+
+// ROUTINE_OK and value when register is non-volatile and its sensor value known:
+uint32_t iis2dh_register_cache_lookup(const struct iis2dh_register_cache* cache, const uint8_t register_addr, uint8_t* value);
+
+uint32_t iis2dh_register_cache_is_dirty(const struct iis2dh_register_cache* cache, const uint8_t register_addr);
+
+// Lowest and highest dirty register within first..last, returns zero when none dirty:
+uint32_t iis2dh_register_cache_dirty_span(const struct iis2dh_register_cache* cache,
+                                          const uint8_t first,
+                                          const uint8_t last,
+                                          uint8_t* span_first,
+                                          uint8_t* span_last);
+
+
+
+#endif // _IIS2DH_REGISTER_CACHE_H
@@ -98,8 +98,11 @@ enum iis2dh_output_data_rates_e
 // IIS2DH_CTRL_REG3     (0x22)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-#define FIFO_WATERMARK_INTERRUPT_ON_INT1_ENABLE ( 1 << 1 )
-#define FIFO_OVERRUN_INTERRUPT_ON_INT1_ENABLE   ( 1 << 0 )
+// iis2dh.pdf table 29, DocID027668 Rev 2:
+// [ I1_CLICK | I1_IA1 | I1_IA2 | I1_ZYXDA | I1_321DA | I1_WTM | I1_OVERRUN |   --   ]  <-- IIS2DH_CTRL_REG3
+
+#define FIFO_WATERMARK_INTERRUPT_ON_INT1_ENABLE ( 1 << 2 )
+#define FIFO_OVERRUN_INTERRUPT_ON_INT1_ENABLE   ( 1 << 1 )
 
 
 //
@@ -116,6 +119,7 @@ enum iis2dh_output_data_rates_e
 #define ACC_FULL_SCALE_4G                       ( 1 << 4 )
 #define ACC_FULL_SCALE_8G                       ( 2 << 4 )
 #define ACC_FULL_SCALE_16G                      ( 3 << 4 )
+#define ACC_FULL_SCALE_MASK                     ( 3 << 4 )
 
 // page 16 of 49:  low power means 8-bit readings, normal power means 10-bit readings, high-resolution means 12-bit readings
 //#define ACC_OPERATING_MODE_NORMAL                    ( 0 )
@@ -128,6 +132,10 @@ enum iis2dh_output_data_rates_e
 #define ACC_OPERATING_MODE_HIGH_RES                  ( 1 )
 #endif
 
+// HR bit of CTRL_REG4, set only when operating mode above is high resolution:
+#define HIGH_RESOLUTION_ENABLE                  ( 1 << 3 )
+#define HIGH_RESOLUTION_MODE                    ( ACC_OPERATING_MODE_HIGH_RES << 3 )
+
 // Self test
 #define IIS2DH_SELF_TEST_NORMAL_MODE            ( 0 << 0 )
 #define IIS2DH_SELF_TEST_0                      ( 1 << 0 )
@@ -181,11 +189,25 @@ enum iis2dh_output_data_rates_e
 // FIFO TRIGGER THRESHHOLD IN BITS [4:0], NOT REALLY EXPLAINED IN iis2dh.pdf - TMH
 // (Can represent values from 0 to 31, number of elements the FIFO holds)
 #define FIFO_TRIGGER_THRESHHOLD                      ( 0 )
+#define FIFO_TRIGGER_THRESHHOLD_MASK              ( 0x1F )
  
 
 // IIS2DH_FIFO_SRC_REG (0x2F)
+// [   WTM  | OVRN_FIFO | EMPTY |  FSS4  |   FSS3   |   FSS2   |   FSS1   |   FSS0   ]  <-- IIS2DH_FIFO_SRC_REG
 #define FIFO_SRC_FSS_MASK                         ( 0x1F )
+#define FIFO_SOURCE_WATERMARK                   ( 1 << 7 )
 #define FIFO_SOURCE_OVERRUN                     ( 1 << 6 )
+#define FIFO_SOURCE_EMPTY                       ( 1 << 5 )
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - IIS2DH I2C sub-address
+//----------------------------------------------------------------------
+
+// Register address MSb asks IIS2DH to increment register address after
+// each byte of a multi-byte read or write, iis2dh.pdf section 6.1.1:
+#define IIS2DH_I2C_AUTO_INCREMENT               ( 0x80 )
 
 
 
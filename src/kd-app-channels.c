@@ -0,0 +1,91 @@
+/*
+ * ---------------------------------------------------------------------
+ *
+ *  @Project   Kionix Driver Demo
+ *
+ *  @File      kd-app-channels.c
+ *
+ *  @Brief     Channel definitions and `channels` CLI command showing
+ *   message traffic on each.
+ *
+ * ---------------------------------------------------------------------
+ */
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - pound includes
+//----------------------------------------------------------------------
+
+#include <stdint.h>                // to provide define of uint32_t
+#include <stdio.h>                 // to provide snprintf()
+
+#include <zephyr.h>
+
+#include "diagnostic.h"            // to provide SIZE_OF_MESSAGE_MEDIUM
+#include "kd-app-channels.h"
+#include "kd-app-config.h"
+#include "return-values.h"
+#include "thread-simple-cli.h"     // to provide printk_cli(), KD_CLI_COMMAND_DEFINE()
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - channels
+//----------------------------------------------------------------------
+
+KD_CHANNEL_DEFINE(acc_sample_block_channel, struct acc_sample_block, KD_APP_SAMPLE_BLOCK_CHANNEL_POOL_DEPTH);
+
+KD_CHANNEL_DEFINE(temperature_request_channel, struct temperature_request, 2);
+
+KD_CHANNEL_DEFINE(temperature_channel, struct temperature_reading, 2);
+
+KD_CHANNEL_DEFINE(config_change_channel, struct config_change_event, 4);
+
+static struct kd_channel* const app_channels[] =
+{
+    &acc_sample_block_channel,
+    &temperature_request_channel,
+    &temperature_channel,
+    &config_change_channel
+};
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - command handlers
+//----------------------------------------------------------------------
+
+uint32_t cli__channels(const char* args)
+{
+    char lbuf[SIZE_OF_MESSAGE_MEDIUM];
+    struct kd_channel* channel = NULL;
+    struct kd_channel_subscriber* subscriber = NULL;
+
+    for ( uint32_t i = 0; i < ARRAY_SIZE(app_channels); i++ )
+    {
+        channel = app_channels[i];
+        snprintf(lbuf, sizeof(lbuf), "\n\r%s:  %u published, %u claims refused, %u of %u messages free,\n\r",
+          channel->name, (uint32_t)atomic_get(&channel->published), (uint32_t)atomic_get(&channel->claim_failures),
+          k_mem_slab_num_free_get(channel->pool), channel->pool->num_blocks);
+        printk_cli(lbuf);
+
+        for ( uint32_t j = 0; j < KD_CHANNEL_MAX_SUBSCRIBERS; j++ )
+        {
+            subscriber = channel->subscribers[j];
+            if ( subscriber == NULL )
+                { continue; }
+            snprintf(lbuf, sizeof(lbuf), "  subscriber %s:  %u queued, %u dropped\n\r",
+              subscriber->name, k_msgq_num_used_get(subscriber->queue), (uint32_t)atomic_get(&subscriber->dropped));
+            printk_cli(lbuf);
+        }
+    }
+
+    return ROUTINE_OK;
+}
+
+KD_CLI_COMMAND_DEFINE(channels, "channels", "show publish and subscribe channel traffic", &cli__channels);
+
+
+
+// --- EOF ---
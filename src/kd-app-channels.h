@@ -0,0 +1,74 @@
+#ifndef _KD_APP_CHANNELS_H
+#define _KD_APP_CHANNELS_H
+
+/*
+ * ---------------------------------------------------------------------
+ *
+ *  @Project   Kionix Driver Demo
+ *
+ *  @File      kd-app-channels.h
+ *
+ *  @Brief     Channels this app publishes on, and their message types.
+ *   A new consumer defines a KD_CHANNEL_SUBSCRIBER_DEFINE() subscriber
+ *   and subscribes, no producer nor scoreboard changes needed.
+ *
+ * ---------------------------------------------------------------------
+ */
+
+#include <stdint.h>                // to provide define of uint32_t
+
+#include "common.h"                // to provide struct acc_reading_triplet
+#include "kd-channel.h"
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - symbols and structures to share with other modules
+//----------------------------------------------------------------------
+
+// IIS2DH FIFO depth, so one block carries at most one FIFO drain:
+#define ACC_SAMPLE_BLOCK_MAX_READINGS (32)
+
+// Readings of one FIFO block, consecutive in sequence, one timestamp:
+struct acc_sample_block
+{
+    uint32_t timestamp;            // kernel cycle count when FIFO block was read
+    uint32_t first_sequence;       // running count of readings at xyz[0]
+    uint32_t count;
+    struct acc_reading_triplet xyz[ACC_SAMPLE_BLOCK_MAX_READINGS];
+};
+
+// Ask IIS2DH thread for a temperature reading, answered on temperature_channel:
+struct temperature_request
+{
+    uint32_t timestamp;            // kernel cycle count when requested
+};
+
+struct temperature_reading
+{
+    uint32_t timestamp;            // kernel cycle count when read
+    int8_t relative_degrees_c;     // OUT_TEMP_H, per iis2dh.pdf relative to a factory reference
+};
+
+enum config_change_items
+{
+    CONFIG_ITEM_IIS2DH_ODR,
+    CONFIG_ITEM_IIS2DH_FULL_SCALE,
+    CONFIG_ITEM_DIAG_MESSAGING_LEVEL
+};
+
+struct config_change_event
+{
+    enum config_change_items item;
+    uint32_t value;
+    uint32_t version;              // scoreboard value version after change
+};
+
+extern struct kd_channel acc_sample_block_channel;
+extern struct kd_channel temperature_request_channel;
+extern struct kd_channel temperature_channel;
+extern struct kd_channel config_change_channel;
+
+
+
+#endif // _KD_APP_CHANNELS_H
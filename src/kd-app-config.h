@@ -10,6 +10,113 @@
 #define KD_APP_DEFAULT_IIS2DH_OUTPUT_DATA_RATE ODR_200_HZ
 #endif
 
+// FIFO level, in x,y,z readings triplets, at which IIS2DH raises its
+// watermark interrupt on INT1.  Valid range 1 to 31:
+#ifndef KD_APP_IIS2DH_FIFO_WATERMARK_LEVEL
+#define KD_APP_IIS2DH_FIFO_WATERMARK_LEVEL (24)
+#endif
+
+// Count of timestamped x,y,z readings held between IIS2DH thread and
+// sample consumers, must be a power of two:
+#ifndef KD_APP_IIS2DH_SAMPLE_RING_CAPACITY
+#define KD_APP_IIS2DH_SAMPLE_RING_CAPACITY (256)
+#endif
+
+// Period at which binary sample log thread checks whether logging was
+// turned on or off, while no sample blocks arrive:
+#ifndef KD_APP_SAMPLE_LOG_PERIOD_MS
+#define KD_APP_SAMPLE_LOG_PERIOD_MS (50)
+#endif
+
+// Sample blocks in flight between IIS2DH thread and all subscribers,
+// and blocks one subscriber may have waiting.  At 5376 Hz a FIFO block
+// arrives every ~4 ms, so sample log queue covers ~27 ms of stall:
+#ifndef KD_APP_SAMPLE_BLOCK_CHANNEL_POOL_DEPTH
+#define KD_APP_SAMPLE_BLOCK_CHANNEL_POOL_DEPTH (8)
+#endif
+
+#ifndef KD_APP_SAMPLE_LOG_QUEUE_DEPTH
+#define KD_APP_SAMPLE_LOG_QUEUE_DEPTH (6)
+#endif
+
+
+// Bytes of CLI output held for UART TX interrupt to send:
+#ifndef KD_APP_CLI_TX_BUFFER_SIZE
+#define KD_APP_CLI_TX_BUFFER_SIZE (1024)
+#endif
+
+// What printk_cli() does when CLI TX buffer is full, either drop bytes
+// which do not fit or wait up to KD_APP_CLI_TX_BLOCK_TIMEOUT_MS for UART
+// to make room.  Calls from interrupt context always drop:
+#define KD_CLI_TX_WHEN_FULL_DROP  (0)
+#define KD_CLI_TX_WHEN_FULL_BLOCK (1)
+
+#ifndef KD_APP_CLI_TX_WHEN_FULL
+#define KD_APP_CLI_TX_WHEN_FULL KD_CLI_TX_WHEN_FULL_BLOCK
+#endif
+
+#ifndef KD_APP_CLI_TX_BLOCK_TIMEOUT_MS
+#define KD_APP_CLI_TX_BLOCK_TIMEOUT_MS (100)
+#endif
+
+// Most CLI commands registered by KD_CLI_COMMAND_DEFINE() across all
+// modules which CLI can sort and dispatch:
+#ifndef KD_APP_CLI_COMMAND_CAPACITY
+#define KD_APP_CLI_COMMAND_CAPACITY (64)
+#endif
+
+// Bytes of RAM holding CLI command history, must be a power of two.
+// Each command stored costs its length plus two bytes:
+#ifndef KD_APP_CLI_HISTORY_BYTES
+#define KD_APP_CLI_HISTORY_BYTES (512)
+#endif
+
+
+
+// Binary host protocol frame abandoned, and CLI back to text commands,
+// when no byte of frame arrives for this long:
+#ifndef KD_APP_HOST_PROTOCOL_FRAME_TIMEOUT_MS
+#define KD_APP_HOST_PROTOCOL_FRAME_TIMEOUT_MS (250)
+#endif
+
+
+
+// Lines one DMSG() call site may send back to back, and rate at which
+// it regains them.  Lines beyond are dropped and counted:
+#ifndef KD_APP_DIAG_BURST
+#define KD_APP_DIAG_BURST (5)
+#endif
+
+#ifndef KD_APP_DIAG_LINES_PER_SECOND
+#define KD_APP_DIAG_LINES_PER_SECOND (2)
+#endif
+
+
+
+// Thread telemetry samples every KD_APP_TELEMETRY_PERIOD_MS and keeps
+// KD_APP_TELEMETRY_HISTORY samples of up to KD_APP_TELEMETRY_MAX_THREADS
+// threads.  History costs 6 bytes per thread per sample, so 12 x 10 is
+// 720 bytes, plus ~48 bytes per thread slot:
+#ifndef KD_APP_TELEMETRY_PERIOD_MS
+#define KD_APP_TELEMETRY_PERIOD_MS (1000)
+#endif
+
+#ifndef KD_APP_TELEMETRY_HISTORY
+#define KD_APP_TELEMETRY_HISTORY (12)
+#endif
+
+#ifndef KD_APP_TELEMETRY_MAX_THREADS
+#define KD_APP_TELEMETRY_MAX_THREADS (10)
+#endif
+
+
+
+// Spans held by trace point ring, must be a power of two.  Each costs
+// 12 bytes, a FIFO service cycle records about six:
+#ifndef KD_APP_TRACE_ENTRIES
+#define KD_APP_TRACE_ENTRIES (256)
+#endif
+
 
 
 #endif
@@ -0,0 +1,211 @@
+/*
+ * ---------------------------------------------------------------------
+ *
+ *  @Project   Kionix Driver Demo
+ *
+ *  @File      kd-channel.c
+ *
+ *  @Brief     Publish and subscribe channels, see kd-channel.h.
+ *
+ *  @Note      A message holds one reference per queue it sits in or
+ *   subscriber holding it, plus publisher's own until publish returns.
+ *   Publisher's reference keeps message alive while it is handed to
+ *   each subscriber, so a fast subscriber releasing early cannot free
+ *   it before slower subscribers receive it.
+ *
+ * ---------------------------------------------------------------------
+ */
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - pound includes
+//----------------------------------------------------------------------
+
+#include <stdint.h>                // to provide define of uint32_t
+
+#include <zephyr.h>
+
+#include "kd-channel.h"
+#include "return-values.h"
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - routine definitions, publisher side
+//----------------------------------------------------------------------
+
+static struct kd_channel_message_header* header_of(const void* message)
+{
+    return ( (struct kd_channel_message_header*)message - 1 );
+}
+
+
+
+void* kd_channel_claim(struct kd_channel* channel, const k_timeout_t timeout)
+{
+    struct kd_channel_message_header* header = NULL;
+
+    if ( k_mem_slab_alloc(channel->pool, (void**)&header, timeout) != 0 )
+    {
+        atomic_inc(&channel->claim_failures);
+        return NULL;
+    }
+
+    atomic_set(&header->references, 1);
+    header->channel = channel;
+
+    return ( header + 1 );
+}
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Hand one reference to claimed message to every subscriber,
+ *           then drop publisher's reference.  Message must not be
+ *           touched by publisher afterward.  Safe from ISRs.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+uint32_t kd_channel_publish(void* message)
+{
+    struct kd_channel_message_header* header = header_of(message);
+    struct kd_channel* channel = header->channel;
+    struct kd_channel_subscriber* subscriber = NULL;
+    k_spinlock_key_t key;
+
+    key = k_spin_lock(&channel->lock);
+
+    for ( uint32_t i = 0; i < KD_CHANNEL_MAX_SUBSCRIBERS; i++ )
+    {
+        subscriber = channel->subscribers[i];
+        if ( subscriber == NULL )
+            { continue; }
+
+        atomic_inc(&header->references);
+        if ( k_msgq_put(subscriber->queue, &message, K_NO_WAIT) != 0 )
+        {
+            atomic_dec(&header->references);
+            atomic_inc(&subscriber->dropped);
+        }
+    }
+
+    k_spin_unlock(&channel->lock, key);
+
+    atomic_inc(&channel->published);
+    kd_channel_release(message);
+
+    return ROUTINE_OK;
+}
+
+
+
+// Lets publishers skip filling messages nobody will read:
+uint32_t kd_channel_subscriber_count(struct kd_channel* channel)
+{
+    uint32_t count = 0;
+
+    for ( uint32_t i = 0; i < KD_CHANNEL_MAX_SUBSCRIBERS; i++ )
+    {
+        if ( channel->subscribers[i] != NULL )
+            { count++; }
+    }
+
+    return count;
+}
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - routine definitions, subscriber side
+//----------------------------------------------------------------------
+
+uint32_t kd_channel_subscribe(struct kd_channel* channel, struct kd_channel_subscriber* subscriber)
+{
+    uint32_t rstatus = KD__CHANNEL_NO_FREE_SUBSCRIBER_SLOT;
+    uint32_t free_slot = KD_CHANNEL_MAX_SUBSCRIBERS;
+    k_spinlock_key_t key;
+
+    key = k_spin_lock(&channel->lock);
+
+    for ( uint32_t i = 0; i < KD_CHANNEL_MAX_SUBSCRIBERS; i++ )
+    {
+        if ( channel->subscribers[i] == subscriber )
+        {
+            free_slot = i;
+            break;
+        }
+        if (( channel->subscribers[i] == NULL ) && ( free_slot == KD_CHANNEL_MAX_SUBSCRIBERS ))
+            { free_slot = i; }
+    }
+
+    if ( free_slot < KD_CHANNEL_MAX_SUBSCRIBERS )
+    {
+        channel->subscribers[free_slot] = subscriber;
+        rstatus = ROUTINE_OK;
+    }
+
+    k_spin_unlock(&channel->lock, key);
+
+    return rstatus;
+}
+
+
+
+// Messages still queued to subscriber are released, so none leak from pool:
+uint32_t kd_channel_unsubscribe(struct kd_channel* channel, struct kd_channel_subscriber* subscriber)
+{
+    uint32_t rstatus = KD__CHANNEL_NOT_SUBSCRIBED;
+    const void* message = NULL;
+    k_spinlock_key_t key;
+
+    key = k_spin_lock(&channel->lock);
+
+    for ( uint32_t i = 0; i < KD_CHANNEL_MAX_SUBSCRIBERS; i++ )
+    {
+        if ( channel->subscribers[i] == subscriber )
+        {
+            channel->subscribers[i] = NULL;
+            rstatus = ROUTINE_OK;
+        }
+    }
+
+    k_spin_unlock(&channel->lock, key);
+
+    while ( k_msgq_get(subscriber->queue, &message, K_NO_WAIT) == 0 )
+    {
+        kd_channel_release(message);
+    }
+
+    return rstatus;
+}
+
+
+
+uint32_t kd_channel_receive(struct kd_channel_subscriber* subscriber, const void** message, const k_timeout_t timeout)
+{
+    if ( k_msgq_get(subscriber->queue, message, timeout) != 0 )
+    {
+        *message = NULL;
+        return KD__CHANNEL_NO_MESSAGE;
+    }
+
+    return ROUTINE_OK;
+}
+
+
+
+void kd_channel_release(const void* message)
+{
+    struct kd_channel_message_header* header = header_of(message);
+
+    if ( atomic_dec(&header->references) == 1 )
+    {
+        k_mem_slab_free(header->channel->pool, (void**)&header);
+    }
+}
+
+
+
+// --- EOF ---
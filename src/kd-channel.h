@@ -0,0 +1,103 @@
+#ifndef _KD_CHANNEL_H
+#define _KD_CHANNEL_H
+
+/*
+ * ---------------------------------------------------------------------
+ *
+ *  @Project   Kionix Driver Demo
+ *
+ *  @File      kd-channel.h
+ *
+ *  @Brief     Typed publish and subscribe channels with zero-copy
+ *   delivery.  Publisher claims a message from channel's fixed pool,
+ *   fills it in place and publishes.  Each subscriber receives a
+ *   reference to that one message through its own queue, of depth
+ *   chosen per subscriber, and releases the reference when done.  Last
+ *   release returns message to pool.
+ *
+ *   Publishing never blocks:  a subscriber whose queue is full misses
+ *   that message, counted in subscriber's drop count, and other
+ *   subscribers are unaffected.
+ *
+ * ---------------------------------------------------------------------
+ */
+
+#include <stdint.h>                // to provide define of uint32_t
+
+#include <zephyr.h>                // to provide k_mem_slab, k_msgq and related
+#include <sys/atomic.h>            // to provide atomic_t
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - symbols and structures to share with other modules
+//----------------------------------------------------------------------
+
+#define KD_CHANNEL_MAX_SUBSCRIBERS (4)
+
+struct kd_channel_subscriber
+{
+    const char* name;
+    struct k_msgq* queue;          // holds references to messages, pointer sized items
+    atomic_t dropped;              // messages missed with queue full
+};
+
+struct kd_channel
+{
+    const char* name;
+    struct k_mem_slab* pool;
+    uint32_t message_size;
+    struct k_spinlock lock;        // guards subscriber table
+    struct kd_channel_subscriber* subscribers[KD_CHANNEL_MAX_SUBSCRIBERS];
+    atomic_t published;
+    atomic_t claim_failures;       // claims refused with pool empty
+};
+
+// Ahead of each message in pool block:
+struct kd_channel_message_header
+{
+    atomic_t references;
+    struct kd_channel* channel;
+} __aligned(8);
+
+
+// Statically allocate a channel carrying 'message_type', with pool of
+// 'pool_depth' messages shared by all messages in flight:
+
+#define KD_CHANNEL_DEFINE(channel_name, message_type, pool_depth) \
+K_MEM_SLAB_DEFINE(channel_name##_pool, \
+    ROUND_UP(sizeof(struct kd_channel_message_header) + sizeof(message_type), 8), (pool_depth), 8); \
+struct kd_channel channel_name = { .name = #channel_name, .pool = &channel_name##_pool, \
+    .message_size = sizeof(message_type) }
+
+// Statically allocate a subscriber able to hold 'queue_depth' messages not yet received:
+
+#define KD_CHANNEL_SUBSCRIBER_DEFINE(subscriber_name, queue_depth) \
+K_MSGQ_DEFINE(subscriber_name##_queue, sizeof(void*), (queue_depth), sizeof(void*)); \
+struct kd_channel_subscriber subscriber_name = { .name = #subscriber_name, .queue = &subscriber_name##_queue }
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - routine prototypes
+//----------------------------------------------------------------------
+
+// Publisher side:
+void* kd_channel_claim(struct kd_channel* channel, const k_timeout_t timeout);
+
+uint32_t kd_channel_publish(void* message);
+
+uint32_t kd_channel_subscriber_count(struct kd_channel* channel);
+
+// Subscriber side:
+uint32_t kd_channel_subscribe(struct kd_channel* channel, struct kd_channel_subscriber* subscriber);
+uint32_t kd_channel_unsubscribe(struct kd_channel* channel, struct kd_channel_subscriber* subscriber);
+
+uint32_t kd_channel_receive(struct kd_channel_subscriber* subscriber, const void** message, const k_timeout_t timeout);
+
+// Either side, publisher only for a claimed message it will not publish:
+void kd_channel_release(const void* message);
+
+
+
+#endif // _KD_CHANNEL_H
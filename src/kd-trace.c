@@ -0,0 +1,228 @@
+/*
+ * ---------------------------------------------------------------------
+ *
+ *  @Project   Kionix Driver Demo
+ *
+ *  @File      kd-trace.c
+ *
+ *  @Brief     Lock free ring of cycle stamped spans, see kd-trace.h.
+ *
+ *  @Note      Writers claim a slot by atomic increment of ring head,
+ *   so an interrupt landing mid-record takes the next slot rather than
+ *   waiting.  Each slot carries sequence of its claim, zeroed while
+ *   being written, so reader skips slots which are half written or
+ *   were overwritten while it read them.  nRF9160 has one core, so one
+ *   ring serves where an SMP build would want one per CPU.
+ *
+ * ---------------------------------------------------------------------
+ */
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - pound includes
+//----------------------------------------------------------------------
+
+#include <stdint.h>                // to provide define of uint32_t
+#include <stdio.h>                 // to provide snprintf()
+#include <stdlib.h>                // to provide qsort()
+
+#include <zephyr.h>
+#include <sys/atomic.h>            // to provide atomic_t and related
+
+#include "common.h"
+#include "diagnostic.h"            // to provide SIZE_OF_MESSAGE_MEDIUM
+#include "kd-app-config.h"
+#include "return-values.h"
+#include "kd-trace.h"
+#include "thread-simple-cli.h"     // to provide printk_cli(), KD_CLI_COMMAND_DEFINE()
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - pound defines
+//----------------------------------------------------------------------
+
+#if ( KD_APP_TRACE_ENTRIES & ( KD_APP_TRACE_ENTRIES - 1 ) ) != 0
+#error "KD_APP_TRACE_ENTRIES must be a power of two"
+#endif
+
+#define TRACE_ENTRY_MASK (KD_APP_TRACE_ENTRIES - 1)
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - file scoped variables
+//----------------------------------------------------------------------
+
+struct kd_trace_entry
+{
+    volatile uint32_t sequence;    // claim count plus one once written, zero while writing
+    uint32_t cycles;
+    uint8_t span;
+};
+
+static struct kd_trace_entry trace_ring[KD_APP_TRACE_ENTRIES];
+static atomic_t trace_head = ATOMIC_INIT(0);
+static atomic_t trace_floor = ATOMIC_INIT(0);
+
+// Spans within FIFO service show their share of its time.  With
+// asynchronous FIFO drain, unpack and publish of previous block run
+// while drain is in flight, so shares can sum past 100%:
+static const struct
+{
+    const char* name;
+    uint32_t within_fifo_service;
+} span_names[KD_TRACE_SPAN_COUNT] =
+{
+    [KD_TRACE_SPAN__FIFO_SERVICE]   = { "fifo service",   0 },
+    [KD_TRACE_SPAN__FIFO_SOURCE]    = { "fifo source",    1 },
+    [KD_TRACE_SPAN__FIFO_DRAIN]     = { "fifo drain",     1 },
+    [KD_TRACE_SPAN__UNPACK]         = { "unpack",         1 },
+    [KD_TRACE_SPAN__MILLI_G]        = { "milli-g",        1 },
+    [KD_TRACE_SPAN__PUBLISH]        = { "publish",        1 },
+    [KD_TRACE_SPAN__REGISTER_WRITE] = { "register write", 0 }
+};
+
+// CLI thread only, too large for its stack:
+static uint32_t span_cycles[KD_APP_TRACE_ENTRIES];
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - routine definitions
+//----------------------------------------------------------------------
+
+void kd_trace_record(const enum kd_trace_spans span, const uint32_t cycles)
+{
+    const uint32_t claim = (uint32_t)atomic_inc(&trace_head);
+    struct kd_trace_entry* entry = &trace_ring[( claim & TRACE_ENTRY_MASK )];
+
+    entry->sequence = 0;
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    entry->cycles = cycles;
+    entry->span = (uint8_t)span;
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    entry->sequence = ( claim + 1 );
+}
+
+
+
+void kd_trace_clear(void)
+{
+    atomic_set(&trace_floor, atomic_get(&trace_head));
+}
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Copy cycle counts of one span from ring into span_cycles[],
+ *           returning how many.  Slots written during copy drop out.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+static uint32_t collect_span(const enum kd_trace_spans span, uint64_t* total_cycles)
+{
+    const uint32_t head = (uint32_t)atomic_get(&trace_head);
+    uint32_t held = ( head - (uint32_t)atomic_get(&trace_floor) );
+    uint32_t count = 0;
+
+    held = MIN(held, KD_APP_TRACE_ENTRIES);
+    *total_cycles = 0;
+
+    for ( uint32_t claim = ( head - held ); claim != head; claim++ )
+    {
+        const struct kd_trace_entry* entry = &trace_ring[( claim & TRACE_ENTRY_MASK )];
+        const uint32_t sequence = entry->sequence;
+        uint32_t cycles = 0;
+        uint8_t entry_span = 0;
+
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        cycles = entry->cycles;
+        entry_span = entry->span;
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+        if (( sequence != ( claim + 1 ) ) || ( entry->sequence != sequence ) || ( entry_span != span ))
+            { continue; }
+
+        span_cycles[count++] = cycles;
+        *total_cycles += cycles;
+    }
+
+    return count;
+}
+
+
+
+static int compare_cycles(const void* a, const void* b)
+{
+    const uint32_t left = *(const uint32_t*)a;
+    const uint32_t right = *(const uint32_t*)b;
+
+    return ( left > right ) - ( left < right );
+}
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   `trace` shows count, p50, p99, max and total microseconds
+ *           of each span held in ring, `trace clear` starts afresh.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+uint32_t cli__trace(const char* args)
+{
+    char lbuf[SIZE_OF_MESSAGE_MEDIUM];
+    uint64_t total_cycles = 0;
+    uint64_t service_cycles = 0;
+    uint32_t count = 0;
+
+    if (( argument_count_from_cli_module() == 1 ) && ( arg_compare(0, "clear") == 0 ))
+    {
+        kd_trace_clear();
+        printk_cli("\n\rtrace cleared\n\r");
+        return ROUTINE_OK;
+    }
+
+#if KD_DEV__TRACE_POINTS_ENABLED != 1
+    printk_cli("\n\rtrace points compiled out, see KD_DEV__TRACE_POINTS_ENABLED\n\r");
+#endif
+
+    collect_span(KD_TRACE_SPAN__FIFO_SERVICE, &service_cycles);
+
+    printk_cli("\n\r   span              count    p50 us    p99 us    max us    total us   of fifo service\n\r");
+
+    for ( uint32_t span = 0; span < KD_TRACE_SPAN_COUNT; span++ )
+    {
+        count = collect_span(span, &total_cycles);
+        if ( count == 0 )
+            { continue; }
+
+        qsort(span_cycles, count, sizeof(span_cycles[0]), compare_cycles);
+
+        snprintf(lbuf, sizeof(lbuf), "   %-16s %6u  %8u  %8u  %8u  %10u",
+          span_names[span].name, count,
+          k_cyc_to_us_floor32(span_cycles[( ( count - 1 ) * 50 ) / 100]),
+          k_cyc_to_us_floor32(span_cycles[( ( count - 1 ) * 99 ) / 100]),
+          k_cyc_to_us_floor32(span_cycles[( count - 1 )]),
+          (uint32_t)k_cyc_to_us_floor64(total_cycles));
+        printk_cli(lbuf);
+
+        if ( span_names[span].within_fifo_service && ( service_cycles > 0 ) )
+        {
+            snprintf(lbuf, sizeof(lbuf), "   %3u%%", (uint32_t)( ( total_cycles * 100 ) / service_cycles ));
+            printk_cli(lbuf);
+        }
+        printk_cli("\n\r");
+    }
+
+    return ROUTINE_OK;
+}
+
+KD_CLI_COMMAND_DEFINE(trace, "trace", "p50, p99 and max of traced spans, `trace clear` starts afresh", &cli__trace);
+
+
+
+// --- EOF ---
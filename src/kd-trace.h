@@ -0,0 +1,78 @@
+#ifndef _KD_TRACE_H
+#define _KD_TRACE_H
+
+/*
+ * ---------------------------------------------------------------------
+ *
+ *  @Project   Kionix Driver Demo
+ *
+ *  @File      kd-trace.h
+ *
+ *  @Brief     Cycle stamped trace points.  KD_TRACE_BEGIN(span) and
+ *   KD_TRACE_END(span) bracket a stretch of code and record its length
+ *   in k_cycle_get_32() cycles into a lock free ring, safe to call from
+ *   threads and interrupts alike.  CLI `trace` shows p50, p99 and max
+ *   of each span over what ring holds.
+ *
+ *   Begin and end must sit in same scope, and every return between
+ *   them needs its own KD_TRACE_END():
+ *
+ *     KD_TRACE_BEGIN(UNPACK);
+ *     unpack_readings_block(buffer, count);
+ *     KD_TRACE_END(UNPACK);
+ *
+ * ---------------------------------------------------------------------
+ */
+
+#include <stdint.h>                // to provide define of uint32_t
+
+#include <kernel.h>                // to provide k_cycle_get_32()
+
+#include "development-flags.h"
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - symbols and structures to share with other modules
+//----------------------------------------------------------------------
+
+// Name of each span added here needs an entry in kd-trace.c span_names[]:
+enum kd_trace_spans
+{
+    KD_TRACE_SPAN__FIFO_SERVICE,   // whole IIS2DH FIFO service cycle
+    KD_TRACE_SPAN__FIFO_SOURCE,    // read of FIFO_SRC_REG
+    KD_TRACE_SPAN__FIFO_DRAIN,     // I2C read of buffered readings
+    KD_TRACE_SPAN__UNPACK,         // raw bytes to reading triplets
+    KD_TRACE_SPAN__MILLI_G,        // triplets to milli-g
+    KD_TRACE_SPAN__PUBLISH,        // sample ring and sample block channel
+    KD_TRACE_SPAN__REGISTER_WRITE, // IIS2DH register block write
+    KD_TRACE_SPAN_COUNT
+};
+
+#if KD_DEV__TRACE_POINTS_ENABLED == 1
+#define KD_TRACE_BEGIN(span) \
+    const uint32_t kd_trace_begin__##span = k_cycle_get_32()
+
+#define KD_TRACE_END(span) \
+    kd_trace_record(KD_TRACE_SPAN__##span, ( k_cycle_get_32() - kd_trace_begin__##span ))
+#else
+#define KD_TRACE_BEGIN(span)
+#define KD_TRACE_END(span)
+#endif
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - routine prototypes
+//----------------------------------------------------------------------
+
+void kd_trace_record(const enum kd_trace_spans span, const uint32_t cycles);
+
+// Forget spans recorded so far, CLI `trace clear`:
+void kd_trace_clear(void);
+
+uint32_t cli__trace(const char* args);
+
+
+
+#endif // _KD_TRACE_H
@@ -74,6 +74,8 @@ LOG_MODULE_REGISTER(demo);
 #include "thread-lis2dh.h"
 #include "thread-simple-cli.h"
 #include "thread-led.h"
+#include "thread-sample-log.h"
+#include "thread-telemetry.h"
 
 #include "scoreboard.h"
 
@@ -184,6 +186,9 @@ void main(void)
     memset(banner_msg, 0, sizeof(banner_msg));
     banner("main");
 
+// Scoreboard work queue must run before threads post flag events:
+    rstatus = initialize_scoreboard();
+
     const struct device *dev_accelerometer = device_get_binding(DT_LABEL(KIONIX_ACCELEROMETER));
     struct sensor_value value;
     union generic_data_four_bytes_union_t data_from_sensor;
@@ -192,12 +197,9 @@ void main(void)
 
     if (dev_accelerometer == NULL)
     {
-        dmsg("-\n- WARNING - Failed to init Kionix sensor device pointer!\n-\n",
-          PROJECT_DIAG_LEVEL);
-        snprintf(lbuf, DEFAULT_MESSAGE_SIZE,
-          "-\n- INFO - Zephyr macros '(DT_LABEL(KIONIX_ACCELEROMETER))' expand to value '%s'\n-\n",
+        DMSG(MAIN, KD_DIAG_WARNINGS, "Failed to init Kionix sensor device pointer!");
+        DMSG(MAIN, KD_DIAG_INFO, "Zephyr macros '(DT_LABEL(KIONIX_ACCELEROMETER))' expand to value '%s'",
           (DT_LABEL(KIONIX_ACCELEROMETER)));
-        dmsg(lbuf, PROJECT_DIAG_LEVEL);
 //        dmsg("firmware exiting early, done.\n\n", PROJECT_DIAG_LEVEL);
 //        return;
     }
@@ -206,14 +208,13 @@ void main(void)
 #if 1
         if (!device_is_ready(dev_accelerometer))
         {
-            snprintf(lbuf, sizeof(lbuf), "Device %s is not ready\n", dev_accelerometer->name);
-            dmsg(lbuf, PROJECT_DIAG_LEVEL);
+            DMSG(MAIN, KD_DIAG_ERRORS, "Device %s is not ready", dev_accelerometer->name);
             return;
         }
         else
 #endif
         {
-            dmsg("- SUCCESS - found Kionix accelerometer and device is ready\n", PROJECT_DIAG_LEVEL);
+            DMSG(MAIN, KD_DIAG_INFO, "found Kionix accelerometer and device is ready");
         }
     }
 
@@ -293,6 +294,13 @@ void main(void)
     }
 #endif
 
+#if NN_DEV__ENABLE_THREAD_SAMPLE_LOG == 1
+    {
+        dmsg("- DEV - starting binary sample log thread . . .\n", DIAG_NORMAL);
+        thread_set_up_status = initialize_thread_sample_log();
+    }
+#endif
+
 #if NN_DEV__ENABLE_THREAD_LIS2DH_SENSOR == 1
     {
         dmsg("- DEV - starting comparative LIS2DH test thread . . .\n", DIAG_NORMAL);
@@ -307,6 +315,13 @@ void main(void)
     }
 #endif
 
+#if NN_DEV__ENABLE_THREAD_TELEMETRY == 1
+    {
+        dmsg("- DEV - starting thread telemetry sampler . . .\n", DIAG_NORMAL);
+        thread_set_up_status = initialize_thread_telemetry();
+    }
+#endif
+
 
     while ( 1 )
     {
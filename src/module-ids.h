@@ -3,9 +3,41 @@
 
 
 
+#define MODULE_ID__MAIN                "kd_main"
 #define MODULE_ID__THREAD_IIS2DH       "kd_thread_iis2dh"
 #define MODULE_ID__THREAD_SIMPLE_CLI   "kd_thread_cli"
 #define MODULE_ID__THREAD_LED          "kd_thread_led"
+#define MODULE_ID__THREAD_SAMPLE_LOG   "kd_thread_sample_log"
+#define MODULE_ID__SCOREBOARD_WORK_Q   "kd_scoreboard_work_q"
+
+
+
+// Diagnostic levels compiled in, per module, see DMSG() in diagnostic.h.
+// Override at build time to trade flash for detail in one module:
+
+#ifndef MODULE_DIAG_LEVEL__MAIN
+#define MODULE_DIAG_LEVEL__MAIN                DIAG_VERBOSE
+#endif
+
+#ifndef MODULE_DIAG_LEVEL__THREAD_IIS2DH
+#define MODULE_DIAG_LEVEL__THREAD_IIS2DH       DIAG_NORMAL
+#endif
+
+#ifndef MODULE_DIAG_LEVEL__THREAD_SIMPLE_CLI
+#define MODULE_DIAG_LEVEL__THREAD_SIMPLE_CLI   DIAG_NORMAL
+#endif
+
+#ifndef MODULE_DIAG_LEVEL__THREAD_LED
+#define MODULE_DIAG_LEVEL__THREAD_LED          DIAG_MINIMAL
+#endif
+
+#ifndef MODULE_DIAG_LEVEL__THREAD_SAMPLE_LOG
+#define MODULE_DIAG_LEVEL__THREAD_SAMPLE_LOG   DIAG_NORMAL
+#endif
+
+#ifndef MODULE_DIAG_LEVEL__SCOREBOARD_WORK_Q
+#define MODULE_DIAG_LEVEL__SCOREBOARD_WORK_Q   DIAG_NORMAL
+#endif
 
 
 
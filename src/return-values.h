@@ -17,9 +17,45 @@ enum kd_return_values
 // Zephyr device handle related:
     KD__DEVICE_POINTER_NULL,
 
+// IIS2DH interrupt line related:
+    KD__IIS2DH_INT1_GPIO_NOT_IN_DEVICETREE,
+    KD__IIS2DH_INT1_GPIO_PORT_NOT_READY,
+    KD__IIS2DH_INT1_GPIO_CONFIG_FAILED,
+
+// IIS2DH FIFO drain related:
+    KD__IIS2DH_FIFO_DRAIN_FAILED,
+    KD__IIS2DH_FIFO_DRAIN_TIMEOUT,
+    KD__IIS2DH_FIFO_DRAIN_BUSY,
+
+// Sample ring related:
+    KD__SAMPLE_RING_NO_FREE_READER_SLOTS,
+    KD__SAMPLE_RING_INVALID_READER,
+
+// IIS2DH register cache related:
+    KD__IIS2DH_REGISTER_CACHE_MISS,
+
+// CLI UART related:
+    KD__CLI_TX_BYTES_DROPPED,
+    KD__CLI_HISTORY_ENTRY_TOO_LONG,
+    KD__CLI_HISTORY_NO_SUCH_ENTRY,
+    KD__HOST_PROTOCOL_BAD_FRAME,
+    KD__HOST_PROTOCOL_FRAME_TOO_LONG,
+    KD__CHANNEL_NO_FREE_SUBSCRIBER_SLOT,
+    KD__CHANNEL_NOT_SUBSCRIBED,
+    KD__CHANNEL_NO_MESSAGE,
+    KD__CHANNEL_POOL_EMPTY,
+
+// Readings conversion related:
+    KD__CONVERSION_UNSUPPORTED_RESOLUTION,
+
 // Scoreboard related:
     KD__SB_SCOREBOARD_INITIALIZED,
     KD__SB_SCOREBOARD_INVALID_BOOLEAN_FLAG_VALUE,
+    KD__SB_SCOREBOARD_INVALID_FLAG,
+
+// Thread telemetry related:
+    KD__TELEMETRY_NO_SUCH_SLOT,
+    KD__TELEMETRY_SLOT_EMPTY,
 
     LAST_ITEM_IN_RETURN_VALUES_ENUM
 };
@@ -29,6 +65,8 @@ enum kd_return_values
 // To aid in documentating tests in app sources:
 #define RESULT_ARG_IS_DECIMAL 0
 #define RESULT_ARG_NOT_DECIMAL 1
+#define RESULT_ARG_IS_HEX 0
+#define RESULT_ARG_NOT_HEX 1
 
 
 
@@ -0,0 +1,234 @@
+/*
+ * ---------------------------------------------------------------------
+ *
+ *  @Project   Kionix Driver Demo
+ *
+ *  @File      sample-ring.c
+ *
+ *  @Brief     Lock-free ring of timestamped raw accelerometer readings,
+ *   single producer and one or more independently paced readers.
+ *
+ *  @Note      Indices are free running 32-bit counters.  Their
+ *   difference gives fill level even after they wrap, and masking
+ *   with (capacity - 1) gives array position.  Producer only ever
+ *   writes 'head', each reader only ever writes its own 'tails[n]'.
+ *   Producer never looks at reader indices:  it always writes, and a
+ *   reader more than (capacity - 1) behind finds its oldest records
+ *   overwritten, or being overwritten by next push.  Such a reader
+ *   skips ahead on its next pull and counts readings it lost, so one
+ *   idle reader costs no other reader anything.
+ *   Zephyr atomic_set() and atomic_get() carry full memory barriers,
+ *   so a record copied in before 'head' advances is visible to any
+ *   reader which sees the new 'head'.
+ *
+ * ---------------------------------------------------------------------
+ */
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - pound includes
+//----------------------------------------------------------------------
+
+#include <stdint.h>                // to provide define of uint32_t
+
+#include <zephyr.h>                // to provide BUILD_ASSERT() and related
+
+#include "sample-ring.h"
+#include "return-values.h"
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - routine definitions, producer side
+//----------------------------------------------------------------------
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Copy one record into ring, overwriting oldest record when
+ *           ring is full.  Never blocks and never fails.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+uint32_t sample_ring_push(struct sample_ring* ring, const struct acc_sample_record* record)
+{
+    uint32_t head = (uint32_t)atomic_get(&ring->head);
+
+    ring->records[( head & ( ring->capacity - 1 ) )] = *record;
+    atomic_set(&ring->head, (atomic_val_t)( head + 1 ));
+
+    return ROUTINE_OK;
+}
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - routine definitions, consumer side
+//----------------------------------------------------------------------
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Claim a reader slot.  New reader starts at present head,
+ *           so sees only readings pushed after it attaches.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+uint32_t sample_ring_attach_reader(struct sample_ring* ring, uint32_t* reader_id)
+{
+    uint32_t i = 0;
+
+    for ( i = 0; i < SAMPLE_RING_MAX_READERS; i++ )
+    {
+        if ( atomic_test_and_set_bit(&ring->readers_attached, i) == false )
+        {
+// Slot is ours alone from here, producer never reads tails:
+            atomic_set(&ring->tails[i], atomic_get(&ring->head));
+            atomic_clear(&ring->reader_overflows[i]);
+            *reader_id = i;
+            return ROUTINE_OK;
+        }
+    }
+
+    return KD__SAMPLE_RING_NO_FREE_READER_SLOTS;
+}
+
+
+
+uint32_t sample_ring_detach_reader(struct sample_ring* ring, const uint32_t reader_id)
+{
+    if ( reader_id >= SAMPLE_RING_MAX_READERS )
+        { return KD__SAMPLE_RING_INVALID_READER; }
+
+    atomic_clear_bit(&ring->readers_attached, reader_id);
+    return ROUTINE_OK;
+}
+
+
+
+// Records a pull would return, at most SAMPLE_RING_READABLE() for a lapped reader:
+uint32_t sample_ring_count_available(struct sample_ring* ring, const uint32_t reader_id)
+{
+    uint32_t count = 0;
+
+    if ( reader_id >= SAMPLE_RING_MAX_READERS )
+        { return 0; }
+
+    count = ( (uint32_t)atomic_get(&ring->head) - (uint32_t)atomic_get(&ring->tails[reader_id]) );
+    return MIN(count, SAMPLE_RING_READABLE(ring));
+}
+
+
+
+// Move a lapped reader's tail up to oldest record producer cannot be
+// overwriting, and count what it lost.  Returns tail to read from:
+
+static uint32_t skip_overwritten_records(struct sample_ring* ring,
+                                         const uint32_t reader_id,
+                                         const uint32_t head,
+                                         const uint32_t tail)
+{
+    uint32_t lost = 0;
+
+    if ( ( head - tail ) <= SAMPLE_RING_READABLE(ring) )
+        { return tail; }
+
+    lost = ( ( head - tail ) - SAMPLE_RING_READABLE(ring) );
+    atomic_add(&ring->reader_overflows[reader_id], (atomic_val_t)lost);
+    atomic_add(&ring->overflow_count, (atomic_val_t)lost);
+
+    return ( head - SAMPLE_RING_READABLE(ring) );
+}
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Copy up to max_records oldest unread records to caller's
+ *           buffer, and advance this reader's index past them.  Never
+ *           blocks, count_pulled may be zero.
+ *
+ *  @Note    A reader which fell too far behind resumes at oldest
+ *           record producer cannot be overwriting.  Producer may also lap reader
+ *           while records are being copied, so head is read again
+ *           after copy, and any record whose slot producer may since
+ *           have begun to overwrite is dropped from front of returned
+ *           records and counted as lost.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+uint32_t sample_ring_pull(struct sample_ring* ring,
+                          const uint32_t reader_id,
+                          struct acc_sample_record* records_to_return,
+                          const uint32_t max_records,
+                          uint32_t* count_pulled)
+{
+    uint32_t head = 0;
+    uint32_t tail = 0;
+    uint32_t count = 0;
+    uint32_t oldest_intact = 0;
+    uint32_t torn = 0;
+    uint32_t i = 0;
+
+    *count_pulled = 0;
+
+    if ( reader_id >= SAMPLE_RING_MAX_READERS )
+        { return KD__SAMPLE_RING_INVALID_READER; }
+
+    head = (uint32_t)atomic_get(&ring->head);
+    tail = skip_overwritten_records(ring, reader_id, head,
+      (uint32_t)atomic_get(&ring->tails[reader_id]));
+
+    count = ( head - tail );
+    if ( count > max_records )
+        { count = max_records; }
+
+    for ( i = 0; i < count; i++ )
+    {
+        records_to_return[i] = ring->records[( ( tail + i ) & ( ring->capacity - 1 ) )];
+    }
+
+// Producer writing record 'head' overwrites record 'head - capacity':
+    head = (uint32_t)atomic_get(&ring->head);
+    oldest_intact = ( head + 1 - ring->capacity );
+
+    if ( (int32_t)( oldest_intact - tail ) > 0 )
+    {
+        torn = MIN(( oldest_intact - tail ), count);
+        atomic_add(&ring->reader_overflows[reader_id], (atomic_val_t)torn);
+        atomic_add(&ring->overflow_count, (atomic_val_t)torn);
+
+        for ( i = torn; i < count; i++ )
+            { records_to_return[( i - torn )] = records_to_return[i]; }
+
+        count -= torn;
+        tail += torn;
+    }
+
+    atomic_set(&ring->tails[reader_id], (atomic_val_t)( tail + count ));
+    *count_pulled = count;
+
+    return ROUTINE_OK;
+}
+
+
+
+// Readings lost by all readers together, since ring was defined:
+uint32_t sample_ring_overflow_count(struct sample_ring* ring)
+{
+    return (uint32_t)atomic_get(&ring->overflow_count);
+}
+
+
+
+// Readings this reader lost to being lapped, since it attached:
+uint32_t sample_ring_reader_overflow_count(struct sample_ring* ring, const uint32_t reader_id)
+{
+    if ( reader_id >= SAMPLE_RING_MAX_READERS )
+        { return 0; }
+
+    return (uint32_t)atomic_get(&ring->reader_overflows[reader_id]);
+}
+
+
+
+// --- EOF ---
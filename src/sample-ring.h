@@ -0,0 +1,96 @@
+#ifndef _SAMPLE_RING_H
+#define _SAMPLE_RING_H
+
+/*
+ * ---------------------------------------------------------------------
+ *
+ *  @Project   Kionix Driver Demo
+ *
+ *  @File      sample-ring.h
+ *
+ *  @Brief     Lock-free ring of timestamped raw x,y,z readings.  One
+ *   producer (a sensor thread) pushes readings, and up to
+ *   SAMPLE_RING_MAX_READERS consumers each pull at their own pace
+ *   through a private read index.  Producer never blocks and never
+ *   waits on readers:  it overwrites oldest readings, and a reader
+ *   which falls too far behind skips ahead on its next pull,
+ *   counting readings it lost as its own overflows.  A reader can
+ *   hold up to (capacity - 1) unread readings.
+ *
+ * ---------------------------------------------------------------------
+ */
+
+#include <stdint.h>                // to provide define of uint32_t
+
+#include <sys/atomic.h>            // to provide atomic_t and atomic_get(), atomic_set()
+
+#include "common.h"                // to provide struct acc_reading_triplet
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - symbols and structures to share with other modules
+//----------------------------------------------------------------------
+
+#define SAMPLE_RING_MAX_READERS (4)
+
+struct acc_sample_record
+{
+    uint32_t timestamp;            // kernel cycle count when FIFO block was read
+    uint32_t sequence;             // running count of readings since acquisition start
+    struct acc_reading_triplet xyz;  // raw two's complement readings, as read from sensor
+};
+
+struct sample_ring
+{
+    struct acc_sample_record* records;
+    uint32_t capacity;                            // power of two
+    atomic_t head;                                // free running write index, producer owned
+    atomic_t tails[SAMPLE_RING_MAX_READERS];      // free running read indices, one per reader
+    atomic_t readers_attached;                    // bit-wise, one bit per reader slot
+    atomic_t reader_overflows[SAMPLE_RING_MAX_READERS];  // readings each reader lost to being lapped
+    atomic_t overflow_count;                      // readings lost, all readers together
+};
+
+
+// Unread records a reader may hold.  Slot past them is the one
+// producer overwrites next, so is never handed to a reader:
+
+#define SAMPLE_RING_READABLE(ring) ((ring)->capacity - 1)
+
+
+// Statically allocate a ring and its record storage.  Capacity must be
+// a power of two so that free running indices wrap with a mask:
+
+#define SAMPLE_RING_DEFINE(name, ring_capacity) \
+BUILD_ASSERT(((ring_capacity) & ((ring_capacity) - 1)) == 0, "sample ring capacity must be power of two"); \
+static struct acc_sample_record name##_records[(ring_capacity)]; \
+struct sample_ring name = { .records = name##_records, .capacity = (ring_capacity) }
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - routine prototypes
+//----------------------------------------------------------------------
+
+// Producer side:
+uint32_t sample_ring_push(struct sample_ring* ring, const struct acc_sample_record* record);
+
+// Consumer side:
+uint32_t sample_ring_attach_reader(struct sample_ring* ring, uint32_t* reader_id);
+uint32_t sample_ring_detach_reader(struct sample_ring* ring, const uint32_t reader_id);
+
+uint32_t sample_ring_pull(struct sample_ring* ring,
+                          const uint32_t reader_id,
+                          struct acc_sample_record* records_to_return,
+                          const uint32_t max_records,
+                          uint32_t* count_pulled);
+
+uint32_t sample_ring_count_available(struct sample_ring* ring, const uint32_t reader_id);
+
+uint32_t sample_ring_overflow_count(struct sample_ring* ring);
+uint32_t sample_ring_reader_overflow_count(struct sample_ring* ring, const uint32_t reader_id);
+
+
+
+#endif // _SAMPLE_RING_H
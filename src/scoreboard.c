@@ -10,15 +10,16 @@
  *   facilities include:
  *
  *   +  setter and getter pairs of routines for integer, float and
- *      string values.
+ *      string values.  Setters of configuration values publish each
+ *      change on config change channel, see kd-app-channels.h.
  *
- *   +  table of Boolean flags and associated pointers to optional.
- *      callback routines.
+ *   +  Boolean flags held as bits of one atomic word, with a wait
+ *      routine for threads to block until given flags are set.
  *
  *   +  Boolean flag update routines to set, clear supported flags.
  *
- *   +  callback orchestrator which flag updaters optionally call
- *      to execute callbacks associated with flag set and clear events.
+ *   +  table of pointers to optional callback routines, which a
+ *      scoreboard work queue runs after flag set and clear events.
  *
  * ---------------------------------------------------------------------
  */
@@ -49,7 +50,10 @@
  */
 
 #include <stdint.h>                // to provide define of uint32_t
+#include <string.h>                // to provide memcpy()
 
+#include <zephyr.h>
+#include <sys/atomic.h>            // to provide atomic_t and related
 #include <sys/printk.h>            // to provide printk() function
 
 
@@ -61,14 +65,23 @@
 
 // Internals:
 #include "common.h"
+#include "module-ids.h"
 #include "return-values.h"
 #include "routine-options.h"
 
 // Specific modules this scoreboard modules needs know about:
+#include "kd-app-channels.h"
 #include "main.h"
-#include "thread-iis2dh.h"
 
-//extern uint32_t on_event__temperature_readings_requested__query_iis2dh(uint32_t event);
+
+
+//----------------------------------------------------------------------
+// - SECION - pound defines
+//----------------------------------------------------------------------
+
+#define SCOREBOARD_WORK_Q_STACK_SIZE 1024
+// Below sensor and CLI threads, so flag callbacks never preempt sensor reads:
+#define SCOREBOARD_WORK_Q_PRIORITY 9
 
 
 
@@ -76,13 +89,18 @@
 // - SECION - scoreboard scoped variables used by setters and getters
 //----------------------------------------------------------------------
 
-static enum nn_diagnostic_levels global_diag_messaging_level = DIAG_NORMAL;
+// Values shared between threads are declared with SCOREBOARD_VALUE_DEFINE(),
+// see scoreboard.h.  Readers never block writers nor each other:
 
-//static enum iis2dh_output_data_rates_e user_iis2dh_output_data_rate = ODR_100_HZ;
+static struct k_spinlock scoreboard_value_write_lock;
+
+SCOREBOARD_VALUE_DEFINE(diag_messaging_level, enum nn_diagnostic_levels, DIAG_NORMAL);
+
+SCOREBOARD_VALUE_DEFINE(requested_iis2dh_odr, enum iis2dh_output_data_rates_e, ODR_0_POWERED_DOWN);
 
 // Note up to calling modules to assure valid bit configurations are
 // posted to this scoreboard variable:
-static uint8_t iis2dh_full_scale_selection = 0;
+SCOREBOARD_VALUE_DEFINE(iis2dh_full_scale_selection, uint8_t, 0);
 
 
 
@@ -99,54 +117,33 @@ static uint8_t iis2dh_full_scale_selection = 0;
 //     firmware project.
 
 
+// (2)  Flags are bits of one atomic word, bit number being flag's
+// position in enumeration of supported flags.  Any thread or ISR may
+// set, clear and read flags without locks.  A Zephyr event object
+// mirrors the word, so consumer threads can block on any or all of a
+// set of flags with scoreboard__wait_for_flags().  Mirroring takes no
+// lock; each updater re-publishes until event object holds the current
+// word, so k_event_set() never runs with interrupts locked:
 
-//
-// (2)  Following struct contains two integers each of which are used as
-// bit-wise flags to support indications toward up to 32 callback
-// functions to exercise when given project-implemented flag is either
-// set or unset.  A scoreboard routine named handle_flag_events
-// checks a table of flag_callbacks structures and invokes (calls)
-// any callback routines which are indicated for the given flag's
-// reported event.
-//
-// Each project implemented flag here in this part of the scoreboard
-// gets one of these 'callback present indicator' types.  Upshot:  a
-// flag undergoing set or clear events can potentially trigger many
-// callback routines to run:
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+BUILD_ASSERT(COUNT_FLAGS_SUPPORTED <= 32, "scoreboard flags must fit one atomic word");
 
-struct flag_and_callback_indicators
-{
-    uint32_t flag;                                     // A numeric ID for each supported flag
-    uint32_t callbacks_0_to_31_enabled_when_set;       // list of callbacks to run when flag set
-    uint32_t callbacks_0_to_31_enabled_when_cleared;   // list of callbacks to run when flag cleared
-};
-
-typedef struct flag_and_callback_indicators flag_and_callback_indicators_t;
-
-// REF https://stackoverflow.com/questions/10468128/how-do-you-make-an-array-of-structs-in-c
+static atomic_t scoreboard_flags = ATOMIC_INIT(0);
 
-#if 0 // following is exampmle code which fails build when in .h file, confirming our structs need to be in .c file:
-struct body
-{
-    double p;
-};
+K_EVENT_DEFINE(scoreboard_flag_events);
 
-struct body bodies[3];
-#endif
 
+// (3)  Callbacks run on scoreboard's own work queue, never on thread
+// which updates a flag.  Updaters record flag events in two pending
+// bitmaps and submit one work item, which runs callbacks of all
+// events pending.  Two events of same kind on one flag before work
+// item runs result in one callback run:
 
-// (3)  An array to serve as a table of flag callback indicators, which
-// are themselves bit-wise flags.  A Boolean flag can be set or unset,
-// a standard C integer has 32-bits, so for this first draft "flags
-// callbacks" implementation a flag can have up to 32 callback functions
-// for case where given flag is set, and from zero to 32 callback
-// functions for case where flag is cleared.  Note these callback
-// function pointers are shared among supported flags.  If more than
-// 32 callbacks are needed, additional integer members can be added to
-// the flag_callbacks struct.
+static atomic_t flags_pending_set_callback = ATOMIC_INIT(0);
+static atomic_t flags_pending_clear_callback = ATOMIC_INIT(0);
 
-flag_and_callback_indicators_t table_of_flags[COUNT_FLAGS_SUPPORTED];
+K_THREAD_STACK_DEFINE(scoreboard_work_q_stack_area, SCOREBOARD_WORK_Q_STACK_SIZE);
+static struct k_work_q scoreboard_work_q;
+static struct k_work flag_callbacks_work;
 
 
 // (4)  A function pointer definition and an array of function
@@ -210,9 +207,9 @@ static flag_callback_t table_of_callbacks_for_flag_clear[COUNT_CALLBACKS_SUPPORT
 
 
 
-// (5)  Routine to check for and execute callbacks:
+// (5)  Work handler to check for and execute callbacks:
 
-uint32_t handle_flag_callbacks(enum kionix_driver_demo_supported_flags_e flag, enum flag_event_e event);
+static void handle_flag_callbacks(struct k_work* work);
 
 // --- 1103-B DEV END ---
 
@@ -225,7 +222,6 @@ char* flag_descriptions[COUNT_FLAGS_SUPPORTED] =
 {
     "flag accelerometer readings set ready\0",
     "flag FIFO overrun in latest readings set\0",
-    "flag temperature readings requested\0",
     "\0"
 };
 
@@ -241,19 +237,11 @@ void assign_function_callback_pointers(void)
 // (1)
 // Assign the function pointer for event when readings sets are completely gathered and stored:
     table_of_callbacks_for_flag_set[RS__ACCELEROMETER_READINGS_SET_COMPLETE] = NULL;
-// Connect scoreboard flag for this event to above callback:
-// ( NOTE these bit flags implemented but not yet checked by callback orchestrating routine in first draft scoreboard - TMH )
-    table_of_flags[RS__ACCELEROMETER_READINGS_SET_COMPLETE].callbacks_0_to_31_enabled_when_set |= ( 1 << RS__ACCELEROMETER_READINGS_SET_COMPLETE );
 
 // (2)
-// Next flag callback assignment here.
-    table_of_callbacks_for_flag_set[TI__TEMPERATURE_READING_REQUESTED] = &on_event__temperature_readings_requested__query_iis2dh;
-    table_of_callbacks_for_flag_clear[TI__TEMPERATURE_READING_REQUESTED] = NULL;
-// Connect scoreboard flag for this event to above callback:
-    table_of_flags[TI__TEMPERATURE_READING_REQUESTED].callbacks_0_to_31_enabled_when_set |= ( 1 << TI__TEMPERATURE_READING_REQUESTED );
-
-// (3)
-// Third flag callback assignment here.
+// Next flag callback assignment here.  Note, requests answered by a
+// reply, such as IIS2DH temperature readings, travel on channels in
+// kd-app-channels.h instead, so need no entry here.
 
 }
 
@@ -323,16 +311,16 @@ uint32_t initialize_scoreboard(void)
             table_of_callbacks_for_flag_clear[i] = NULL;
         }
 
-// Initialize the sole table of project supported Boolean flags:
-        for ( i = 0; i < COUNT_FLAGS_SUPPORTED; i++ )
-        {
-            table_of_flags[i].flag = FALSE;
-            table_of_flags[i].callbacks_0_to_31_enabled_when_set = 0;
-            table_of_flags[i].callbacks_0_to_31_enabled_when_cleared = 0;
-        }
-    }
+        assign_function_callback_pointers();
+
+        k_work_init(&flag_callbacks_work, handle_flag_callbacks);
+        k_work_queue_start(&scoreboard_work_q, scoreboard_work_q_stack_area,
+                           K_THREAD_STACK_SIZEOF(scoreboard_work_q_stack_area),
+                           SCOREBOARD_WORK_Q_PRIORITY, NULL);
+        k_thread_name_set(&scoreboard_work_q.thread, MODULE_ID__SCOREBOARD_WORK_Q);
 
-    assign_function_callback_pointers();
+        scoreboard_initialized = TRUE;
+    }
 
 #ifdef KD_DEV__ENABLE_SCOREBOARD_DEVELOPMENT_ROUTINES
     show_summary_of_callback_pointers(SUMMARY_CALLBACKS_ENABLED_FOR_FLAG_SET);
@@ -347,44 +335,128 @@ uint32_t initialize_scoreboard(void)
 // - SECTION - routines, setters and getters
 //----------------------------------------------------------------------
 
-uint32_t update_diag_messaging_level(const enum nn_diagnostic_levels passed_value)
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Sequence lock writer.  Sequence is odd while value is
+ *           being copied, and gains two per write, so half of it is
+ *           count of writes, value's version.  Writers serialize on
+ *           one lock, writes being rare and short.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+void scoreboard_value_write(atomic_t* sequence, void* storage, const void* value, const size_t size)
 {
-    global_diag_messaging_level = passed_value;
-    return 0;
+    k_spinlock_key_t key = k_spin_lock(&scoreboard_value_write_lock);
+
+    atomic_inc(sequence);
+    memcpy(storage, value, size);
+    atomic_inc(sequence);
+
+    k_spin_unlock(&scoreboard_value_write_lock, key);
 }
 
 
-uint32_t get_diag_messaging_level(enum nn_diagnostic_levels* value_to_return)
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Sequence lock reader, takes no lock.  Copies value and
+ *           copies again when a write began or ended meanwhile.
+ *           Returns version of value copied.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+uint32_t scoreboard_value_read(const atomic_t* sequence, const void* storage, void* value, const size_t size)
 {
-    *value_to_return = global_diag_messaging_level;
-    return 0;
+    atomic_val_t before = 0;
+    atomic_val_t after = 0;
+
+    do
+    {
+        before = atomic_get(sequence);
+        memcpy(value, storage, size);
+// Order copy ahead of second sequence read on SMP targets too:
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        after = atomic_get(sequence);
+    } while (( before & 1 ) || ( before != after ));
+
+    return (uint32_t)( after >> 1 );
 }
 
 
 
+uint32_t scoreboard_value_version(const atomic_t* sequence)
+{
+    return (uint32_t)( atomic_get(sequence) >> 1 );
+}
 
-static uint32_t odr_value_has_changed = 0;
 
-static enum iis2dh_output_data_rates_e requested_odr_present = ODR_0_POWERED_DOWN;
 
-uint32_t scoreboard__set_requested_iis2dh_odr(const enum iis2dh_output_data_rates_e passed_rate)
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Tell config change subscribers a setting was posted.  A
+ *           setter never waits, an event is missed when all config
+ *           change messages are in flight.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+static void publish_config_change(const enum config_change_items item, const uint32_t value, const uint32_t version)
 {
-printk("YY\nYYYYY present ODR = %u, requested ODR = %u\nYY\n", requested_odr_present, passed_rate);
-    if ( requested_odr_present != passed_rate ) // Output Data Rate changed since last read of this value from scoreboard
+    struct config_change_event* event = NULL;
+
+    if ( kd_channel_subscriber_count(&config_change_channel) == 0 )
     {
-        requested_odr_present = passed_rate;
-        odr_value_has_changed = 1;
+        return;
     }
 
-    return odr_value_has_changed;
+    event = kd_channel_claim(&config_change_channel, K_NO_WAIT);
+    if ( event != NULL )
+    {
+        event->item = item;
+        event->value = value;
+        event->version = version;
+        kd_channel_publish(event);
+    }
+}
+
+
+
+uint32_t set_diag_messaging_level(const enum nn_diagnostic_levels passed_value)
+{
+    scoreboard_value_set__diag_messaging_level(passed_value);
+    publish_config_change(CONFIG_ITEM_DIAG_MESSAGING_LEVEL, passed_value,
+                          scoreboard_value_version__diag_messaging_level());
+    return ROUTINE_OK;
+}
+
+
+uint32_t get_diag_messaging_level(enum nn_diagnostic_levels* value_to_return)
+{
+    scoreboard_value_get__diag_messaging_level(value_to_return);
+    return ROUTINE_OK;
+}
+
+
+
+uint32_t scoreboard__set_requested_iis2dh_odr(const enum iis2dh_output_data_rates_e passed_rate)
+{
+    scoreboard_value_set__requested_iis2dh_odr(passed_rate);
+    publish_config_change(CONFIG_ITEM_IIS2DH_ODR, passed_rate,
+                          scoreboard_value_version__requested_iis2dh_odr());
+    return ROUTINE_OK;
 }
 
 
 uint32_t scoreboard__get_requested_iis2dh_odr(enum iis2dh_output_data_rates_e* value_to_return)
 {
-    *value_to_return = requested_odr_present;
-    odr_value_has_changed = 0;
-    return 0;
+    scoreboard_value_get__requested_iis2dh_odr(value_to_return);
+    return ROUTINE_OK;
+}
+
+
+// Cheap check for consumers polling ODR, version changes with each request posted:
+uint32_t scoreboard__requested_iis2dh_odr_version(void)
+{
+    return scoreboard_value_version__requested_iis2dh_odr();
 }
 
 
@@ -393,14 +465,16 @@ uint32_t scoreboard__get_requested_iis2dh_odr(enum iis2dh_output_data_rates_e* v
  
 uint32_t scoreboard__set_IIS2DH_CTRL_REG4_full_scale_config_bits(const uint8_t fs_setting)
 {
-    iis2dh_full_scale_selection = fs_setting;
-    return 0;
+    scoreboard_value_set__iis2dh_full_scale_selection(fs_setting);
+    publish_config_change(CONFIG_ITEM_IIS2DH_FULL_SCALE, fs_setting,
+                          scoreboard_value_version__iis2dh_full_scale_selection());
+    return ROUTINE_OK;
 }
 
 uint32_t scoreboard__get_IIS2DH_CTRL_REG4_full_scale_config_bits(uint8_t *fs_setting)
 {
-    *fs_setting = iis2dh_full_scale_selection;
-    return 0;
+    scoreboard_value_get__iis2dh_full_scale_selection(fs_setting);
+    return ROUTINE_OK;
 }
 
 
@@ -413,42 +487,121 @@ uint32_t scoreboard__get_IIS2DH_CTRL_REG4_full_scale_config_bits(uint8_t *fs_set
 /*
  *  @Note  For each flag a single routine can set or clear the flag.
  *         Each implemented flag has an update routine whose name begins
- *         with 'scoreboard__update_flag_'.  These update routines
- *         may optionally call a general purpose callback orchestrator,
- *         a routine which checks whether a flag event is configured
- *         to execute one or more callbacks when that given event
- *         occurs.
+ *         with 'scoreboard__update_flag_', all of which call
+ *         scoreboard__update_flag().  A flag which changes value has
+ *         its event queued for callbacks configured for that event,
+ *         see handle_flag_callbacks().
  */
 
-// Following flag gets set when accelerometer readings are ready to
-// be transformed and used to calculate VRMS.  This flag is unset
-// shortly after VRMS is calculated, so that new accelerometer readings
-// can be gathered by other parts of this firmware:
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Set or clear one flag.  Safe from any thread or ISR, and
+ *           returns without running callbacks, so sensor thread and
+ *           other producers pay only for an atomic update and a wake.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
 
-uint32_t scoreboard__update_flag_accelerometer_readings_ready(enum flag_event_e event_or_updating_value)
+uint32_t scoreboard__update_flag(const enum kionix_driver_demo_supported_flags_e flag,
+                                 const enum flag_event_e event)
 {
-    uint32_t rstatus = ROUTINE_OK;
+    atomic_val_t before = 0;
+    uint32_t snapshot = 0;
 
-    if ( table_of_flags[RS__ACCELEROMETER_READINGS_SET_COMPLETE].flag != event_or_updating_value )
+    if ( flag >= MARKER_END_OF_IMPLEMENTED_FLAGS )
     {
-        table_of_flags[RS__ACCELEROMETER_READINGS_SET_COMPLETE].flag = event_or_updating_value;
-        handle_flag_callbacks(RS__ACCELEROMETER_READINGS_SET_COMPLETE, event_or_updating_value);
+        return KD__SB_SCOREBOARD_INVALID_FLAG;
     }
-    return rstatus;
+
+    if ( event == FLAG_SET )
+    {
+        before = atomic_or(&scoreboard_flags, (atomic_val_t)SCOREBOARD_FLAG_BIT(flag));
+    }
+    else if ( event == FLAG_CLEARED )
+    {
+        before = atomic_and(&scoreboard_flags, ~(atomic_val_t)SCOREBOARD_FLAG_BIT(flag));
+    }
+    else
+    {
+        return KD__SB_SCOREBOARD_INVALID_BOOLEAN_FLAG_VALUE;
+    }
+
+// Flag already had this value, no event to signal:
+    if ( ((before & SCOREBOARD_FLAG_BIT(flag)) != 0) == (event == FLAG_SET) )
+    {
+        return ROUTINE_OK;
+    }
+
+// Mirror word into event object outside any lock.  Racing updaters may
+// publish out of order, so repeat until mirrored word is current:
+    do
+    {
+        snapshot = (uint32_t)atomic_get(&scoreboard_flags);
+        k_event_set(&scoreboard_flag_events, snapshot);
+    } while ( (uint32_t)atomic_get(&scoreboard_flags) != snapshot );
+
+    if ( event == FLAG_SET )
+    {
+        if ( table_of_callbacks_for_flag_set[flag] != NULL )
+        {
+            atomic_or(&flags_pending_set_callback, (atomic_val_t)SCOREBOARD_FLAG_BIT(flag));
+            k_work_submit_to_queue(&scoreboard_work_q, &flag_callbacks_work);
+        }
+    }
+    else
+    {
+        if ( table_of_callbacks_for_flag_clear[flag] != NULL )
+        {
+            atomic_or(&flags_pending_clear_callback, (atomic_val_t)SCOREBOARD_FLAG_BIT(flag));
+            k_work_submit_to_queue(&scoreboard_work_q, &flag_callbacks_work);
+        }
+    }
+
+    return ROUTINE_OK;
 }
 
 
 
-uint32_t scoreboard__update_flag__temperature_reading_requested(enum flag_event_e event_or_updating_value)
+uint32_t scoreboard__flag_is_set(const enum kionix_driver_demo_supported_flags_e flag)
 {
-    uint32_t rstatus = ROUTINE_OK;
+    return ( ((uint32_t)atomic_get(&scoreboard_flags) & SCOREBOARD_FLAG_BIT(flag)) != 0 );
+}
 
-    if ( table_of_flags[TI__TEMPERATURE_READING_REQUESTED].flag != event_or_updating_value )
+uint32_t scoreboard__flags_get(void)
+{
+    return (uint32_t)atomic_get(&scoreboard_flags);
+}
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Block calling thread until any, or with 'wait_for_all'
+ *           all, of flags in 'flag_mask' are set, or timeout expires.
+ *           Returns flags of mask set at wake, zero on timeout.  Flags
+ *           are left as found, consumer clears those it handles.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+uint32_t scoreboard__wait_for_flags(const uint32_t flag_mask, const uint32_t wait_for_all, const k_timeout_t timeout)
+{
+    if ( wait_for_all )
     {
-        table_of_flags[TI__TEMPERATURE_READING_REQUESTED].flag = event_or_updating_value;
-        handle_flag_callbacks(TI__TEMPERATURE_READING_REQUESTED, event_or_updating_value);
+        return k_event_wait_all(&scoreboard_flag_events, flag_mask, false, timeout);
     }
-    return rstatus;
+
+    return k_event_wait(&scoreboard_flag_events, flag_mask, false, timeout);
+}
+
+
+
+// Following flag gets set when accelerometer readings are ready to
+// be transformed and used to calculate VRMS.  This flag is unset
+// shortly after VRMS is calculated, so that new accelerometer readings
+// can be gathered by other parts of this firmware:
+
+uint32_t scoreboard__update_flag_accelerometer_readings_ready(enum flag_event_e event_or_updating_value)
+{
+    return scoreboard__update_flag(RS__ACCELEROMETER_READINGS_SET_COMPLETE, event_or_updating_value);
 }
 
 
@@ -459,47 +612,37 @@ uint32_t scoreboard__update_flag__temperature_reading_requested(enum flag_event_
 // * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 //
 
-uint32_t handle_flag_callbacks(enum kionix_driver_demo_supported_flags_e flag_index, enum flag_event_e event)
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Runs on scoreboard work queue.  Takes all pending flag
+ *           events at once and runs callback of each, lowest flag
+ *           first.  Callback pointer at index of flag's position in
+ *           enumeration of supported flags serves that flag.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+static void handle_flag_callbacks(struct k_work* work)
 {
-    uint32_t callback_status = 0;
+    uint32_t pending_set = (uint32_t)atomic_clear(&flags_pending_set_callback);
+    uint32_t pending_clear = (uint32_t)atomic_clear(&flags_pending_clear_callback);
+    uint32_t flag_index = 0;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-// In this IF-block execute a routine via a C function pointer, when
-// the callback pointer is not NULL.
-//
-// Note, in first draft of this routine the callback pointer is the
-// one at the index of the flag's position in the enumeration of
-// supported flags.  As of 2021-11-19 there are ten supported flags but
-// each flag has two associated integer variables to specify associated
-// callbacks.  These integers each contain 32 bits which by design
-// indicate up to 32 callbacks a flag
-// may trigger when set, and alternately when given flag is cleared.
-//
-// NOTE:  We are not yet reading those two integer variables to make
-// multiple callbacks.  We may not need these, they're a feature to
-// review.  - TMH
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-    if ( event == VALUE_OF_FLAG_SET )
+    ARG_UNUSED(work);
+
+    for ( flag_index = 0; flag_index < MARKER_END_OF_IMPLEMENTED_FLAGS; flag_index++ )
     {
-        if ( table_of_callbacks_for_flag_set[flag_index] != NULL )
+        if (( pending_set & SCOREBOARD_FLAG_BIT(flag_index) ) && ( table_of_callbacks_for_flag_set[flag_index] != NULL ))
         {
 // Note, 'table_of_callbacks_for_flag_set' is an array of function pointers:
-            printk("- MARK 3 - executing callback for flag %u set event . . .\n", flag_index);
-            callback_status = table_of_callbacks_for_flag_set[flag_index](event);
+            table_of_callbacks_for_flag_set[flag_index](FLAG_SET);
         }
-        else
+
+        if (( pending_clear & SCOREBOARD_FLAG_BIT(flag_index) ) && ( table_of_callbacks_for_flag_clear[flag_index] != NULL ))
         {
-            printk("\n- MARK 2 - \n");
-            printk("- ERROR:  callback pointer NULL!\n");
-            printk("+ INFO:  got event of value %u\n", event);
-            printk("+ INFO:  and flag index equal to %u\n\n", flag_index);
+            table_of_callbacks_for_flag_clear[flag_index](FLAG_CLEARED);
         }
     }
 
-// TO-DO:  handle 'flag cleared' event here.
-
-    return callback_status;
-
 } // end routine handle_flag_callbacks()
 
 
@@ -12,10 +12,12 @@
  *   for sharing data between modules in decoupled way.  Scoreboard
  *   facilities include:
  *
- *   +  setter and getter pairs of routines
+ *   +  setter and getter pairs of routines, over values which
+ *      threads share by sequence lock and version count
  *
- *   +  table of Boolean flags and associated pointers to optional
- *      callback routines (2021-11-05 not yet fully implemented - TMH)
+ *   +  Boolean flags in one atomic word, which threads may block on,
+ *      and associated pointers to optional callback routines run on
+ *      a scoreboard work queue
  *
  * ---------------------------------------------------------------------
  */
@@ -29,6 +31,10 @@
 // data types here. - TMH
 //----------------------------------------------------------------------
 
+#include <stddef.h>                // to provide size_t
+#include <zephyr.h>                // to provide k_timeout_t
+#include <sys/atomic.h>            // to provide atomic_t
+
 #include "diagnostic.h"
 
 #include "iis2dh-registers.h"    // may not need this include - TMH
@@ -46,11 +52,13 @@ enum kionix_driver_demo_supported_flags_e
 {
     RS__ACCELEROMETER_READINGS_SET_COMPLETE = 0,     // RS = Readings Set module
     TI__FIFO_OVERRUN_IN_LATEST_READINGS_GATHERING,   // TI = Thread IIS2DH
-    TI__TEMPERATURE_READING_REQUESTED,               // TI = Thread IIS2DH
     MARKER_END_OF_IMPLEMENTED_FLAGS,
     MARKER_END_OF_SUPPORTED_FLAGS = COUNT_FLAGS_SUPPORTED
 };
 
+// Bit of a flag in scoreboard__flags_get() and in masks passed to scoreboard__wait_for_flags():
+#define SCOREBOARD_FLAG_BIT(flag) ( 1UL << (flag) )
+
 enum flag_event_e
 {
     FLAG_CLEARED = 0,
@@ -59,6 +67,55 @@ enum flag_event_e
 
 
 
+//----------------------------------------------------------------------
+// - SECTION - versioned values
+//----------------------------------------------------------------------
+
+/*
+ *  Declare at file scope a value shared by threads, plus its typed
+ *  accessors:
+ *
+ *    scoreboard_value_set__<name>(value)
+ *    scoreboard_value_get__<name>(&value)    returns value's version
+ *    scoreboard_value_version__<name>()      version alone, one atomic read
+ *
+ *  Version counts writes, so a reader which keeps version of its last
+ *  read sees "changed since last look" without copying value.  Reads
+ *  take no lock, and retry only when a write overlaps them.
+ */
+
+#define SCOREBOARD_VALUE_DEFINE(name, type, initial_value)                              \
+    static struct                                                                       \
+    {                                                                                   \
+        atomic_t sequence;                                                              \
+        type value;                                                                     \
+    } scoreboard_value__##name = { ATOMIC_INIT(0), initial_value };                     \
+                                                                                        \
+    static inline void scoreboard_value_set__##name(const type new_value)               \
+    {                                                                                   \
+        scoreboard_value_write(&scoreboard_value__##name.sequence,                      \
+                               &scoreboard_value__##name.value, &new_value, sizeof(type)); \
+    }                                                                                   \
+                                                                                        \
+    static inline uint32_t scoreboard_value_get__##name(type* value_to_return)          \
+    {                                                                                   \
+        return scoreboard_value_read(&scoreboard_value__##name.sequence,                \
+                                     &scoreboard_value__##name.value, value_to_return, sizeof(type)); \
+    }                                                                                   \
+                                                                                        \
+    static inline uint32_t scoreboard_value_version__##name(void)                       \
+    {                                                                                   \
+        return scoreboard_value_version(&scoreboard_value__##name.sequence);            \
+    }
+
+void scoreboard_value_write(atomic_t* sequence, void* storage, const void* value, const size_t size);
+
+uint32_t scoreboard_value_read(const atomic_t* sequence, const void* storage, void* value, const size_t size);
+
+uint32_t scoreboard_value_version(const atomic_t* sequence);
+
+
+
 //----------------------------------------------------------------------
 // - SECTION - routine prototypes
 //----------------------------------------------------------------------
@@ -72,6 +129,7 @@ uint32_t get_diag_messaging_level(enum nn_diagnostic_levels* value_to_return);
 // . . .
 uint32_t scoreboard__set_requested_iis2dh_odr(const enum iis2dh_output_data_rates_e data_rate);
 uint32_t scoreboard__get_requested_iis2dh_odr(enum iis2dh_output_data_rates_e *data_rate);
+uint32_t scoreboard__requested_iis2dh_odr_version(void);
 
 // setter and getter for IIS2DH full scale configuration bits (needed by VRMS calculation code):
 uint32_t scoreboard__set_IIS2DH_CTRL_REG4_full_scale_config_bits(const uint8_t fs_setting);
@@ -81,9 +139,16 @@ uint32_t scoreboard__get_IIS2DH_CTRL_REG4_full_scale_config_bits(uint8_t *fs_set
 
 // - SECTION - Boolean flag routines:
 
-uint32_t scoreboard__update_flag_accelerometer_readings_ready(enum flag_event_e event_or_updating_value);
+uint32_t scoreboard__update_flag(const enum kionix_driver_demo_supported_flags_e flag,
+                                 const enum flag_event_e event);
 
-uint32_t scoreboard__update_flag__temperature_reading_requested(enum flag_event_e event_or_updating_value);
+uint32_t scoreboard__flag_is_set(const enum kionix_driver_demo_supported_flags_e flag);
+
+uint32_t scoreboard__flags_get(void);
+
+uint32_t scoreboard__wait_for_flags(const uint32_t flag_mask, const uint32_t wait_for_all, const k_timeout_t timeout);
+
+uint32_t scoreboard__update_flag_accelerometer_readings_ready(enum flag_event_e event_or_updating_value);
 
 
 
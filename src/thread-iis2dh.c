@@ -80,11 +80,24 @@
 #include "return-values.h"
 #include "module-ids.h"
 #include "development-flags.h"
+#include "diagnostic.h"
 
 #include "common.h"
 #include "scoreboard.h"
 #include "conversions.h"
 #include "iis2dh-registers.h"
+#include "iis2dh-register-cache.h"
+#include "kd-app-channels.h"
+#include "kd-trace.h"
+#include "sample-ring.h"
+#include "thread-iis2dh.h"
+
+#if KD_TEST__EMUL_ASYNC_FIFO_DRAIN == 1
+#if !defined(CONFIG_I2C_EMUL) || !defined(CONFIG_I2C_CALLBACK)
+#error "KD_TEST__EMUL_ASYNC_FIFO_DRAIN needs CONFIG_I2C_EMUL and CONFIG_I2C_CALLBACK"
+#endif
+#include "emul-iis2dh.h"           // to provide emul_iis2dh_transfer_cb()
+#endif
 
 #if KD_DEV__CLI_DIAG_ON_IN_IIS2DH_TASK
 #include "thread-simple-cli.h"
@@ -114,6 +127,9 @@
 // https://docs.zephyrproject.org/latest/guides/dts/howtos.html#get-a-struct-device-from-a-devicetree-node
 #define IIS2DH_ACCELEROMETER DT_NODELABEL(stmicro_sensor)
 
+BUILD_ASSERT(DT_NODE_HAS_STATUS(ST_IIS2DH, okay) && DT_ON_BUS(ST_IIS2DH, i2c),
+  "thread IIS2DH expects an enabled st,iis2dh node on an I2C bus");
+
 
 //
 // defines thread related:
@@ -125,6 +141,12 @@
 // defines for application or task implemented by this thread:
 #define SLEEP_TIME__IIS2DH_TASK__MS (2000)
 
+// In watermark interrupt mode, longest wait for INT1 before draining FIFO anyway:
+#define WATERMARK_WAIT_TIMEOUT__IIS2DH_TASK__MS (SLEEP_TIME__IIS2DH_TASK__MS)
+
+// In streaming mode without INT1, FIFO is polled once this many readings have accrued:
+#define READINGS_PER_FIFO_POLL__IIS2DH_TASK (KD_APP_IIS2DH_FIFO_WATERMARK_LEVEL)
+
 
 //
 // Sensor related:
@@ -154,27 +176,69 @@ void iis2dh_thread_entry_point(void* arg1, void* arg2, void* arg3);
 
 // #define BYTES_PER_XYZ_READINGS_TRIPLET (6)
 #define FIFO_READINGS_MAXIMUM_COUNT (32)
-static uint8_t readings_data[BYTES_PER_XYZ_READINGS_TRIPLET * (FIFO_READINGS_MAXIMUM_COUNT - 1)];
+#define FIFO_DRAIN_BUFFER_COUNT (2)
+#define FIFO_DRAIN_BUFFER_SIZE (BYTES_PER_XYZ_READINGS_TRIPLET * (FIFO_READINGS_MAXIMUM_COUNT - 1))
+
+// One FIFO drain lands in one buffer while readings in the other are
+// unpacked.  Static and word aligned so that I2C controllers with DMA,
+// e.g. nRF TWIM EasyDMA, can write to them directly:
+static uint8_t readings_data[FIFO_DRAIN_BUFFER_COUNT][FIFO_DRAIN_BUFFER_SIZE] __aligned(4);
+static struct acc_reading_triplet readings_block[(FIFO_READINGS_MAXIMUM_COUNT - 1)];
+
+// Shift and sensitivity matching resolution and full scale last written to sensor:
+static struct acc_milli_g_scale milli_g_scale_in_use;
 #define TRIPLETS_TO_FORMAT_PER_LINE (4)
 
 
-#if 1
-// Possible run-time copies of sensor configuration register settings:
-static uint8_t iis2dh_temp_cfg_reg = 0;    // 0x1F
-// static uint8_t iis2dh_ctrl_reg1 = 0;       // 0x20
-// static uint8_t iis2dh_ctrl_reg2 = 0;       // 0x21
-static uint8_t iis2dh_ctrl_reg3 = 0;       // 0x22
-static uint8_t iis2dh_ctrl_reg4 = 0;       // 0x23
-static uint8_t iis2dh_ctrl_reg5 = 0;       // 0x24
-static uint8_t iis2dh_acc_status = 0;      // 0x27
-static uint8_t iis2dh_fifo_ctrl_reg = 0;   // 0x2F
-#endif
+// Shadow of sensor register map 0x07..0x3F.  Routines change wanted values
+// here, iis2dh_write_dirty_registers() sends only the span of registers
+// marked dirty.  Reads of non-volatile registers are answered from here:
+static struct iis2dh_register_cache iis2dh_register_shadow;
+
+// IIS2DH thread, CLI and host protocol all update shadow and flush it.
+// Mutex is held across each update sequence and its flush, so no thread
+// sends or overwrites another's half built configuration.  Zephyr
+// mutexes nest, so locked routines may call each other:
+K_MUTEX_DEFINE(iis2dh_register_shadow_lock);
+
+#define REG_SHADOW_LOCK() k_mutex_lock(&iis2dh_register_shadow_lock, K_FOREVER)
+#define REG_SHADOW_UNLOCK() k_mutex_unlock(&iis2dh_register_shadow_lock)
+
+#define REG_SHADOW(reg) iis2dh_register_cache_wanted(&iis2dh_register_shadow, (reg))
+#define REG_SHADOW_SET(reg, value) iis2dh_register_cache_set(&iis2dh_register_shadow, (reg), (value))
+
+static uint32_t register_block_write_count = 0;
+static uint32_t register_cache_hit_count = 0;
 
 //static uint32_t iis2dh_thread_sleep_time_in_ms;
 
 // Not fully implemented, meant to track larger sets of time contiguous reagings from FIFO:
 static uint32_t running_total_xyz_readings = 0;
 
+// Set when sensor is configured once and left running between FIFO drains:
+static uint32_t flag_streaming_acquisition = 0;
+
+#if KD_DEV__IIS2DH_ASYNC_FIFO_DRAIN == 1
+// --- asynchronous FIFO drain related BEGIN ---
+// Given by I2C transfer completion callback, or right after a blocking
+// transfer when bus driver offers no callback API:
+K_SEM_DEFINE(iis2dh_fifo_drain_semaphore, 0, 1);
+
+#define FIFO_DRAIN_TIMEOUT_MS (50)
+
+static volatile int fifo_drain_transfer_status = 0;
+static atomic_t fifo_drain_in_flight = ATOMIC_INIT(0);  // set from submit until completion callback runs
+static uint32_t fifo_drain_timeout_count = 0;   // drains given up on, their buffer held until transfer ends
+static uint32_t drain_fill_index = 0;           // buffer which next drain fills
+static uint32_t drain_pending_count = 0;        // readings drained into other buffer, not yet unpacked
+static uint32_t drain_pending_timestamp = 0;    // cycle count at which those readings arrived
+static uint32_t fifo_drain_overlap_count = 0;   // blocks unpacked while next drain in flight
+#if KD_DEV__TRACE_POINTS_ENABLED == 1
+static uint32_t fifo_drain_started_at = 0;      // cycle count at which latest drain was submitted
+#endif
+// --- asynchronous FIFO drain related END ---
+#endif
+
 
 //
 // --- FIFO overrun related BEGIN ---
@@ -191,39 +255,66 @@ static uint32_t fifo_overrun_count_fsv = 0;
 //
 
 
+// Timestamped raw readings, from this thread to any attached consumers:
+SAMPLE_RING_DEFINE(iis2dh_sample_ring, KD_APP_IIS2DH_SAMPLE_RING_CAPACITY);
+
+// Temperature requests from CLI and other modules, see kd-app-channels.h:
+KD_CHANNEL_SUBSCRIBER_DEFINE(iis2dh_temperature_request_subscriber, 2);
+
+
 // 2021-11-17 - *sensor needed at file scope for new public API routines:
 const struct device *sensor = DEVICE_DT_GET_ANY(st_iis2dh);
 
+// Zephyr 3.x iis2dh_data carries no bus pointer, so app reaches sensor
+// registers through I2C controller and address taken from devicetree:
+static const struct i2c_dt_spec iis2dh_i2c = I2C_DT_SPEC_INST_GET(0);
+
 
 #if KD_DEV__CLI_ONE_SHOT_MESSAGE_FLAG == 1
 static uint32_t flag_one_shot_diag_message_enabled = 0;
 #endif
 
-#if KD_DEV__CONFIG_REGISTERS_SUMMARY_ENABLED == 1
-#define REGISTER_NAME_SIZE 40
-struct config_register
-{
-    char name[REGISTER_NAME_SIZE];
-    uint8_t value_default;
-    uint8_t value_latest;
-};
 
-#define COUNT_REGISTERS_IIS2DH_FOLLOWED 6
-struct config_register registers_iis2dh[COUNT_REGISTERS_IIS2DH_FOLLOWED];
+#if KD_DEV__IIS2DH_FIFO_WATERMARK_INTERRUPT_ENABLED == 1
+// --- FIFO watermark interrupt related BEGIN ---
+// IIS2DH INT1 pin, per 'drdy-gpios' property of sensor devicetree node.
+// When property absent port member is NULL and thread falls back to polling:
+static const struct gpio_dt_spec iis2dh_int1_gpio = GPIO_DT_SPEC_INST_GET_OR(0, drdy_gpios, { 0 });
+static struct gpio_callback iis2dh_int1_gpio_callback_data;
+
+// Given from GPIO callback, taken by IIS2DH thread to drain FIFO:
+K_SEM_DEFINE(iis2dh_fifo_watermark_semaphore, 0, 1);
+
+static uint32_t flag_watermark_interrupt_armed = 0;
+static uint32_t fifo_watermark_interrupt_count = 0;
+// --- FIFO watermark interrupt related END ---
+#endif
 
+#if KD_DEV__CONFIG_REGISTERS_SUMMARY_ENABLED == 1
+// Summary from register shadow, costs no bus cycles:
 void register_summary(void)
 {
-    for ( int i = 0; i < COUNT_REGISTERS_IIS2DH_FOLLOWED; i++ )
+    uint8_t value = 0;
+
+    REG_SHADOW_LOCK();
+    for ( uint8_t addr = IIS2DH_REGISTER_CACHE_FIRST; addr <= IIS2DH_REGISTER_CACHE_LAST; addr++ )
     {
-        if ( strlen(registers_iis2dh[i].name) > 0 )
+        if ( iis2dh_register_class(addr) != IIS2DH_REGISTER_NON_VOLATILE )
+            { continue; }
+
+        if ( iis2dh_register_cache_lookup(&iis2dh_register_shadow, addr, &value) == ROUTINE_OK )
         {
-            printk("%s holds %u\n", registers_iis2dh[i].name, registers_iis2dh[i].value_latest);
+            printk("0x%02X %-14s holds %3u%s\n", addr, iis2dh_register_name(addr), value,
+              ( iis2dh_register_cache_is_dirty(&iis2dh_register_shadow, addr) ? ", dirty" : "" ));
         }
         else
         {
-            i = COUNT_REGISTERS_IIS2DH_FOLLOWED;
+            printk("0x%02X %-14s unknown, want %u\n", addr, iis2dh_register_name(addr), REG_SHADOW(addr));
         }
     }
+    REG_SHADOW_UNLOCK();
+    printk("%u register block writes, %u register reads from cache since start\n",
+      register_block_write_count, register_cache_hit_count);
 }
 #endif
 
@@ -243,10 +334,15 @@ void show_fifo_overruns_summary(void)
 
     printk("FIFO overrun events noted from latest x,y,z readings set:\n\n");
 
-    for ( i = 0; i < fifo_overrun_count_fsv; i++ )
+    for ( i = 0; ( i < fifo_overrun_count_fsv ) && ( i < MAX_OVERRUNS_TRACKED ); i++ )
     {   
-        printk("  FIFO overrun %u @ reading %u\n", i, fifo_overrun_events->reading_index);
+        printk("  FIFO overrun %u @ reading %u\n", i, fifo_overrun_events[i].reading_index);
     }   
+    printk("  %u readings lost by lapped sample ring readers since start,\n", sample_ring_overflow_count(&iis2dh_sample_ring));
+#if KD_DEV__IIS2DH_ASYNC_FIFO_DRAIN == 1
+    printk("  %u blocks unpacked while next FIFO drain in flight,\n", fifo_drain_overlap_count);
+    printk("  %u FIFO drains timed out,\n", fifo_drain_timeout_count);
+#endif
     printk("\n");
 }
 
@@ -265,6 +361,128 @@ void dev__thread_iis2dh__set_one_shot_message_flag(void)
 // - SECTION - routines production this module
 //----------------------------------------------------------------------
 
+static void note_fifo_overrun_event(const uint32_t reading_index)
+{
+// Count every event, but keep details of only the first MAX_OVERRUNS_TRACKED:
+    if ( fifo_overrun_count_fsv < MAX_OVERRUNS_TRACKED )
+        { fifo_overrun_events[fifo_overrun_count_fsv].reading_index = reading_index; }
+    fifo_overrun_count_fsv++;
+}
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Assemble x,y,z readings from bytes of FIFO burst read.
+ *           With CTRL_REG4 BLE clear low byte comes first, and 8-,
+ *           10- or 12-bit readings are left justified in 16 bits.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+static void unpack_readings_block(const uint8_t* raw_triplets, const uint32_t triplet_count)
+{
+    uint32_t i = 0;
+    KD_TRACE_BEGIN(UNPACK);
+
+    for ( i = 0; i < triplet_count; i++ )
+    {
+        const uint8_t* raw = &raw_triplets[(i * BYTES_PER_XYZ_READINGS_TRIPLET)];
+
+        readings_block[i].x = (uint16_t)( raw[0] | ( raw[1] << 8 ) );
+        readings_block[i].y = (uint16_t)( raw[2] | ( raw[3] << 8 ) );
+        readings_block[i].z = (uint16_t)( raw[4] | ( raw[5] << 8 ) );
+    }
+
+    KD_TRACE_END(UNPACK);
+}
+
+
+
+static void refresh_milli_g_scale(void)
+{
+    REG_SHADOW_LOCK();
+    iis2dh_milli_g_scale(( REG_SHADOW(IIS2DH_CTRL_REG4) & ACC_FULL_SCALE_MASK ),
+                         iis2dh_resolution_from_control_registers(REG_SHADOW(IIS2DH_CTRL_REG1), REG_SHADOW(IIS2DH_CTRL_REG4)),
+                         &milli_g_scale_in_use);
+    REG_SHADOW_UNLOCK();
+}
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Publish one block of readings on sample block channel.
+ *           Skipped when nobody subscribes, and never waits for a
+ *           free message, so a slow subscriber costs this thread
+ *           nothing but the missed block.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+static void publish_sample_block(const struct acc_reading_triplet* triplets,
+                                 const uint32_t triplet_count,
+                                 const uint32_t first_sequence,
+                                 const uint32_t timestamp)
+{
+    struct acc_sample_block* block = NULL;
+    uint32_t published = 0;
+    uint32_t count = 0;
+
+    if ( kd_channel_subscriber_count(&acc_sample_block_channel) == 0 )
+    {
+        return;
+    }
+
+    while ( published < triplet_count )
+    {
+        block = kd_channel_claim(&acc_sample_block_channel, K_NO_WAIT);
+        if ( block == NULL )
+            { return; }
+
+        count = MIN(( triplet_count - published ), ACC_SAMPLE_BLOCK_MAX_READINGS);
+        block->timestamp = timestamp;
+        block->first_sequence = ( first_sequence + published );
+        block->count = count;
+        memcpy(block->xyz, &triplets[published], ( count * sizeof(struct acc_reading_triplet) ));
+
+        kd_channel_publish(block);
+        published += count;
+    }
+}
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Copy one block of readings into sample ring, each stamped
+ *           with cycle count at which block arrived from sensor, and
+ *           publish block to channel subscribers.  Ring always takes
+ *           readings, slow readers account for their own losses.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+static void push_readings_to_sample_ring(const struct acc_reading_triplet* triplets,
+                                         const uint32_t triplet_count,
+                                         const uint32_t timestamp)
+{
+    struct acc_sample_record record;
+    uint32_t i = 0;
+    KD_TRACE_BEGIN(PUBLISH);
+
+    publish_sample_block(triplets, triplet_count, running_total_xyz_readings, timestamp);
+
+    for ( i = 0; i < triplet_count; i++ )
+    {
+        record.timestamp = timestamp;
+        record.sequence = running_total_xyz_readings;
+        record.xyz = triplets[i];
+
+        sample_ring_push(&iis2dh_sample_ring, &record);
+        running_total_xyz_readings++;
+    }
+
+    KD_TRACE_END(PUBLISH);
+}
+
 // https://docs.zephyrproject.org/latest/reference/kernel/threads/index.html#c.K_THREAD_STACK_DEFINE
 
 K_THREAD_STACK_DEFINE(iis2dh_thread_stack_area, IIS2DH_THREAD_STACK_SIZE);
@@ -314,23 +532,18 @@ static uint32_t kd_write_peripheral_register(const struct device *dev,
                                              const uint32_t count_bytes_to_write)
 {
     int rstatus = ROUTINE_OK;
-    struct iis2dh_data *device_data_ptr = (struct iis2dh_data *)dev->data;
-
-#ifdef DEV_1110
-    rstatus = i2c_write(
-                        device_data_ptr->bus,
-                        device_register_and_data,
-                        count_bytes_to_write,
-                        DT_INST_REG_ADDR(0)
-                      );
-#endif
+
+    rstatus = i2c_write_dt(
+                           &iis2dh_i2c,
+                           device_register_and_data,
+                           count_bytes_to_write
+                         );
 
 #if KD_DEV__I2C_WRITE_STATUS == 1
 if ( rstatus != 0 )
 {
-    printk("- WARNING - Zephyr i2c_write API returns error value of %d,\n", rstatus);
-    printk("+ WARNING - peripheral I2C address for this munication is 0x%02X,\n", DT_INST_REG_ADDR(0));
-    printk("+ WARNING - address of peripheral register to write is 0x%02x )\n\n", device_register_and_data[0]);
+    DMSG(THREAD_IIS2DH, KD_DIAG_ERRORS, "i2c_write() returns %d writing register 0x%02X of peripheral at 0x%02X",
+      rstatus, device_register_and_data[0], DT_INST_REG_ADDR(0));
 }
 #endif
     return rstatus;
@@ -352,19 +565,15 @@ static uint32_t kd_read_peripheral_register(const struct device *dev,
                                             const uint8_t count_bytes_to_read)
 {
     int rstatus = ROUTINE_OK;
-    struct iis2dh_data *device_data_ptr = (struct iis2dh_data *)dev->data;
-
-#ifdef DEV_1110
-    rstatus = i2c_write_read(
-                              device_data_ptr->bus,
-                              DT_INST_REG_ADDR(0),
-                              device_register,
-//                              sizeof(device_register),
-                              1,
-                              data,
-                              count_bytes_to_read
-                            );
-#endif
+
+    rstatus = i2c_write_read_dt(
+                                 &iis2dh_i2c,
+                                 device_register,
+//                                 sizeof(device_register),
+                                 1,
+                                 data,
+                                 count_bytes_to_read
+                               );
 
 // REF https://docs.zephyrproject.org/2.6.0/reference/peripherals/i2c.html?highlight=i2c_write#c.i2c_write_read
 
@@ -392,6 +601,180 @@ static uint32_t kd_read_peripheral_register(const struct device *dev,
 
 
 
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Send dirty registers of shadow between first and last to
+ *           sensor in one auto-increment I2C write, covering lowest
+ *           through highest dirty register.  Clean registers inside
+ *           that span are sent again with their present value.  No bus
+ *           traffic when nothing is dirty.  Caller keeps first..last
+ *           to a span of writable registers.
+ *
+ *  @Note    Register address MSb set asks IIS2DH to increment register
+ *           address after each byte, iis2dh.pdf section 6.1.1.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+static uint32_t iis2dh_write_dirty_registers(const struct device *dev, const uint8_t first, const uint8_t last)
+{
+    uint8_t cmd[1 + IIS2DH_REGISTER_CACHE_SIZE];
+    uint8_t span_first = 0;
+    uint8_t span_last = 0;
+    uint8_t addr = 0;
+    uint32_t rstatus = ROUTINE_OK;
+
+    REG_SHADOW_LOCK();
+    if ( iis2dh_register_cache_dirty_span(&iis2dh_register_shadow, first, last, &span_first, &span_last) == 0 )
+    {
+        REG_SHADOW_UNLOCK();
+        return rstatus;
+    }
+
+    cmd[0] = ( IIS2DH_I2C_AUTO_INCREMENT | span_first );
+    for ( addr = span_first; addr <= span_last; addr++ )
+        { cmd[1 + addr - span_first] = REG_SHADOW(addr); }
+
+    KD_TRACE_BEGIN(REGISTER_WRITE);
+    rstatus = kd_write_peripheral_register(dev, cmd, ( span_last - span_first + 2 ));
+    KD_TRACE_END(REGISTER_WRITE);
+
+    if ( rstatus == ROUTINE_OK )
+    {
+        for ( addr = span_first; addr <= span_last; addr++ )
+            { iis2dh_register_cache_note_on_sensor(&iis2dh_register_shadow, addr, cmd[1 + addr - span_first]); }
+    }
+    register_block_write_count++;
+    REG_SHADOW_UNLOCK();
+
+    return rstatus;
+}
+
+
+
+static uint32_t iis2dh_write_ctrl_register_block(const struct device *dev)
+{
+    return iis2dh_write_dirty_registers(dev, IIS2DH_CTRL_REG1, IIS2DH_CTRL_REG6);
+}
+
+
+
+// Single register write, skipped when sensor is known to hold value already:
+static uint32_t iis2dh_write_register(const struct device *dev, const uint8_t register_addr, const uint8_t value)
+{
+    uint32_t rstatus = ROUTINE_OK;
+
+    REG_SHADOW_LOCK();
+    REG_SHADOW_SET(register_addr, value);
+    rstatus = iis2dh_write_dirty_registers(dev, register_addr, register_addr);
+    REG_SHADOW_UNLOCK();
+
+    return rstatus;
+}
+
+
+
+#if KD_DEV__IIS2DH_ASYNC_FIFO_DRAIN == 1
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Note:  called from I2C driver interrupt context when transfer
+ *   started by fifo_drain_submit() completes, or from system work
+ *   queue in emulator test builds.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+static void fifo_drain_complete(const struct device *bus, int result, void *data)
+{
+#if KD_DEV__TRACE_POINTS_ENABLED == 1
+    kd_trace_record(KD_TRACE_SPAN__FIFO_DRAIN, ( k_cycle_get_32() - fifo_drain_started_at ));
+#endif
+    fifo_drain_transfer_status = result;
+    k_sem_give(&iis2dh_fifo_drain_semaphore);
+// Cleared last, so a late give is wiped by k_sem_reset() of next drain:
+    atomic_clear(&fifo_drain_in_flight);
+}
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Start auto-increment read of triplet_count readings from
+ *           OUT_X_L into buffer, returning while transfer in flight.
+ *           Bus drivers without callback support, e.g. i2c-emul on
+ *           native_posix, do the transfer here before returning, except
+ *           in test builds which defer it through emulator.  When
+ *           this routine returns ROUTINE_OK caller must wait on
+ *           fifo_drain_wait() before touching buffer.
+ *
+ *  @Note    A drain which timed out may still be writing its buffer
+ *           and reading static messages below, so no new drain starts
+ *           until its callback runs.  KD__IIS2DH_FIFO_DRAIN_BUSY then.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+static uint32_t fifo_drain_submit(const struct device *dev, uint8_t* buffer, const uint32_t triplet_count)
+{
+// Messages and register address must outlive this call, transfer still reads them:
+    static uint8_t drain_register_addr = ( IIS2DH_I2C_AUTO_INCREMENT | IIS2DH_OUT_X_L );
+    static struct i2c_msg drain_msgs[2];
+    int rstatus = 0;
+
+    if ( !atomic_cas(&fifo_drain_in_flight, 0, 1) )
+        { return KD__IIS2DH_FIFO_DRAIN_BUSY; }
+
+    drain_msgs[0].buf = &drain_register_addr;
+    drain_msgs[0].len = 1;
+    drain_msgs[0].flags = I2C_MSG_WRITE;
+
+    drain_msgs[1].buf = buffer;
+    drain_msgs[1].len = ( BYTES_PER_XYZ_READINGS_TRIPLET * triplet_count );
+    drain_msgs[1].flags = ( I2C_MSG_RESTART | I2C_MSG_READ | I2C_MSG_STOP );
+
+    k_sem_reset(&iis2dh_fifo_drain_semaphore);
+#if KD_DEV__TRACE_POINTS_ENABLED == 1
+    fifo_drain_started_at = k_cycle_get_32();
+#endif
+
+#ifdef CONFIG_I2C_CALLBACK
+#if KD_TEST__EMUL_ASYNC_FIFO_DRAIN == 1
+    rstatus = emul_iis2dh_transfer_cb(iis2dh_i2c.bus, drain_msgs, 2, iis2dh_i2c.addr, fifo_drain_complete, NULL);
+#else
+    rstatus = i2c_transfer_cb(iis2dh_i2c.bus, drain_msgs, 2, iis2dh_i2c.addr, fifo_drain_complete, NULL);
+#endif
+    if ( rstatus == 0 )
+        { return ROUTINE_OK; }
+    if ( rstatus != -ENOSYS )
+    {
+        atomic_clear(&fifo_drain_in_flight);
+        return KD__IIS2DH_FIFO_DRAIN_FAILED;
+    }
+#endif
+    rstatus = i2c_transfer_dt(&iis2dh_i2c, drain_msgs, 2);
+
+// Blocking transfer is complete either way, only a good one counts as drained:
+    fifo_drain_complete(NULL, rstatus, NULL);
+    return ( rstatus == 0 ? ROUTINE_OK : KD__IIS2DH_FIFO_DRAIN_FAILED );
+}
+
+
+
+static uint32_t fifo_drain_wait(void)
+{
+    if ( k_sem_take(&iis2dh_fifo_drain_semaphore, K_MSEC(FIFO_DRAIN_TIMEOUT_MS)) != 0 )
+    {
+// Transfer still owns buffer, fifo_drain_submit() refuses new drains until it ends:
+        fifo_drain_timeout_count++;
+        return KD__IIS2DH_FIFO_DRAIN_TIMEOUT;
+    }
+
+    if ( fifo_drain_transfer_status != 0 )
+        { return KD__IIS2DH_FIFO_DRAIN_FAILED; }
+
+    return ROUTINE_OK;
+}
+#endif // KD_DEV__IIS2DH_ASYNC_FIFO_DRAIN
+
+
+
 #if 0
 static uint32_t read_of_iis2dh_whoami_register(const struct device *dev, struct sensor_value value)
 {
@@ -416,42 +799,35 @@ static uint32_t read_of_iis2dh_whoami_register(const struct device *dev, struct
 static uint32_t configure_iis2dh_temperature_enable(const struct device *dev)
 {
     uint32_t rstatus = ROUTINE_OK;
-    uint8_t cmd[] = { 0, 0, 0 };
 //    struct iis2dh_data *device_data_ptr = (struct iis2dh_data *)dev->data;
 
+    REG_SHADOW_LOCK();
+
 #define DEV_TEMPERATURE_READINGS 1
 #if DEV_TEMPERATURE_READINGS == 1
-// iis2dh_temp_cfg_reg
-// iis2dh_ctrl_reg4
-    cmd[0] = TEMP_CONFIG_REGISTER;
-    rstatus |= kd_read_peripheral_register(dev, cmd, &iis2dh_temp_cfg_reg, COUNT_BYTES_IN_IIS2DH_CONTROL_REGISTER);
-    printk("- DEV 1117 - top of routine before config TEMP_CONFIG_REGISTER holds %u,\n",
-      iis2dh_temp_cfg_reg);
+    printk("- DEV 1117 - top of routine before config TEMP_CONFIG_REGISTER shadow holds %u,\n",
+      REG_SHADOW(TEMP_CONFIG_REGISTER));
 #endif
 
-    cmd[0] = TEMP_CONFIG_REGISTER;
-    iis2dh_temp_cfg_reg = ( TEMP_ENABLE_1 | TEMP_ENABLE_0 );
-    cmd[1] = iis2dh_temp_cfg_reg;
-    rstatus |= kd_write_peripheral_register(dev, cmd, 2);
+    REG_SHADOW_SET(TEMP_CONFIG_REGISTER, ( TEMP_ENABLE_1 | TEMP_ENABLE_0 ));
+    rstatus |= iis2dh_write_dirty_registers(dev, TEMP_CONFIG_REGISTER, TEMP_CONFIG_REGISTER);
 #if DEV_TEMPERATURE_READINGS == 1
     printk("- DEV 1117 - after config TEMP_CONFIG_REGISTER holds %u,\n",
-      iis2dh_temp_cfg_reg);
+      REG_SHADOW(TEMP_CONFIG_REGISTER));
 #endif
 
-    cmd[0] = IIS2DH_CTRL_REG4;
-// NEED to read control register 4 . . .
-    rstatus |= kd_read_peripheral_register(dev, cmd, &iis2dh_ctrl_reg4, COUNT_BYTES_IN_IIS2DH_CONTROL_REGISTER);
+// Control register 4 shadow holds what sensor last received, no need to read it back:
 #if DEV_TEMPERATURE_READINGS == 1
     printk("- DEV 1117 - before config IIS2DH_CTRL_REG4 holds %u,\n",
-      iis2dh_ctrl_reg4);
+      REG_SHADOW(IIS2DH_CTRL_REG4));
 #endif
-    iis2dh_ctrl_reg4 |= BLOCK_DATA_UPDATE_NON_CONTINUOUS;
-    cmd[1] = iis2dh_ctrl_reg4;
+    REG_SHADOW_SET(IIS2DH_CTRL_REG4, ( REG_SHADOW(IIS2DH_CTRL_REG4) | BLOCK_DATA_UPDATE_NON_CONTINUOUS ));
 #if DEV_TEMPERATURE_READINGS == 1
     printk("- DEV 1117 - after config IIS2DH_CTRL_REG4 holds %u,\n",
-      iis2dh_ctrl_reg4);
+      REG_SHADOW(IIS2DH_CTRL_REG4));
 #endif
-    rstatus |= kd_write_peripheral_register(dev, cmd, 2);
+    rstatus |= iis2dh_write_ctrl_register_block(dev);
+    REG_SHADOW_UNLOCK();
 
     return rstatus;
 }
@@ -463,29 +839,23 @@ static uint32_t read_of_iis2dh_temperature_registers(const struct device *dev, s
     uint32_t rstatus = ROUTINE_OK;
 //    uint8_t cmd[] = { OUT_TEMP_L };
     uint8_t cmd[] = { 0, 0 };
-    struct iis2dh_data *device_data_ptr = (struct iis2dh_data *)dev->data;
     uint8_t scratch_pad_bytes[] = {0, 0};
 
     char lbuf[DEFAULT_MESSAGE_SIZE];
 
 #if KD_DEV__SET_BDU_BEFORE_TEMP_READING_THEN_UNSET == 1
-    cmd[0] = IIS2DH_CTRL_REG4;
-    printk("- DEV 1117 - reading iis2dh control register %u . . .\n", IIS2DH_CTRL_REG4);
-    rstatus |= kd_read_peripheral_register(dev, cmd, &iis2dh_ctrl_reg4, COUNT_BYTES_IN_IIS2DH_CONTROL_REGISTER);
-
-    iis2dh_ctrl_reg4 |= BLOCK_DATA_UPDATE_NON_CONTINUOUS;
-    printk("- DEV 1117 - setting iis2dh control register 4 to %u,\n", iis2dh_ctrl_reg4);
-    cmd[1] = iis2dh_ctrl_reg4;
-    rstatus |= kd_write_peripheral_register(dev, cmd, 2);  // magic number '2' here refers to reg' addr and value to write
+    REG_SHADOW_LOCK();
+    REG_SHADOW_SET(IIS2DH_CTRL_REG4, ( REG_SHADOW(IIS2DH_CTRL_REG4) | BLOCK_DATA_UPDATE_NON_CONTINUOUS ));
+    printk("- DEV 1117 - setting iis2dh control register 4 to %u,\n", REG_SHADOW(IIS2DH_CTRL_REG4));
+    rstatus |= iis2dh_write_ctrl_register_block(dev);
+    REG_SHADOW_UNLOCK();
 #endif
 
-#ifdef DEV_1110
-    rstatus = i2c_write_read(device_data_ptr->bus,   // data_struc_ptr->i2c_dev,
-                             DT_INST_REG_ADDR(0),
-                             cmd, 1,
-                             &scratch_pad_bytes, 2
-                            );
-#endif
+    cmd[0] = ( IIS2DH_I2C_AUTO_INCREMENT | OUT_TEMP_L );
+    rstatus = i2c_write_read_dt(&iis2dh_i2c,
+                                cmd, 1,
+                                &scratch_pad_bytes, 2
+                               );
 
     value->val1 = ((scratch_pad_bytes[0] << 8) | scratch_pad_bytes[0]);
 
@@ -494,16 +864,83 @@ static uint32_t read_of_iis2dh_temperature_registers(const struct device *dev, s
     dmsg(lbuf, DIAG_NORMAL);
 
 #if KD_DEV__SET_BDU_BEFORE_TEMP_READING_THEN_UNSET == 1
-    iis2dh_ctrl_reg4 &= ~(BLOCK_DATA_UPDATE_NON_CONTINUOUS);
-    printk("- DEV 1117 - setting iis2dh control register 4 to %u after temperature reading,\n", iis2dh_ctrl_reg4);
-    cmd[1] = iis2dh_ctrl_reg4;
-    rstatus |= kd_write_peripheral_register(dev, cmd, 2);  // magic number '2' here refers to reg' addr and value to write
+    REG_SHADOW_LOCK();
+    REG_SHADOW_SET(IIS2DH_CTRL_REG4, ( REG_SHADOW(IIS2DH_CTRL_REG4) & ~(BLOCK_DATA_UPDATE_NON_CONTINUOUS) ));
+    printk("- DEV 1117 - setting iis2dh control register 4 to %u after temperature reading,\n", REG_SHADOW(IIS2DH_CTRL_REG4));
+    rstatus |= iis2dh_write_ctrl_register_block(dev);
+    REG_SHADOW_UNLOCK();
 #endif
 
     return rstatus;
 }
 
 
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Answer requests queued on temperature request channel with
+ *           one reading published on temperature channel.  Requests
+ *           queued together share that reading.  Runs on this thread,
+ *           between FIFO drains, so temperature reads never contend
+ *           with readings for the bus.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+static uint32_t service_temperature_requests(const struct device *dev)
+{
+    uint32_t rstatus = ROUTINE_OK;
+    const struct temperature_request* request = NULL;
+    struct temperature_reading* reading = NULL;
+    uint32_t requests = 0;
+    uint8_t temperature_two_comp[2] = { 0, 0 };
+    uint8_t peripheral_register_addr;
+
+    while ( kd_channel_receive(&iis2dh_temperature_request_subscriber, (const void**)&request, K_NO_WAIT) == ROUTINE_OK )
+    {
+        kd_channel_release(request);
+        requests++;
+    }
+
+    if ( requests == 0 )
+        { return rstatus; }
+
+    peripheral_register_addr = OUT_TEMP_L;
+    rstatus = kd_read_peripheral_register(
+                                           dev,
+                                           &peripheral_register_addr,
+                                           &temperature_two_comp[1],
+                                           1 
+                                         );
+
+    peripheral_register_addr = OUT_TEMP_H;
+    rstatus |= kd_read_peripheral_register(
+                                            dev,
+                                            &peripheral_register_addr,
+                                            &temperature_two_comp[0],
+                                            1 
+                                          );
+
+    if ( rstatus != ROUTINE_OK )
+    {
+        DMSG(THREAD_IIS2DH, KD_DIAG_WARNINGS, "temperature read failed, %u requests unanswered", requests);
+        return rstatus;
+    }
+
+    reading = kd_channel_claim(&temperature_channel, K_NO_WAIT);
+    if ( reading != NULL )
+    {
+        reading->timestamp = k_cycle_get_32();
+        reading->relative_degrees_c = (int8_t)temperature_two_comp[0];
+        kd_channel_publish(reading);
+    }
+
+    DMSG(THREAD_IIS2DH, KD_DIAG_INFO, "temperature OUT_TEMP_H %u, OUT_TEMP_L %u, for %u requests",
+      temperature_two_comp[0], temperature_two_comp[1], requests);
+
+    return rstatus;
+}
+
+
+
 /*
  *  @Note:  this routine returns an 8-bit register value to caller.
  */
@@ -512,16 +949,12 @@ static uint8_t read_of_iis2dh_acc_status_register(const struct device *dev)
 {
     int status = ROUTINE_OK;
     uint8_t cmd[] = { IIS2DH_STATUS_REG };
-    struct iis2dh_data *device_data_ptr = (struct iis2dh_data *)dev->data;
     uint8_t acc_status_register_value = 0;
 
-#ifdef DEV_1110
-    status = i2c_write_read(device_data_ptr->bus,
-                            DT_INST_REG_ADDR(0),
-                            cmd, sizeof(cmd),
-                            &acc_status_register_value, 1
-                           );
-#endif
+    status = i2c_write_read_dt(&iis2dh_i2c,
+                               cmd, sizeof(cmd),
+                               &acc_status_register_value, 1
+                              );
 
     return acc_status_register_value;
 }
@@ -533,16 +966,12 @@ static uint8_t read_of_iis2dh_acc_fifo_src_register(const struct device *dev)
 {
     int status = ROUTINE_OK;
     uint8_t cmd[] = { IIS2DH_FIFO_SRC_REG };
-    struct iis2dh_data *device_data_ptr = (struct iis2dh_data *)dev->data;
     uint8_t acc_fifo_src_register_value = 0;
 
-#ifdef DEV_1110
-    status = i2c_write_read(device_data_ptr->bus,
-                            DT_INST_REG_ADDR(0),
-                            cmd, sizeof(cmd),
-                            &acc_fifo_src_register_value, 1
-                           );
-#endif
+    status = i2c_write_read_dt(&iis2dh_i2c,
+                               cmd, sizeof(cmd),
+                               &acc_fifo_src_register_value, 1
+                              );
 
     return acc_fifo_src_register_value;
 }
@@ -568,44 +997,37 @@ static uint32_t accelerator_start_acquisition_no_fifo(const struct device* dev,
 // (1) Disable IIS2DH FIFO:
 // [ REBOOT | FIFO_EN |   --   |   --   | LIR_INT1 | D4D_INT1 | LIR_INT2 | D4D_INT2 ]  <-- IIS2DH_CTRL_REG5
 
-    cmd[0] = IIS2DH_CTRL_REG5;
-    iis2dh_ctrl_reg5 &= ~(FIFO_ENABLE);
-    cmd[1] = iis2dh_ctrl_reg5;
-    rstatus |= kd_write_peripheral_register(dev, cmd, 2);  // magic number '2' here refers to reg' addr and value to write
+    REG_SHADOW_SET(IIS2DH_CTRL_REG5, ( REG_SHADOW(IIS2DH_CTRL_REG5) & ~(FIFO_ENABLE) ));
+    rstatus |= iis2dh_write_ctrl_register_block(dev);
 
 // (2) Reset FIFO by briefly setting bypass mode:
 // [   FM1  |   FM0   |   TR   |  FTH4  |   FTH3   |   FTH2   |   FTH1   |   FTH0   ]  <-- IIS2DH_FIFO_CTRL_REG
 
-    cmd[0] = IIS2DH_FIFO_CTRL_REG;
-    cmd[1] = FIFO_MODE_BYPASS; 
-    rstatus |= kd_write_peripheral_register(dev, cmd, 2);
+    rstatus |= iis2dh_write_register(dev, IIS2DH_FIFO_CTRL_REG, FIFO_MODE_BYPASS);
 
 // (3) Set full scale (+/- 2g, 4g, 8g, 16g), normal versus high resolution, block update mode:
 // [   BDU  |   BLE   |   FS1  |   FS0  |    HR    |    ST1   |    ST0   |    SIM   ]  <-- IIS2DH_CTRL_REG4
 
-    cmd[0] = IIS2DH_CTRL_REG4;
-    cmd[1] = ( 
+    REG_SHADOW_SET(IIS2DH_CTRL_REG4, ( 
                BLOCK_DATA_UPDATE_NON_CONTINUOUS         //
              | BLE_LSB_IN_LOWER_BYTE_IN_HIGH_RES_MODE   // BLE Big | Little Endian high res readings storage
              | ACC_FULL_SCALE_2G                        // 2G, 4G, 8G, 16G
-             | POWER_MODE                               // low power, normal, high-resolution modes (see table 9 for cross reg' mut exc setting)
+             | HIGH_RESOLUTION_MODE                     // low power, normal, high-resolution modes (see table 9 for cross reg' mut exc setting)
              | IIS2DH_SELF_TEST_NORMAL_MODE             // normal (no test), test 0, test 1
              | SPI_MODE_THREE_WIRE                      // 3-wire | 4-wire
-             );
-    rstatus |= kd_write_peripheral_register(dev, cmd, 2);
+             ));
 
 // (4) Set data rate, enable accelerometer axes x, y, z:
 // [  ODR3  |   ODR2  |  ODR1  |  ODR1  |   LPEN   |    ZEN   |    YEN   |    XEN   ]  <-- IIS2DH_CTRL_REG1
 
-    cmd[0] = IIS2DH_CTRL_REG1;
-    cmd[1] = (
+    REG_SHADOW_SET(IIS2DH_CTRL_REG1, (
                output_data_rate                         //
              | LOW_POWER_ENABLE                         // when low power enabled, high resolution readings not available.  iis2dh.pdf page 16.
              | AXIS_Z_ENABLE
              | AXIS_Y_ENABLE
              | AXIS_X_ENABLE
-             );
-    rstatus |= kd_write_peripheral_register(dev, cmd, 2);
+             ));
+    rstatus |= iis2dh_write_ctrl_register_block(dev);
 
 // Note, we could configure high pass filter here.
 // Note, we could configure FIFO operation mode here.
@@ -626,110 +1048,139 @@ static uint32_t accelerator_start_acquisition_no_fifo(const struct device* dev,
 
 
 
-static uint32_t accelerator_start_acquisition_with_fifo(const struct device* dev, const uint8_t output_data_rate)
+#if KD_DEV__IIS2DH_FIFO_WATERMARK_INTERRUPT_ENABLED == 1
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Note:  runs in interrupt context, so only counts the event and
+ *   wakes the IIS2DH thread.  FIFO drain takes place in thread.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+static void iis2dh_int1_gpio_callback(const struct device *port, struct gpio_callback *cb, uint32_t pins)
 {
-    uint8_t cmd[] = { 0, 0, 0 };
-    uint8_t register_value = 0;
-    uint32_t rstatus = 0;  // status of this routine, OR'd sum of register read and write calls
+    fifo_watermark_interrupt_count++;
+    k_sem_give(&iis2dh_fifo_watermark_semaphore);
+}
 
-#if KD_DEV__CONFIG_REGISTERS_SUMMARY_ENABLED == 1
-    snprintf(registers_iis2dh[0].name, REGISTER_NAME_SIZE, "%s", "IIS2DH_CTRL_REG5");
-    snprintf(registers_iis2dh[1].name, REGISTER_NAME_SIZE, "%s", "IIS2DH_FIFO_CTRL_REG");
-    snprintf(registers_iis2dh[2].name, REGISTER_NAME_SIZE, "%s", "IIS2DH_CTRL_REG4");
-    snprintf(registers_iis2dh[3].name, REGISTER_NAME_SIZE, "%s", "IIS2DH_CTRL_REG1");
-#endif
 
 
-// Prepare accelerometer for data acquisition without FIFO:
+static uint32_t configure_iis2dh_int1_gpio_interrupt(void)
+{
+    int rstatus = ROUTINE_OK;
 
-// (1) Disable IIS2DH FIFO:
+    if ( iis2dh_int1_gpio.port == NULL )
+    {
+        return KD__IIS2DH_INT1_GPIO_NOT_IN_DEVICETREE;
+    }
+
+    if ( !device_is_ready(iis2dh_int1_gpio.port) )
+    {
+        return KD__IIS2DH_INT1_GPIO_PORT_NOT_READY;
+    }
+
+    rstatus = gpio_pin_configure_dt(&iis2dh_int1_gpio, GPIO_INPUT);
+    if ( rstatus != 0 )
+    {
+        return KD__IIS2DH_INT1_GPIO_CONFIG_FAILED;
+    }
+
+    gpio_init_callback(&iis2dh_int1_gpio_callback_data, iis2dh_int1_gpio_callback, BIT(iis2dh_int1_gpio.pin));
+    rstatus = gpio_add_callback(iis2dh_int1_gpio.port, &iis2dh_int1_gpio_callback_data);
+
+// IIS2DH holds INT1 active while FIFO level at or above watermark, so rising edge marks each threshold crossing:
+    rstatus |= gpio_pin_interrupt_configure_dt(&iis2dh_int1_gpio, GPIO_INT_EDGE_TO_ACTIVE);
+    if ( rstatus != 0 )
+    {
+        return KD__IIS2DH_INT1_GPIO_CONFIG_FAILED;
+    }
+
+    return ROUTINE_OK;
+}
+#endif // KD_DEV__IIS2DH_FIFO_WATERMARK_INTERRUPT_ENABLED
+
+
+
+static uint32_t accelerator_start_acquisition_with_fifo(const struct device* dev, const uint8_t output_data_rate)
+{
+    uint32_t rstatus = 0;  // status of this routine, OR'd sum of register read and write calls
+
+// Steps below build one configuration, keep other threads out of shadow until sent:
+    REG_SHADOW_LOCK();
+
+// (1) Disable IIS2DH FIFO, a one register block write when sensor already configured:
 // [ REBOOT | FIFO_EN |   --   |   --   | LIR_INT1 | D4D_INT1 | LIR_INT2 | D4D_INT2 ]  <-- IIS2DH_CTRL_REG5
 
-    cmd[0] = IIS2DH_CTRL_REG5;
-    iis2dh_ctrl_reg5 &= ~(FIFO_ENABLE);
-    cmd[1] = iis2dh_ctrl_reg5;
-#if KD_DEV__CONFIG_REGISTERS_SUMMARY_ENABLED == 1
-    registers_iis2dh[0].value_latest = cmd[1];
-#endif
-    rstatus |= kd_write_peripheral_register(dev, cmd, 2);  // magic number '2' here refers to reg' addr and value to write
+    REG_SHADOW_SET(IIS2DH_CTRL_REG5, ( REG_SHADOW(IIS2DH_CTRL_REG5) & ~(FIFO_ENABLE) ));
+    rstatus |= iis2dh_write_ctrl_register_block(dev);
 
 // (2) Reset FIFO by briefly setting bypass mode:
 // [   FM1  |   FM0   |   TR   |  FTH4  |   FTH3   |   FTH2   |   FTH1   |   FTH0   ]  <-- IIS2DH_FIFO_CTRL_REG
 
-    cmd[0] = IIS2DH_FIFO_CTRL_REG;
-    cmd[1] = FIFO_MODE_BYPASS; 
-#if KD_DEV__CONFIG_REGISTERS_SUMMARY_ENABLED == 1
-    registers_iis2dh[1].value_latest = cmd[1];
-#endif
-    rstatus |= kd_write_peripheral_register(dev, cmd, 2);
-
-// (3) Set full scale (+/- 2g, 4g, 8g, 16g), normal versus high resolution, block update mode:
-// [   BDU  |   BLE   |   FS1  |   FS0  |    HR    |    ST1   |    ST0   |    SIM   ]  <-- IIS2DH_CTRL_REG4
+    rstatus |= iis2dh_write_register(dev, IIS2DH_FIFO_CTRL_REG, FIFO_MODE_BYPASS);
 
-    cmd[0] = IIS2DH_CTRL_REG4;
-    cmd[1] = ( 
-               BLOCK_DATA_UPDATE_NON_CONTINUOUS         //
-             | BLE_LSB_IN_LOWER_BYTE_IN_HIGH_RES_MODE   // BLE Big | Little Endian high res readings storage
-             | ACC_FULL_SCALE_2G                        // 2G, 4G, 8G, 16G
-             | POWER_MODE                               // low power, normal, high-resolution modes (see table 9 for cross reg' mut exc setting)
-             | IIS2DH_SELF_TEST_NORMAL_MODE             // normal (no test), test 0, test 1
-             | SPI_MODE_THREE_WIRE                      // 3-wire | 4-wire
-             );
-#if KD_DEV__CONFIG_REGISTERS_SUMMARY_ENABLED == 1
-    registers_iis2dh[2].value_latest = cmd[1];
+// (3) Set FIFO mode to stream, and FIFO trigger threshhold, while FIFO still disabled:
+    rstatus |= iis2dh_write_register(dev, IIS2DH_FIFO_CTRL_REG, ( 
+               FIFO_MODE_STREAM                         // see iis2dh.pdf table 48
+             | FIFO_TRIGGER_ON_INT_1 
+#if KD_DEV__IIS2DH_FIFO_WATERMARK_INTERRUPT_ENABLED == 1
+             | ( KD_APP_IIS2DH_FIFO_WATERMARK_LEVEL & FIFO_TRIGGER_THRESHHOLD_MASK )
+#else
+             | FIFO_TRIGGER_THRESHHOLD
 #endif
-    rstatus |= kd_write_peripheral_register(dev, cmd, 2);
+             ));
+
+// Steps (4) through (7) only update shadow copies, step (8) sends them in one burst.
 
 // (4) Set data rate, enable accelerometer axes x, y, z:
 // [  ODR3  |   ODR2  |  ODR1  |  ODR1  |   LPEN   |    ZEN   |    YEN   |    XEN   ]  <-- IIS2DH_CTRL_REG1
 
-    cmd[0] = IIS2DH_CTRL_REG1;
-    cmd[1] = (
+    REG_SHADOW_SET(IIS2DH_CTRL_REG1, (
                output_data_rate                         //
              | LOW_POWER_ENABLE                         // when low power enabled, high resolution readings not available.  iis2dh.pdf page 16.
              | AXIS_Z_ENABLE
              | AXIS_Y_ENABLE
              | AXIS_X_ENABLE
-             );
-#if KD_DEV__CONFIG_REGISTERS_SUMMARY_ENABLED == 1
-    registers_iis2dh[3].value_latest = cmd[1];
-#endif
-    rstatus |= kd_write_peripheral_register(dev, cmd, 2);
+             ));
 
-// Note, we could configure high pass filter here.
+// Note, we could configure high pass filter here in CTRL_REG2.
 
-// (6) Set FIFO mode to stream, and FIFO trigger threshhold:
-    cmd[0] = IIS2DH_FIFO_CTRL_REG;
-    cmd[1] = ( 
-               FIFO_MODE_STREAM                         // see iis2dh.pdf table 48
-             | FIFO_TRIGGER_ON_INT_1 
-             | FIFO_TRIGGER_THRESHHOLD
-             );
-    rstatus |= kd_write_peripheral_register(dev, cmd, 2);
+// (5) Route FIFO watermark event to INT1 pin, when that pin is wired to MCU:
+// [ I1_CLICK | I1_IA1 | I1_IA2 | I1_ZYXDA | I1_321DA | I1_WTM | I1_OVERRUN |   --   ]  <-- IIS2DH_CTRL_REG3
 
+#if KD_DEV__IIS2DH_FIFO_WATERMARK_INTERRUPT_ENABLED == 1
+    if ( flag_watermark_interrupt_armed )
+    {
+        REG_SHADOW_SET(IIS2DH_CTRL_REG3, ( REG_SHADOW(IIS2DH_CTRL_REG3) | FIFO_WATERMARK_INTERRUPT_ON_INT1_ENABLE ));
+    }
+#endif
 
-// Note, we could configure one or more interrupts here.
+// (6) Set full scale (+/- 2g, 4g, 8g, 16g), normal versus high resolution, block update mode:
+// [   BDU  |   BLE   |   FS1  |   FS0  |    HR    |    ST1   |    ST0   |    SIM   ]  <-- IIS2DH_CTRL_REG4
 
-// Whether using interrupts or not we'll clear them here per example code:
-    cmd[0] = IIS2DH_CTRL_REG3;
-    cmd[1] = 0;
-    rstatus |= kd_read_peripheral_register(dev, cmd, &register_value, COUNT_BYTES_IN_IIS2DH_CONTROL_REGISTER);
-    printk("Clearing any interrupts we read from CTRL_REG3:  %u\n", register_value);
+    REG_SHADOW_SET(IIS2DH_CTRL_REG4, ( 
+               BLOCK_DATA_UPDATE_NON_CONTINUOUS         //
+             | BLE_LSB_IN_LOWER_BYTE_IN_HIGH_RES_MODE   // BLE Big | Little Endian high res readings storage
+             | ACC_FULL_SCALE_2G                        // 2G, 4G, 8G, 16G
+             | HIGH_RESOLUTION_MODE                     // low power, normal, high-resolution modes (see table 9 for cross reg' mut exc setting)
+             | IIS2DH_SELF_TEST_NORMAL_MODE             // normal (no test), test 0, test 1
+             | SPI_MODE_THREE_WIRE                      // 3-wire | 4-wire
+             ));
 
-// (9) Enable FIFO:
-    cmd[0] = IIS2DH_CTRL_REG5;
-    iis2dh_ctrl_reg5 |= FIFO_ENABLE;
-//printk("-- DEV006 -- control register 5 shadow holds 0x%02X, should be decimal 64.\n", iis2dh_ctrl_reg5);
-    cmd[1] = iis2dh_ctrl_reg5;
-#if KD_DEV__CONFIG_REGISTERS_SUMMARY_ENABLED == 1
-    registers_iis2dh[0].value_latest = cmd[1];
-#endif
-    rstatus |= kd_write_peripheral_register(dev, cmd, 2);
+// (7) Enable FIFO:
+    REG_SHADOW_SET(IIS2DH_CTRL_REG5, ( REG_SHADOW(IIS2DH_CTRL_REG5) | FIFO_ENABLE ));
+
+// (8) Send changed control registers, CTRL_REG1 first and CTRL_REG5 last:
+    rstatus |= iis2dh_write_ctrl_register_block(dev);
+
+// Readings consumers scale by this range and resolution:
+    scoreboard__set_IIS2DH_CTRL_REG4_full_scale_config_bits( ( REG_SHADOW(IIS2DH_CTRL_REG4) & ACC_FULL_SCALE_MASK ) );
+    refresh_milli_g_scale();
 
 
 #if KD_DEV__CONFIG_REGISTERS_SUMMARY_ENABLED == 1
     register_summary();
 #endif
+    REG_SHADOW_UNLOCK();
 
     return rstatus;
 
@@ -739,48 +1190,84 @@ static uint32_t accelerator_start_acquisition_with_fifo(const struct device* dev
 
 static uint32_t ii_accelerometer_stop_acquisition(const struct device *dev)
 {
-    uint8_t cmd[] = { 0, 0, 0 };
-    uint8_t register_value = 0;
     uint32_t rstatus = 0;  // Routine status, combined status of register writes and reads
 
-// (1) Disable IIS2DH FIFO:
-    cmd[0] = IIS2DH_CTRL_REG5;
-    iis2dh_ctrl_reg5 &= ~(FIFO_ENABLE);
-    cmd[1] = iis2dh_ctrl_reg5;
-    rstatus |= kd_write_peripheral_register(dev, cmd, 2);
+    REG_SHADOW_LOCK();
 
-// (2) Reset IIS2DH FIFO by briefly setting bypass mode:
-    cmd[0] = IIS2DH_FIFO_CTRL_REG;
-    cmd[1] = FIFO_MODE_BYPASS; 
-    rstatus |= kd_write_peripheral_register(dev, cmd, 2);
+// (1) Disable data rate (power down mode):
+    REG_SHADOW_SET(IIS2DH_CTRL_REG1, ( (ODR_0_POWERED_DOWN | LOW_POWER_ENABLE) & (~(AXIS_Z_ENABLE)) & (~(AXIS_Y_ENABLE)) & (~(AXIS_X_ENABLE))));
 
-// (3) Disable FIFO watermark reached and FIFO overrun interrupts:
-    cmd[0] = IIS2DH_CTRL_REG3;
-    iis2dh_ctrl_reg3 &= ~(FIFO_WATERMARK_INTERRUPT_ON_INT1_ENABLE);
-    iis2dh_ctrl_reg3 &= ~(FIFO_OVERRUN_INTERRUPT_ON_INT1_ENABLE);
-    cmd[1] = iis2dh_ctrl_reg3;
-    rstatus |= kd_write_peripheral_register(dev, cmd, 2);
+// (2) Disable FIFO watermark reached and FIFO overrun interrupts:
+    REG_SHADOW_SET(IIS2DH_CTRL_REG3, ( REG_SHADOW(IIS2DH_CTRL_REG3) & ~(FIFO_WATERMARK_INTERRUPT_ON_INT1_ENABLE) ));
+    REG_SHADOW_SET(IIS2DH_CTRL_REG3, ( REG_SHADOW(IIS2DH_CTRL_REG3) & ~(FIFO_OVERRUN_INTERRUPT_ON_INT1_ENABLE) ));
 
-// (4) Clear interrupt by reading interrupt status register:
-    cmd[0] = IIS2DH_CTRL_REG3;
-    cmd[1] = 0;
-//    printk("333 - \n");
-    rstatus |= kd_read_peripheral_register(dev, cmd, &register_value, COUNT_BYTES_IN_IIS2DH_CONTROL_REGISTER);
-//    printk("333 - from IIS2DH register CTRL3 read back %u\n", register_value);
+// (3) Disable IIS2DH FIFO:
+    REG_SHADOW_SET(IIS2DH_CTRL_REG5, ( REG_SHADOW(IIS2DH_CTRL_REG5) & ~(FIFO_ENABLE) ));
+
+// (4) Send above in one burst:
+    rstatus |= iis2dh_write_ctrl_register_block(dev);
 
-// (5) Disable data rate (power down mode)
-    cmd[0] = IIS2DH_CTRL_REG1;
-    cmd[1] = ( (ODR_0_POWERED_DOWN | LOW_POWER_ENABLE) & (~(AXIS_Z_ENABLE)) & (~(AXIS_Y_ENABLE)) & (~(AXIS_X_ENABLE)));
-    rstatus |= kd_write_peripheral_register(dev, cmd, 2);
+// (5) Reset IIS2DH FIFO by briefly setting bypass mode:
+    rstatus |= iis2dh_write_register(dev, IIS2DH_FIFO_CTRL_REG, FIFO_MODE_BYPASS);
+    REG_SHADOW_UNLOCK();
 
-//    printk("333 - combined status of config reg writes and read is %u,\n", rstatus);
-//    printk("333 - returning to caller . . .\n");
     return rstatus;
 
 } // end routine ii_accelerometer_stop_acquisition
 
 
 
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Note:  in streaming acquisition only the ODR bits change at run
+ *   time.  FIFO mode, watermark and interrupt routing stay as set by
+ *   accelerator_start_acquisition_with_fifo(), so FIFO keeps its
+ *   buffered readings across a rate change.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+static uint32_t ii_accelerometer_update_output_data_rate(const struct device *dev, const uint8_t output_data_rate)
+{
+    uint32_t rstatus = ROUTINE_OK;
+
+    REG_SHADOW_LOCK();
+    REG_SHADOW_SET(IIS2DH_CTRL_REG1, ( ( REG_SHADOW(IIS2DH_CTRL_REG1) & 0x0F ) | ( output_data_rate & 0xF0 ) ));
+    rstatus = iis2dh_write_ctrl_register_block(dev);
+    REG_SHADOW_UNLOCK();
+
+    return rstatus;
+}
+
+
+
+/*
+ *  @Brief   Time for FIFO to gather READINGS_PER_FIFO_POLL__IIS2DH_TASK
+ *           readings at given ODR, in milliseconds.
+ */
+
+static uint32_t fifo_poll_period_in_ms(const enum iis2dh_output_data_rates_e output_data_rate)
+{
+// Readings per second, indexed by ODR3:0 of IIS2DH_CTRL_REG1 with low power mode enabled:
+    static const uint32_t odr_in_hz[] = { 0, 1, 10, 25, 50, 100, 200, 400, 1620, 5376 };
+    uint32_t odr_index = ( (uint32_t)output_data_rate >> 4 );
+    uint32_t period_ms = SLEEP_TIME__IIS2DH_TASK__MS;
+
+    if ( ( odr_index > 0 ) && ( odr_index <= HIGHEST_DATA_RATE_INDEX ) )
+    {
+        period_ms = ( ( READINGS_PER_FIFO_POLL__IIS2DH_TASK * 1000 ) / odr_in_hz[odr_index] );
+    }
+
+    if ( period_ms > SLEEP_TIME__IIS2DH_TASK__MS )
+        { period_ms = SLEEP_TIME__IIS2DH_TASK__MS; }
+
+    if ( period_ms == 0 )
+        { period_ms = 1; }
+
+    return period_ms;
+}
+
+
+
 #if 0
 float reading_in_g(const uint32_t reading_in_twos_comp, const uint32_t full_scale, const uint32_t res_in_bits)
 {
@@ -817,12 +1304,21 @@ static uint32_t ii_accelerometer_read_xyz(const struct device *dev)
     uint8_t register_value = 0;
     uint32_t rstatus = 0;  // Routine status, combined status of register writes and reads
 
+#if KD_DEV__IIS2DH_ASYNC_FIFO_DRAIN == 1
+    uint32_t drain_status = ROUTINE_OK;
+#else
 // QUESTION why necessary to logical or this register with 0x80? - TMH
     uint8_t iis2dh_x_axis_low_byte_reg = (0x80 | IIS2DH_OUT_X_L);
-    memset(readings_data, 0, sizeof(readings_data));
+#endif
     uint8_t source = 0;
     uint8_t count = 0;
+    uint8_t readings_in_fifo = 0;
+    uint32_t readings_unpacked = 0;
     int i = 0;
+#if KD_DEV__IIS2DH_PRINTK_EACH_READING == 1
+    static struct acc_reading_triplet_milli_g readings_block_in_milli_g[(FIFO_READINGS_MAXIMUM_COUNT - 1)];
+#endif
+    KD_TRACE_BEGIN(FIFO_SERVICE);
 // -- VAR END ---
 
 // IIS2DH_FIFO_SRC_REG
@@ -831,59 +1327,107 @@ static uint32_t ii_accelerometer_read_xyz(const struct device *dev)
 // (1) Query for present FIFO level and overrun status flag:
     cmd[0] = IIS2DH_FIFO_SRC_REG;
     cmd[1] = 0;
-    rstatus |= kd_read_peripheral_register(dev, cmd, &register_value, COUNT_BYTES_IN_IIS2DH_CONTROL_REGISTER_FIFO_SRC);
+    {
+        KD_TRACE_BEGIN(FIFO_SOURCE);
+        rstatus |= kd_read_peripheral_register(dev, cmd, &register_value, COUNT_BYTES_IN_IIS2DH_CONTROL_REGISTER_FIFO_SRC);
+        KD_TRACE_END(FIFO_SOURCE);
+    }
+    source = register_value;
     count = (register_value & FIFO_SRC_FSS_MASK);
+    readings_in_fifo = count;
+#if KD_DEV__IIS2DH_PRINTK_EACH_READING == 1
     printk("222 - IIS2DH FIFO source register holds %u, buffered reading count is %u,\n",
       register_value, count);
+#endif
 
 // Check for FIFO overrun, indicating missed readings:
     if (( source & FIFO_SOURCE_OVERRUN) != 0 )
     {
-#if 1 // TO-DO create development define for this message:
-        printk("- FIFO overrun detected!\n");
-#endif
-        fifo_overrun_events[fifo_overrun_count_fsv].reading_index = running_total_xyz_readings;
-        fifo_overrun_count_fsv++;
+        DMSG(THREAD_IIS2DH, KD_DIAG_WARNINGS, "FIFO overrun detected at reading %u", running_total_xyz_readings);
+        note_fifo_overrun_event(running_total_xyz_readings);
     }
 
 // Check whether FIFO is empty:
     if ( count == 0 )
     {
+// Streaming wake up with nothing buffered, e.g. timeout while sensor powered down:
+        if ( flag_streaming_acquisition )
+        {
+#if KD_DEV__IIS2DH_ASYNC_FIFO_DRAIN == 1
+// No new drain to overlap with, so hand over block still held from last drain:
+            unpack_readings_block(readings_data[(drain_fill_index ^ 1)], drain_pending_count);
+            push_readings_to_sample_ring(readings_block, drain_pending_count, drain_pending_timestamp);
+            drain_pending_count = 0;
+#endif
+            KD_TRACE_END(FIFO_SERVICE);
+            return rstatus;
+        }
         printk("222 - no readings indicated in buffer, but showing 25 readings anyway:\n\n");
         count = 25;
     }
 
-#if 1
-    rstatus |= kd_read_peripheral_register(
-                                            dev,
-                                            &iis2dh_x_axis_low_byte_reg,
-                                            readings_data,
-                                           (BYTES_PER_XYZ_READINGS_TRIPLET * count)
-                                          );
+#if KD_DEV__IIS2DH_ASYNC_FIFO_DRAIN == 1
+// (2) Start drain of this block into one buffer:
+    drain_status = fifo_drain_submit(dev, readings_data[drain_fill_index], count);
+
+// (3) While transfer in flight, unpack block of last drain from other buffer:
+    if ( drain_pending_count > 0 )
+    {
+        unpack_readings_block(readings_data[(drain_fill_index ^ 1)], drain_pending_count);
+        push_readings_to_sample_ring(readings_block, drain_pending_count, drain_pending_timestamp);
+        readings_unpacked = drain_pending_count;
+        drain_pending_count = 0;
+        fifo_drain_overlap_count++;
+    }
+
+// (4) Wait for this drain, its readings are unpacked on next call.  Only
+//  readings the sensor reported as buffered go to consumers:
+    if ( drain_status == ROUTINE_OK )
+        { drain_status = fifo_drain_wait(); }
+
+    if ( drain_status == ROUTINE_OK )
+    {
+        drain_pending_count = readings_in_fifo;
+        drain_pending_timestamp = k_cycle_get_32();
+        drain_fill_index ^= 1;
+    }
+    rstatus |= drain_status;
 #else
-    for ( i = 0; i < count; i += BYTES_PER_XYZ_READINGS_TRIPLET )
     {
-        rstatus |= kd_read_peripheral_register(dev,
-                                           &iis2dh_x_axis_low_byte_reg,
-                                           &readings_data[(i * BYTES_PER_XYZ_READINGS_TRIPLET)],
-                                           BYTES_PER_XYZ_READINGS_TRIPLET
-                                          );
+        KD_TRACE_BEGIN(FIFO_DRAIN);
+        rstatus |= kd_read_peripheral_register(
+                                                dev,
+                                                &iis2dh_x_axis_low_byte_reg,
+                                                readings_data[0],
+                                               (BYTES_PER_XYZ_READINGS_TRIPLET * count)
+                                              );
+        KD_TRACE_END(FIFO_DRAIN);
     }
+
+    unpack_readings_block(readings_data[0], count);
+    readings_unpacked = count;
+
+// Only readings the sensor reported as buffered go to consumers:
+    push_readings_to_sample_ring(readings_block, readings_in_fifo, k_cycle_get_32());
 #endif
 
-    printk("data from %u readings:\n", count);
-    for ( i = 0; i < count; i += BYTES_PER_XYZ_READINGS_TRIPLET )
+#if KD_DEV__IIS2DH_PRINTK_EACH_READING == 1
     {
-        printk(" %02X %02X  %02X %02X  %02X %02X  --  x,y,z in G = %2.3fG, %2.3fG, %2.3fG",
-          readings_data[i + 0],
-          readings_data[i + 1],
-          readings_data[i + 2],
-          readings_data[i + 3],
-          readings_data[i + 4],
-          readings_data[i + 5],
-          reading_in_g((uint32_t)readings_data[i + 1], 0, 0),
-          reading_in_g((uint32_t)readings_data[i + 3], 0, 0),
-          reading_in_g((uint32_t)readings_data[i + 5], 0, 0)
+        KD_TRACE_BEGIN(MILLI_G);
+        readings_to_milli_g(readings_block, readings_block_in_milli_g, readings_unpacked, &milli_g_scale_in_use);
+        KD_TRACE_END(MILLI_G);
+    }
+
+    printk("data from %u readings:\n", readings_unpacked);
+    for ( i = 0; i < readings_unpacked; i++ )
+    {
+        printk(" %04X %04X %04X  --  x,y,z in mg = %6d, %6d, %6d",
+          readings_block[i].x,
+          readings_block[i].y,
+          readings_block[i].z,
+          readings_block_in_milli_g[i].x,
+          readings_block_in_milli_g[i].y,
+          readings_block_in_milli_g[i].z
         );
 
 // 
@@ -899,27 +1443,17 @@ static uint32_t ii_accelerometer_read_xyz(const struct device *dev)
         }
     }
     printk("\n");
+#else
+    (void)readings_unpacked;
+#endif
  
+    KD_TRACE_END(FIFO_SERVICE);
     return rstatus;
 
 } // end routine ii_accelerometer_read_xyz
 
 
 
-void make_references(void)
-{
-#if 0
-    (void)iis2dh_ctrl_reg1;
-    (void)iis2dh_ctrl_reg2;
-    (void)iis2dh_ctrl_reg4;
-    (void)iis2dh_ctrl_reg5;
-    (void)iis2dh_acc_status;
-    (void)iis2dh_fifo_ctrl_reg;
-#endif
-}
-
-
-
 
 //
 //----------------------------------------------------------------------
@@ -956,9 +1490,15 @@ void iis2dh_thread_entry_point(void* arg1, void* arg2, void* arg3)
 //    uint8_t accelerometer_status = 0;
 
     enum iis2dh_output_data_rates_e odr_to_set = ODR_0_POWERED_DOWN;
+    enum iis2dh_output_data_rates_e odr_in_use = KD_APP_DEFAULT_IIS2DH_OUTPUT_DATA_RATE;
+    uint32_t odr_version_seen = 0;
 
 // --- VAR END ---
 
+    REG_SHADOW_LOCK();
+    iis2dh_register_cache_init(&iis2dh_register_shadow);
+    REG_SHADOW_UNLOCK();
+
 
 // Check whether device_get_binding() macro / call succeeded:
     if ( sensor == NULL )
@@ -993,20 +1533,78 @@ void iis2dh_thread_entry_point(void* arg1, void* arg2, void* arg3)
     rc = configure_iis2dh_temperature_enable(sensor);
 #endif
 
+#if KD_DEV__IIS2DH_FIFO_WATERMARK_INTERRUPT_ENABLED == 1
+    rc = configure_iis2dh_int1_gpio_interrupt();
+    if ( rc == ROUTINE_OK )
+    {
+        flag_watermark_interrupt_armed = 1;
+        printk("- %s - FIFO watermark interrupt armed on INT1, level %u readings,\n",
+          MODULE_ID__THREAD_IIS2DH, KD_APP_IIS2DH_FIFO_WATERMARK_LEVEL);
+    }
+    else
+    {
+        printk("- %s - INT1 GPIO unavailable (status %u), polling FIFO instead,\n",
+          MODULE_ID__THREAD_IIS2DH, rc);
+    }
+    flag_streaming_acquisition = ( flag_watermark_interrupt_armed || KD_DEV__IIS2DH_CONTINUOUS_STREAMING );
+#else
+    flag_streaming_acquisition = KD_DEV__IIS2DH_CONTINUOUS_STREAMING;
+#endif
+
+    rc = kd_channel_subscribe(&temperature_request_channel, &iis2dh_temperature_request_subscriber);
+
 //    accelerator_start_acquisition_with_fifo(sensor, ODR_10_HZ);
     accelerator_start_acquisition_with_fifo(sensor, KD_APP_DEFAULT_IIS2DH_OUTPUT_DATA_RATE);
 
     while (1)
     {
+// Streaming acquisition:  sensor configured once above and left running,
+// only CTRL_REG1 rewritten and only when scoreboard holds a new ODR:
+        if ( flag_streaming_acquisition )
+        {
+#if KD_DEV__IIS2DH_FIFO_WATERMARK_INTERRUPT_ENABLED == 1
+            if ( flag_watermark_interrupt_armed )
+            {
+                k_sem_take(&iis2dh_fifo_watermark_semaphore, K_MSEC(WATERMARK_WAIT_TIMEOUT__IIS2DH_TASK__MS));
+            }
+            else
+#endif
+            {
+                k_msleep(fifo_poll_period_in_ms(odr_in_use));
+            }
+
+            rc = ii_accelerometer_read_xyz(sensor);
+            rc = service_temperature_requests(sensor);
+
+// ODR version changes only when a new request is posted, so most passes
+// skip reading value.  Request may repeat present ODR, so compare too:
+            if ( scoreboard__requested_iis2dh_odr_version() != odr_version_seen )
+            {
+                odr_version_seen = scoreboard__requested_iis2dh_odr_version();
+                rc = scoreboard__get_requested_iis2dh_odr(&odr_to_set);
+                if ( odr_to_set != odr_in_use )
+                {
+                    DMSG(THREAD_IIS2DH, KD_DIAG_INFO, "ODR changed from %u to %u", odr_in_use, odr_to_set);
+                    rc = ii_accelerometer_update_output_data_rate(sensor, odr_to_set);
+                    odr_in_use = odr_to_set;
+                }
+            }
+
+            loop_count++;
+            continue;
+        }
+
+
         printk("iis2dh task at loop iteration 0x%08X\n IIS2DH sensor at I2C addr %02X\n",
           loop_count, iis2ds12_i2c_periph_addr);
 
         k_msleep(1);
 
-        iis2dh_fifo_ctrl_reg = read_of_iis2dh_acc_fifo_src_register(sensor);
-        printk("iis2dh FIFO SRC register 0x%02X holds %u,\n", IIS2DH_FIFO_SRC_REG, iis2dh_fifo_ctrl_reg);
+        printk("iis2dh FIFO SRC register 0x%02X holds %u,\n", IIS2DH_FIFO_SRC_REG,
+          read_of_iis2dh_acc_fifo_src_register(sensor));
 
         rc = ii_accelerometer_read_xyz(sensor);
+        rc = service_temperature_requests(sensor);
 
         rc = ii_accelerometer_stop_acquisition(sensor);
 
@@ -1043,64 +1641,57 @@ void iis2dh_thread_entry_point(void* arg1, void* arg2, void* arg3)
 // - SECTION - routines public API
 //----------------------------------------------------------------------
 
-uint32_t on_event__temperature_readings_requested__query_iis2dh(const uint32_t event)
+/*
+ *  @Brief   Sample consumers attach a reader to this ring, then pull
+ *           timestamped raw readings at their own pace.
+ */
+
+struct sample_ring* thread_iis2dh__sample_ring(void)
 {
-    uint32_t rstatus = ROUTINE_OK;
-    uint8_t temperature_two_comp[2] = { 0, 0 };
-    uint8_t peripheral_register_addr;
-    char lbuf[DEFAULT_MESSAGE_SIZE];
-    char temperature_in_binary[BINARY_REPRESENTATION_EIGHT_BITS_AS_STRING + 0];
+    return &iis2dh_sample_ring;
+}
 
-    printk("-\n- DEV 1119-b - ROUTINE FOR TEMPERATURE READING REQUESTED ---\n-\n");
-        scoreboard__update_flag__temperature_reading_requested(CLEAR_FLAG);
 
-    peripheral_register_addr = OUT_TEMP_L;
-    rstatus = kd_read_peripheral_register(
-                                           sensor,
-                                           &peripheral_register_addr,
-                                           &temperature_two_comp[1],
-                                           1 
-                                         );
 
-    peripheral_register_addr = OUT_TEMP_H;
-    rstatus |= kd_read_peripheral_register(
-                                            sensor,
-                                            &peripheral_register_addr,
-                                            &temperature_two_comp[0],
-                                            1 
-                                          );
-
-// Output to default console UART:
-    printk("- read iis2dh temperature in two's compliment equal to %u C\n",
-//      ((temperature_two_comp[0] << 8) + temperature_two_comp[1]));
-      temperature_two_comp[0]);
+/*
+ *  @Brief   Scale to convert raw readings from sample ring to milli-g,
+ *           per resolution and full scale range presently configured.
+ */
 
-    printk("- RO register OUT_TEMP_L holds %u\n-\n\n", temperature_two_comp[1]);
+void thread_iis2dh__milli_g_scale(struct acc_milli_g_scale* scale)
+{
+    *scale = milli_g_scale_in_use;
+}
 
-// Output to CLI UART:
-memset(temperature_in_binary, 0, BINARY_REPRESENTATION_EIGHT_BITS_AS_STRING);
-    integer_to_binary_string(temperature_two_comp[0], temperature_in_binary, BINARY_REPRESENTATION_EIGHT_BITS_AS_STRING);
-    snprintf(lbuf, DEFAULT_MESSAGE_SIZE, "\n\rtemperature reading raw %u, equal to 0b%s\n\r",
-      temperature_two_comp[0], temperature_in_binary);
-    printk_cli(lbuf);
 
-    snprintf(lbuf, DEFAULT_MESSAGE_SIZE, "- ZZZ - test message, test value '%s' - ZZZ -\n\r",
-      temperature_in_binary);
-    printk_cli(lbuf);
 
-    return rstatus;
+// FIFO drains given up on after FIFO_DRAIN_TIMEOUT_MS, zero without asynchronous drain:
+uint32_t thread_iis2dh__fifo_drain_timeouts(void)
+{
+#if KD_DEV__IIS2DH_ASYNC_FIFO_DRAIN == 1
+    return fifo_drain_timeout_count;
+#else
+    return 0;
+#endif
 }
 
 
 
+
 uint32_t wrapper_iis2dh_register_read(const uint8_t register_addr, uint8_t* register_value)
 {
     uint32_t rstatus = ROUTINE_OK;
 
+    REG_SHADOW_LOCK();
     if ( sensor == NULL )
     {
         rstatus = KD__DEVICE_POINTER_NULL;
     }
+// Configuration registers whose sensor value is known cost no bus cycles:
+    else if ( iis2dh_register_cache_lookup(&iis2dh_register_shadow, register_addr, register_value) == ROUTINE_OK )
+    {
+        register_cache_hit_count++;
+    }
     else
     {
         rstatus = kd_read_peripheral_register(
@@ -1109,7 +1700,10 @@ uint32_t wrapper_iis2dh_register_read(const uint8_t register_addr, uint8_t* regi
                                                register_value,
                                                1
                                              );
+        if ( rstatus == ROUTINE_OK )
+            { iis2dh_register_cache_note_on_sensor(&iis2dh_register_shadow, register_addr, *register_value); }
     }
+    REG_SHADOW_UNLOCK();
 
     return rstatus;
 }
@@ -1130,6 +1724,11 @@ uint32_t wrapper_iis2dh_register_write(const uint8_t register_addr, const uint8_
     {
         rstatus = KD__DEVICE_POINTER_NULL;
     }
+    else if ( iis2dh_register_class(register_addr) == IIS2DH_REGISTER_NON_VOLATILE )
+    {
+// Configuration registers go through their shadows, so later block writes do not undo this write:
+        rstatus = iis2dh_write_register(sensor, register_addr, register_value);
+    }
     else
     {
         rstatus = kd_write_peripheral_register(
@@ -1176,17 +1775,20 @@ uint32_t wrapper_iis2dh_register_read_multiple(const uint8_t register_addr, uint
                                              );
     }
 
-#if 1
-    char lbuf[DEFAULT_MESSAGE_SIZE] = { 0 };
-    snprintf(lbuf, DEFAULT_MESSAGE_SIZE, "- DEBUG 1021 - summary of %u bytes just read:\n\r", byte_count);
-    printk_cli(lbuf);
-    for (int i = 0; i < byte_count; i++)
+// Refresh shadow with any configuration registers just read, register address MSb is auto-increment flag:
+    if ( rstatus == ROUTINE_OK )
     {
-        snprintf(lbuf, DEFAULT_MESSAGE_SIZE, " 0x%02X", data[i]);
-        printk_cli(lbuf);
+        uint32_t registers_read = ( ( register_addr & IIS2DH_I2C_AUTO_INCREMENT ) ? byte_count : 1 );
+
+        REG_SHADOW_LOCK();
+        for ( uint32_t i = 0; ( i < registers_read ) && ( i < byte_count ); i++ )
+        {
+            iis2dh_register_cache_note_on_sensor(&iis2dh_register_shadow,
+                                                 ( ( register_addr & ~IIS2DH_I2C_AUTO_INCREMENT ) + i ),
+                                                 data[i]);
+        }
+        REG_SHADOW_UNLOCK();
     }
-    printk_cli("\n\r\n\r");
-#endif
 
     return rstatus;
 }
@@ -1,6 +1,10 @@
 #ifndef _THREAD_IIS2DH_ACCELEROMETER_H
 #define _THREAD_IIS2DH_ACCELEROMETER_H
 
+#include <stdint.h>                // to provide define of uint32_t
+
+struct sample_ring;                // see sample-ring.h
+struct acc_milli_g_scale;          // see conversions.h
 
 
 /**
@@ -21,8 +25,13 @@ uint32_t wrapper_iis2dh_register_read_multiple(const uint8_t register_addr, uint
 void dev__thread_iis2dh__set_one_shot_message_flag(void);
 
 
-// Callback routines to respond to flags set and cleared:
-uint32_t on_event__temperature_readings_requested__query_iis2dh(const uint32_t event);
+// Ring of timestamped raw readings, for logging and other sample consumers:
+struct sample_ring* thread_iis2dh__sample_ring(void);
+
+// Scale for readings above, follows CTRL_REG1 LPEN, CTRL_REG4 HR and FS bits:
+void thread_iis2dh__milli_g_scale(struct acc_milli_g_scale* scale);
+
+uint32_t thread_iis2dh__fifo_drain_timeouts(void);
 
 
 
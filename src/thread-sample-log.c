@@ -0,0 +1,253 @@
+//----------------------------------------------------------------------
+//
+//   Project:  Kionix Driver Work v2 (Zephyr RTOS sensor driver)
+//
+//  Repo URL:  https://github.com/tedhavelka/kionix-driver-demo
+//
+//      File:  thread-sample-log.c
+//
+//----------------------------------------------------------------------
+
+/*
+ *  @Brief:  Low priority Zephyr thread which subscribes to IIS2DH
+ *     sample blocks and sends readings as compact binary records on
+ *     console UART, or as host protocol frames on CLI UART when host
+ *     tool streams.  Sensor thread only publishes blocks, so console
+ *     speed and formatting no longer set how fast sensor is read.
+ *
+ *  @Note:   Record layout documented in thread-sample-log.h.  One
+ *     record carries one sample block, sent straight from channel's
+ *     message without copying readings.  A gap in sequence numbers
+ *     between records marks blocks missed with subscriber queue full.
+ */
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - includes
+//----------------------------------------------------------------------
+
+#include <stdint.h>                // to provide define of uint32_t
+
+// Zephyr RTOS headers:
+#include <zephyr.h>
+#include <device.h>
+#include <devicetree.h>
+#include <drivers/uart.h>          // to provide uart_poll_out()
+#include <sys/atomic.h>            // to provide atomic_t and related
+
+// Local-to-project headers:
+#include "kd-app-config.h"
+#include "return-values.h"
+#include "module-ids.h"
+#include "development-flags.h"
+
+#include "host-protocol.h"         // to provide host_protocol_send_frame()
+#include "kd-app-channels.h"       // to provide acc_sample_block_channel
+#include "thread-sample-log.h"
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - defines
+//----------------------------------------------------------------------
+
+#define SAMPLE_LOG_THREAD_STACK_SIZE 1024
+// Lower priority than sensor thread and LED thread:
+#define SAMPLE_LOG_THREAD_PRIORITY 12
+
+#define SAMPLE_LOG_BYTES_PER_TRIPLET (6)
+#define SAMPLE_LOG_RECORD_MAX_SIZE \
+    ( SAMPLE_LOG_RECORD_HEADER_SIZE + ( SAMPLE_LOG_MAX_TRIPLETS_PER_RECORD * SAMPLE_LOG_BYTES_PER_TRIPLET ) )
+
+BUILD_ASSERT(( SAMPLE_LOG_RECORD_MAX_SIZE - 2 ) <= HOST_PROTOCOL_MAX_DATA,
+             "sample log record must fit one host protocol frame");
+BUILD_ASSERT(ACC_SAMPLE_BLOCK_MAX_READINGS <= SAMPLE_LOG_MAX_TRIPLETS_PER_RECORD,
+             "one sample block must fit one record");
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - prototypes
+//----------------------------------------------------------------------
+
+void sample_log_thread_entry_point(void* arg1, void* arg2, void* arg3);
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - file scoped
+//----------------------------------------------------------------------
+
+static const struct device *uart_for_sample_log = DEVICE_DT_GET(DT_CHOSEN(zephyr_console));
+
+static atomic_t sample_log_enabled = ATOMIC_INIT(0);
+static atomic_t sample_log_output = ATOMIC_INIT(SAMPLE_LOG_OUTPUT_CONSOLE);
+static atomic_t records_sent = ATOMIC_INIT(0);
+static atomic_t triplets_sent = ATOMIC_INIT(0);
+
+KD_CHANNEL_SUBSCRIBER_DEFINE(sample_log_subscriber, KD_APP_SAMPLE_LOG_QUEUE_DEPTH);
+
+static uint8_t record_buffer[SAMPLE_LOG_RECORD_MAX_SIZE];
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - routines
+//----------------------------------------------------------------------
+
+K_THREAD_STACK_DEFINE(sample_log_thread_stack_area, SAMPLE_LOG_THREAD_STACK_SIZE);
+struct k_thread sample_log_thread_data;
+
+int initialize_thread_sample_log(void)
+{
+    int rstatus = 0;
+
+    k_tid_t sample_log_task_tid = k_thread_create(&sample_log_thread_data, sample_log_thread_stack_area,
+                                            K_THREAD_STACK_SIZEOF(sample_log_thread_stack_area),
+                                            sample_log_thread_entry_point,
+                                            NULL, NULL, NULL,
+                                            SAMPLE_LOG_THREAD_PRIORITY,
+                                            0,
+                                            K_MSEC(1500)); // K_NO_WAIT);
+
+    rstatus = k_thread_name_set(sample_log_task_tid, MODULE_ID__THREAD_SAMPLE_LOG);
+    if ( rstatus == 0 ) { } // avoid compiler warning about unused variable - TMH
+
+    return (int)sample_log_task_tid;
+}
+
+
+
+void sample_log__set_enabled(const uint32_t enable)
+{
+    atomic_set(&sample_log_enabled, ( enable ? 1 : 0 ));
+}
+
+uint32_t sample_log__is_enabled(void)
+{
+    return (uint32_t)atomic_get(&sample_log_enabled);
+}
+
+void sample_log__set_output(const uint32_t output)
+{
+    atomic_set(&sample_log_output, (atomic_val_t)output);
+}
+
+uint32_t sample_log__records_sent(void)
+{
+    return (uint32_t)atomic_get(&records_sent);
+}
+
+uint32_t sample_log__triplets_sent(void)
+{
+    return (uint32_t)atomic_get(&triplets_sent);
+}
+
+
+
+static void put_u32_little_endian(uint8_t* destination, const uint32_t value)
+{
+    destination[0] = (uint8_t)( value );
+    destination[1] = (uint8_t)( value >> 8 );
+    destination[2] = (uint8_t)( value >> 16 );
+    destination[3] = (uint8_t)( value >> 24 );
+}
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Pack one sample block into one record and write it to
+ *           UART, or to host as a frame.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+static void send_record(const struct acc_sample_block* block)
+{
+    uint32_t length = SAMPLE_LOG_RECORD_HEADER_SIZE;
+    uint32_t i = 0;
+
+    record_buffer[0] = SAMPLE_LOG_SYNC_BYTE_0;
+    record_buffer[1] = SAMPLE_LOG_SYNC_BYTE_1;
+    record_buffer[2] = SAMPLE_LOG_FORMAT_VERSION;
+    record_buffer[3] = (uint8_t)block->count;
+    put_u32_little_endian(&record_buffer[4], block->first_sequence);
+    put_u32_little_endian(&record_buffer[8], block->timestamp);
+
+    for ( i = 0; i < block->count; i++ )
+    {
+        record_buffer[length++] = (uint8_t)( block->xyz[i].x );
+        record_buffer[length++] = (uint8_t)( block->xyz[i].x >> 8 );
+        record_buffer[length++] = (uint8_t)( block->xyz[i].y );
+        record_buffer[length++] = (uint8_t)( block->xyz[i].y >> 8 );
+        record_buffer[length++] = (uint8_t)( block->xyz[i].z );
+        record_buffer[length++] = (uint8_t)( block->xyz[i].z >> 8 );
+    }
+
+    if ( atomic_get(&sample_log_output) == SAMPLE_LOG_OUTPUT_HOST_FRAMES )
+    {
+// Frame delimits record, so sync bytes are left off:
+        host_protocol_send_frame(HOST_MSG_SAMPLE_RECORD, (uint8_t)block->first_sequence,
+                                 &record_buffer[2], (length - 2));
+    }
+    else
+    {
+        for ( i = 0; i < length; i++ )
+        {
+            uart_poll_out(uart_for_sample_log, record_buffer[i]);
+        }
+    }
+
+    atomic_inc(&records_sent);
+    atomic_add(&triplets_sent, (atomic_val_t)block->count);
+}
+
+
+
+void sample_log_thread_entry_point(void* arg1, void* arg2, void* arg3)
+{
+// --- VAR BEGIN ---
+    const struct acc_sample_block* block = NULL;
+    uint32_t subscribed = 0;
+    uint32_t rstatus = ROUTINE_OK;
+// --- VAR END ---
+
+    if ( !device_is_ready(uart_for_sample_log) )
+    {
+        printk("- %s - console UART not ready, binary sample log unavailable,\n", MODULE_ID__THREAD_SAMPLE_LOG);
+        return;
+    }
+
+    while ( 1 )
+    {
+// Subscribed only while logging, so a disabled log costs sensor thread nothing:
+        if ( sample_log__is_enabled() && ( subscribed == 0 ) )
+        {
+            rstatus = kd_channel_subscribe(&acc_sample_block_channel, &sample_log_subscriber);
+            subscribed = ( rstatus == ROUTINE_OK );
+        }
+        else if ( !sample_log__is_enabled() && ( subscribed == 1 ) )
+        {
+            kd_channel_unsubscribe(&acc_sample_block_channel, &sample_log_subscriber);
+            subscribed = 0;
+        }
+
+        if ( subscribed == 0 )
+        {
+            k_msleep(KD_APP_SAMPLE_LOG_PERIOD_MS);
+            continue;
+        }
+
+        rstatus = kd_channel_receive(&sample_log_subscriber, (const void**)&block, K_MSEC(KD_APP_SAMPLE_LOG_PERIOD_MS));
+        if ( rstatus == ROUTINE_OK )
+        {
+            send_record(block);
+            kd_channel_release(block);
+        }
+    }
+}
+
+
+
+// --- EOF ---
@@ -0,0 +1,69 @@
+#ifndef _THREAD_SAMPLE_LOG_H
+#define _THREAD_SAMPLE_LOG_H
+
+/*
+ * ---------------------------------------------------------------------
+ *
+ *  @Project   Kionix Driver Demo
+ *
+ *  @File      thread-sample-log.h
+ *
+ *  @Brief     Deferred binary logging of IIS2DH readings.  Record
+ *   layout, all multi-byte fields little endian:
+ *
+ *     offset  size  field
+ *     ------  ----  ----------------------------------------------
+ *          0     2  sync bytes 0xA5 0x5A
+ *          2     1  format version, SAMPLE_LOG_FORMAT_VERSION
+ *          3     1  triplet count N, 1 to SAMPLE_LOG_MAX_TRIPLETS_PER_RECORD
+ *          4     4  sequence number of first triplet
+ *          8     4  kernel cycle count when FIFO block was read
+ *         12    6N  N raw x,y,z readings, each axis int16
+ *
+ *   Host side decoder at tools/decode-sample-log.py renders records
+ *   to CSV.
+ *
+ * ---------------------------------------------------------------------
+ */
+
+#include <stdint.h>                // to provide define of uint32_t
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - symbols and structures to share with other modules
+//----------------------------------------------------------------------
+
+#define SAMPLE_LOG_SYNC_BYTE_0               (0xA5)
+#define SAMPLE_LOG_SYNC_BYTE_1               (0x5A)
+#define SAMPLE_LOG_FORMAT_VERSION            (1)
+#define SAMPLE_LOG_RECORD_HEADER_SIZE        (12)
+#define SAMPLE_LOG_MAX_TRIPLETS_PER_RECORD   (32)
+
+// Where records go:  raw with sync bytes on console UART, or in host
+// protocol frames on CLI UART, see host-protocol.h:
+#define SAMPLE_LOG_OUTPUT_CONSOLE            (0)
+#define SAMPLE_LOG_OUTPUT_HOST_FRAMES        (1)
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - routine prototypes
+//----------------------------------------------------------------------
+
+int initialize_thread_sample_log(void);
+
+// Start or stop binary records on console UART, 1 = on and 0 = off:
+void sample_log__set_enabled(const uint32_t enable);
+
+uint32_t sample_log__is_enabled(void);
+
+void sample_log__set_output(const uint32_t output);
+
+uint32_t sample_log__records_sent(void);
+
+uint32_t sample_log__triplets_sent(void);
+
+
+
+#endif // _THREAD_SAMPLE_LOG_H
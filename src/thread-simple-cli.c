@@ -33,15 +33,19 @@
  *
  *  @Implementation:
  *
- *    (1)  To add new CLI commands first search in this source file for
- *    text pattern 'ADD COMMANDS - STEP n:' where 'n' is one of 1, 2
- *    of 3.  As of 2021 Q4 there are three places in this project file
- *    where a supported command has parts of itself expressed.  These
- *    places are,
- *    
- *      +  CLI routine prototypes section
- *      +  array of CLI routine structure instances (function pts plus couple other members)
- *      +  CLI routine definition
+ *    (1)  To add a new CLI command define its routine in any project
+ *    source file, and below that routine register it with macro
+ *    KD_CLI_COMMAND_DEFINE() from thread-simple-cli.h.  Linker gathers
+ *    registered commands into one section, this thread sorts them by
+ *    command token at start up and finds commands by binary search.
+ *    Commands may be entered by any unambiguous prefix of their token,
+ *    and <TAB> completes a partly typed command token.
+ *
+ *    (2)  Line editing understands ANSI / VT100 escape sequences sent
+ *    by common terminal programs:  up and down arrows recall history,
+ *    left and right arrows, <HOME>, <END>, <DEL> and <BACKSPACE> edit
+ *    within the line, as do ctrl-A, ctrl-E and ctrl-U.  A lone <ESC>
+ *    still clears the line, acted on when next key arrives.
  *
  *    CLI routines have a particular signature and form.  They accept
  *    an invariant string as their argument, and return a uint32_t 
@@ -76,7 +80,8 @@
 
         DONE 2021-11-18 - '/' echoes present input on new prompt and continues to 'listen'
 
-   [ ] TO DO 2021-11-17 - Implement command history
+   [x] TO DO 2021-11-17 - Implement command history
+        DONE - up and down arrows recall, see cli-history.c
 
 */
 
@@ -104,6 +109,9 @@
 // 2021-10-05 - CLI incorporation work, see Zephyr v2.6.0 file "zephyr/subsys/console/tty.c"
 #include <drivers/uart.h>          // to provide uart_poll_in()
 
+#include <sys/ring_buffer.h>       // to provide ring buffer between UART RX interrupt and CLI thread
+#include <sys/atomic.h>            // to provide atomic_t and related
+
 
 //
 // Project specific includes:
@@ -115,6 +123,8 @@
 #include "return-values.h"
 #include "kionix-demo-errors.h"
 #include "banner.h"
+#include "development-flags.h"
+#include "kd-app-config.h"
 
 // Thread and module data sharing module:
 #include "scoreboard.h"            // to provide experimental global vars for simple data sharing
@@ -122,6 +132,8 @@
 // Individual and small command set routine definitions:
 #include "cli-zephyr-stack-info.h"
 #include "cli-zephyr-kernel-timing.h"
+#include "cli-history.h"
+#include "host-protocol.h"         // to provide host_protocol_claims_byte()
 
 #include "thread-simple-cli.h"     // to provide prototype for printk_cli(),
                                    // ( called earlier than defined in this source file. )
@@ -139,13 +151,21 @@
 // defines for application or task implemented by this thread:
 #define SLEEP_TIME__SIMPLE_CLI__MS (50)
 
+// UART RX ring buffer holds a full command line plus margin, so pasted
+// command scripts survive while CLI thread runs a slow command handler:
+#define SIZE_CLI_RX_RING_BUFFER (2 * SIZE_COMMAND_INPUT_SUPPORTED)
+
+// Characters CLI thread takes from RX ring per pass:
+#define SIZE_CLI_RX_CHUNK (32)
+
+#if defined(CONFIG_UART_INTERRUPT_DRIVEN) && (KD_DEV__CLI_UART_INTERRUPT_DRIVEN == 1)
+#define CLI_UART_INTERRUPT_DRIVEN
+#endif
+
 // Note, for now we limit a token or character strings sans white space
 // to 32 characters, subject to change as needed:
 //#define SIZE_COMMAND_TOKEN (32)
 
-// Note, space permitting we'll store up to ten user commands in a ring buffer:
-#define SIZE_COMMAND_HISTORY (10)     // 2021-10-25 - not yet implemented
-
 // Note, for now we support command line up to 256 characters:
 #define SIZE_COMMAND_INPUT_SUPPORTED (256)
 
@@ -159,8 +179,15 @@
 // - SECTION - DEVELOPMENT FLAGS
 //----------------------------------------------------------------------
 
-// Latest parsed arguments:
-static char argument_array[MAX_COUNT_SUPPORTED_ARGS][SUPPORTED_ARG_LENGTH];
+// Latest parsed arguments, as spans into latest command line rather
+// than copies, valid until CLI clears command line after handler returns:
+struct cli_token_span
+{
+    uint16_t offset;
+    uint16_t length;
+};
+
+static struct cli_token_span argument_spans[MAX_COUNT_SUPPORTED_ARGS];
 
 // Count of latest parsed arguments, tokens following latest command:
 static uint32_t argument_count;
@@ -176,9 +203,10 @@ static uint32_t argument_count;
 
 void simple_cli_thread_entry_point(void* arg1, void* arg2, void* arg3);
 void show_prompt(void);
+static void sort_command_set(void);
 
-uint32_t store_args_from(const char* string);
 uint32_t dev_show_args(void);
+static uint32_t tokenize_args(const char* input);
 
 uint32_t arg_n(const uint32_t requested_arg, char* return_arg);
 uint32_t arg_is_decimal(const uint32_t index_to_arg, int* value);
@@ -186,27 +214,10 @@ uint32_t arg_is_hex(const uint32_t index_to_arg, int* value);
 
 
 
-// *************************************************************************************************
-// - ADD COMMANDS - STEP 1:  add a prototype for CLI routine here
-// *************************************************************************************************
-
 // command handler prototypes:
 uint32_t output_data_rate_handler(const char* args);
 uint32_t cli__help_message(const char* args);
-//uint32_t banner_message(const char* args);
-
-// cli-zephyr-stack-info.h . . .
-extern uint32_t cli__zephyr_2p6p0_stack_statistics(const char* args);
-// banner.h . . .
-extern uint32_t cli__kd_version(const char* args);
-// banner.h . . .
-extern uint32_t cli__banner_message(const char* args);
-// cli-zephyr-kernel-timing.h . . .
-
-// STMicro IIS2DH accelerometer related:
-extern uint32_t cli__iis2dh_sensor_handler(const char* args);
-
-extern uint32_t cli__request_temperature_reading(const char* args);
+uint32_t cli__history(const char* args);
 
 
 
@@ -215,46 +226,60 @@ extern uint32_t cli__request_temperature_reading(const char* args);
 //----------------------------------------------------------------------
 
 static char latest_command[SIZE_COMMAND_TOKEN];
-static char command_history[SIZE_COMMAND_HISTORY][SIZE_COMMAND_TOKEN];  // <-- 2021-10-26 not yet used
-static uint32_t index_to_cmd_history;
-static uint32_t index_within_cmd_token;
+static uint32_t index_within_cmd_token;      // length of latest command
+static uint32_t cursor_within_cmd_token;     // where next typed character goes
+
+// History entry shown on command line, zero when line is new input:
+static uint32_t history_recall_depth;
+
+// Progress through terminal escape sequence, e.g. <ESC> [ A for up arrow:
+enum cli_escape_states
+{
+    CLI_ESCAPE_NONE,
+    CLI_ESCAPE_SEEN,
+    CLI_ESCAPE_CSI
+};
+
+static enum cli_escape_states escape_state;
+static uint32_t escape_parameter;
 
 static const struct device *uart_for_cli;
 
+#ifdef CLI_UART_INTERRUPT_DRIVEN
+// UART RX interrupt stores input here and gives semaphore, CLI thread
+// sleeps on semaphore with no timeout:
+RING_BUF_DECLARE(cli_rx_ring, SIZE_CLI_RX_RING_BUFFER);
+K_SEM_DEFINE(cli_rx_semaphore, 0, 1);
+
+// printk_cli() callers from any thread queue output here, UART TX
+// interrupt sends it and gives semaphore as room frees up.  Lock
+// serializes writers, and pairs TX interrupt enable with ring contents:
+RING_BUF_DECLARE(cli_tx_ring, KD_APP_CLI_TX_BUFFER_SIZE);
+K_SEM_DEFINE(cli_tx_space_semaphore, 0, 1);
+static struct k_spinlock cli_tx_lock;
+#endif
 
-// work in project git branch 'cli-dev-work-003':
+// Set when CLI UART runs by RX and TX interrupts, clear when polled:
+static uint32_t cli_uart_interrupt_driven;
 
-static uint32_t implemented_command_count;
+// Polled output goes out one byte at a time, so writers from threads
+// take turns whole, keeping one call's bytes together:
+K_MUTEX_DEFINE(cli_tx_poll_mutex);
 
-typedef uint32_t (*command_handler_t)(const char* argument_string);
+// Characters UART received while RX ring full:
+static uint32_t cli_rx_dropped_count;
 
-struct cli_command_writers_api
-{
-    char* token_to_represent_command;
-    char* description;
-    command_handler_t handler;
-};
+// Output bytes discarded with TX ring full, and times a caller waited for
+// room, updated from any thread:
+static atomic_t cli_tx_dropped_count = ATOMIC_INIT(0);
+static atomic_t cli_tx_wait_count = ATOMIC_INIT(0);
 
-// *************************************************************************************************
-// - ADD COMMANDS - STEP 2:  add entry in array of CLI routine structures here
-// *************************************************************************************************
 
-struct cli_command_writers_api kd_command_set[] =
-{
-    { "help", "show supported Kionix demo CLI commands", &cli__help_message },
-    { "?", "show supported Kionix demo CLI commands", &cli__help_message },
-    { "banner", "show brief project identifier string for this Zephyr based app", &cli__banner_message },
-    { "version", "show this Kionix Driver Demo version info", &cli__kd_version },
-
-    { "odr", "IIS2DH Output Data Rate (ODR) set and get command", &output_data_rate_handler },
-    { "iis2dh", "IMPLEMENTATION UNDERWAY - general purpose iis2dh configuration command", &cli__iis2dh_sensor_handler },
-    { "temp", "request iis2dh temperature reading", &cli__request_temperature_reading},
-
-    { "st", "show Zephyr RTOS thread stack statistics", &cli__zephyr_2p6p0_stack_statistics },
-    { "stacks", "alias to `st`", &cli__zephyr_2p6p0_stack_statistics },
-    { "cyc", "show Zephyr kernel run time cycles count", &cli__show_zephyr_kernel_runtime_cycle_count },
-    { "cycles", "alias to `cyc`", &cli__show_zephyr_kernel_runtime_cycle_count }
-};
+// Registered CLI commands, sorted by command token at start up:
+static const struct cli_command_writers_api* kd_command_set[KD_APP_CLI_COMMAND_CAPACITY];
+
+static uint32_t implemented_command_count;
+
 
 
 
@@ -288,34 +313,164 @@ int initialize_thread_simple_cli(void)
 
 
 
-uint32_t printk_cli(const char* message)
+static uint32_t cli_uart_poll_out(const char* bytes, const uint32_t count)
 {
-    uint32_t rstatus = 0;
-    uint32_t message_byte_count = strlen(message);
+    uint32_t flag_locked = ( k_is_in_isr() == false );
 
-    if ( uart_for_cli == NULL )
+    if ( flag_locked )
+        { k_mutex_lock(&cli_tx_poll_mutex, K_FOREVER); }
+
+    for ( int i = 0; i < count; i++ )
     {
-        return KD_ERROR__HANDLE_TO_ALTERNATE_UART_NULL;
+        uart_poll_out(uart_for_cli, bytes[i]);
     }
 
-    for ( int i = 0; i < message_byte_count; i++ )
+    if ( flag_locked )
+        { k_mutex_unlock(&cli_tx_poll_mutex); }
+
+    return ROUTINE_OK;
+}
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Send bytes to CLI UART.  With interrupt driven CLI UART
+ *           bytes are queued and routine returns once they fit in TX
+ *           ring, see KD_APP_CLI_TX_WHEN_FULL for full ring handling.
+ *           Before that, or when UART lacks interrupt support, bytes
+ *           are polled out one at a time.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+static uint32_t cli_uart_write(const char* bytes, const uint32_t count)
+{
+#ifdef CLI_UART_INTERRUPT_DRIVEN
+    if ( cli_uart_interrupt_driven )
     {
-        uart_poll_out(uart_for_cli, message[i]);
+        uint32_t queued = 0;
+        uint32_t put = 0;
+        k_spinlock_key_t key;
+
+        while ( queued < count )
+        {
+            key = k_spin_lock(&cli_tx_lock);
+            put = ring_buf_put(&cli_tx_ring, (const uint8_t*)(bytes + queued), (count - queued));
+            if ( put > 0 )
+            {
+                uart_irq_tx_enable(uart_for_cli);
+            }
+            k_spin_unlock(&cli_tx_lock, key);
+
+            queued += put;
+            if ( queued == count )
+                { break; }
+
+            if ( (KD_APP_CLI_TX_WHEN_FULL == KD_CLI_TX_WHEN_FULL_DROP) || k_is_in_isr() )
+            {
+                atomic_add(&cli_tx_dropped_count, (atomic_val_t)(count - queued));
+                return KD__CLI_TX_BYTES_DROPPED;
+            }
+
+            atomic_inc(&cli_tx_wait_count);
+            if ( k_sem_take(&cli_tx_space_semaphore, K_MSEC(KD_APP_CLI_TX_BLOCK_TIMEOUT_MS)) != 0 )
+            {
+                atomic_add(&cli_tx_dropped_count, (atomic_val_t)(count - queued));
+                return KD__CLI_TX_BYTES_DROPPED;
+            }
+        }
+        return ROUTINE_OK;
     }
-    return rstatus;
-} 
+#endif
 
+    return cli_uart_poll_out(bytes, count);
+}
 
 
-void clear_argument_array(void)
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Queue all of count bytes at once or none of them, so they
+ *           sit in TX ring as one run.  cli_uart_write() may queue a
+ *           message in parts while it waits for room, and text from
+ *           another thread then lands between parts.  Binary frames
+ *           must not be split that way.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+static uint32_t cli_uart_write_whole(const uint8_t* bytes, const uint32_t count)
+{
+#ifdef CLI_UART_INTERRUPT_DRIVEN
+    if ( cli_uart_interrupt_driven )
+    {
+        k_spinlock_key_t key;
+
+        if ( count > KD_APP_CLI_TX_BUFFER_SIZE )
+        {
+            atomic_add(&cli_tx_dropped_count, (atomic_val_t)count);
+            return KD__CLI_TX_BYTES_DROPPED;
+        }
+
+        while ( 1 )
+        {
+            key = k_spin_lock(&cli_tx_lock);
+            if ( ring_buf_space_get(&cli_tx_ring) >= count )
+            {
+                ring_buf_put(&cli_tx_ring, bytes, count);
+                uart_irq_tx_enable(uart_for_cli);
+                k_spin_unlock(&cli_tx_lock, key);
+                return ROUTINE_OK;
+            }
+            k_spin_unlock(&cli_tx_lock, key);
+
+            if ( (KD_APP_CLI_TX_WHEN_FULL == KD_CLI_TX_WHEN_FULL_DROP) || k_is_in_isr() )
+            {
+                atomic_add(&cli_tx_dropped_count, (atomic_val_t)count);
+                return KD__CLI_TX_BYTES_DROPPED;
+            }
+
+            atomic_inc(&cli_tx_wait_count);
+            if ( k_sem_take(&cli_tx_space_semaphore, K_MSEC(KD_APP_CLI_TX_BLOCK_TIMEOUT_MS)) != 0 )
+            {
+                atomic_add(&cli_tx_dropped_count, (atomic_val_t)count);
+                return KD__CLI_TX_BYTES_DROPPED;
+            }
+        }
+    }
+#endif
+
+    return cli_uart_poll_out((const char*)bytes, count);
+}
+
+
+
+uint32_t printk_cli(const char* message)
 {
-    int i = 0;
+    if ( uart_for_cli == NULL )
+    {
+        return KD_ERROR__HANDLE_TO_ALTERNATE_UART_NULL;
+    }
 
-    for ( i = 0; i < SIZE_COMMAND_HISTORY; i++ )
+    return cli_uart_write(message, strlen(message));
+} 
+
+
+
+uint32_t cli_uart_write_bytes(const uint8_t* bytes, const uint32_t count)
+{
+    if ( uart_for_cli == NULL )
     {
-        memset(argument_array[i], 0, sizeof(argument_array[i]));
+        return KD_ERROR__HANDLE_TO_ALTERNATE_UART_NULL;
     }
 
+    return cli_uart_write_whole(bytes, count);
+}
+
+
+
+void clear_argument_array(void)
+{
+    memset(argument_spans, 0, sizeof(argument_spans));
     argument_count = 0;
 }
 
@@ -332,9 +487,9 @@ uint32_t argument_count_from_cli_module(void)
  *  @Description:  routine to initialize simple command line interface,
  *     carries out following tasks:
  *
- *     +  clears command history (history not yet implemented 2021-11-15)
- *     +  clears index to current command in history (planned to be a ring buffer history)
- *     +  clears a global index used to traverse bytes in command token
+ *     +  clears command history
+ *     +  clears index to recalled command in history
+ *     +  clears global length of and cursor within command line
  *     +  clears array of latest parsed command line arguments (tokens following command)
  *     +  displays given app banner message
  *     +  displays first instance of command line prompt
@@ -345,20 +500,18 @@ uint32_t argument_count_from_cli_module(void)
 
 void initialize_command_handler(void)
 {
-    int i = 0;
     uint32_t rstatus = ROUTINE_OK;
 
     memset(latest_command, 0, sizeof(latest_command));
-    for ( i = 0; i < SIZE_COMMAND_HISTORY; i++ )
-    {
-        memset(command_history[i], 0, sizeof(command_history[i]));
-    }
+    cli_history_init();
 
-// Count of implemented CLI commands known at build time, used couple times at run time:
-    implemented_command_count = (sizeof(kd_command_set) / sizeof(struct cli_command_writers_api));
+// Sort commands registered across project modules, used at each lookup:
+    sort_command_set();
 
-    index_to_cmd_history = 0;
+    history_recall_depth = 0;
     index_within_cmd_token = 0;
+    cursor_within_cmd_token = 0;
+    escape_state = CLI_ESCAPE_NONE;
 
 // Clear global argument array and argument count variable:
     clear_argument_array();
@@ -375,50 +528,15 @@ void clear_latest_command_string(void)
 {
     memset(latest_command, 0, sizeof(latest_command));
     index_within_cmd_token = 0;
+    cursor_within_cmd_token = 0;
+    history_recall_depth = 0;
     show_prompt();
 }
 
 
 
-// --- 1118 b DEV BEGIN ---
-void delete_one_char_from_latest_command_string(void)
-{
-    char lbuf[DEFAULT_MESSAGE_SIZE];
-    uint32_t command_length = strlen(latest_command);
-
-#define BACKSPACE_DEBUG 0
-#if BACKSPACE_DEBUG == 1
-    snprintf(lbuf, DEFAULT_MESSAGE_SIZE, "- before backspace - present command length is %u\n\r", command_length);
-    printk_cli(lbuf);
-#endif
-#if 0
-//    if ( flag_fresh_backspace_keypress == TRUE )
-#endif
-
-    if ( command_length > 0 )
-    {
-#if BACKSPACE_DEBUG == 1
-        printk_cli("deleting a character,\n\r");
-#endif
-        --index_within_cmd_token;
-        latest_command[index_within_cmd_token] = 0;
-        command_length = strlen(latest_command);
-    }
-
-#if BACKSPACE_DEBUG == 1
-    snprintf(lbuf, DEFAULT_MESSAGE_SIZE, "- after backspace - present command length is %u\n\r", command_length);
-    printk_cli(lbuf);
-#endif
-    show_prompt();
-    printk_cli(latest_command);
-}
-// --- 1118 b DEV END ---
-
-
-
-
-
-#define PS1 "\n\rkd-demo > "
+#define PROMPT_TEXT "kd-demo > "
+#define PS1 "\n\r" PROMPT_TEXT
 
 void show_prompt(void)
 {
@@ -427,308 +545,694 @@ void show_prompt(void)
 
 
 
-void show_prompt_and_latest_command(void)
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Rewrite prompt and command line in place, erase anything
+ *           left over from a longer line, then step terminal cursor
+ *           back to editing position.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+static void redraw_latest_command(void)
 {
-    printk_cli(PS1);
+    char lbuf[SIZE_OF_MESSAGE_SHORT];
+
+    printk_cli("\r" PROMPT_TEXT);
     printk_cli(latest_command);
+    printk_cli("\x1b[K");
+
+    if ( cursor_within_cmd_token < index_within_cmd_token )
+    {
+        snprintf(lbuf, sizeof(lbuf), "\x1b[%uD", (index_within_cmd_token - cursor_within_cmd_token));
+        printk_cli(lbuf);
+    }
 }
 
 
 
-uint32_t command_and_args_from_input(const char* latest_input,
-                                     char* command,
-                                     char* args)
+// --- 1118 b DEV BEGIN ---
+void delete_one_char_from_latest_command_string(void)
 {
-    uint32_t input_byte_count = strlen(latest_input);
-    uint32_t i = 0;
-    uint32_t flag_white_space_found = 0;
-    uint32_t rstatus = 0;
+    if ( cursor_within_cmd_token == 0 )
+    {
+        return;
+    }
 
-//printk("In 'command and args' about to parse %u bytes,\n", input_byte_count);
+    memmove(&latest_command[cursor_within_cmd_token - 1], &latest_command[cursor_within_cmd_token],
+            (index_within_cmd_token - cursor_within_cmd_token + 1));
+    --cursor_within_cmd_token;
+    --index_within_cmd_token;
+    redraw_latest_command();
+}
+// --- 1118 b DEV END ---
 
-    for ( i = 0; (i < input_byte_count); i++ )
-    {
-        if ( latest_input[i] == 0x20 )
-        {
-            flag_white_space_found = 1;
-            strncpy(command, latest_input, (i - 0));
-            strncpy(args, (latest_input + i + 1), (input_byte_count - i));
-//printk("In 'command and args' found white space at string index %u\n", i);
-            i = input_byte_count;
-        }
 
-//        if ( latest_input[i] == '\r' )
-        if ( ( latest_input[i] == '\r' ) || ( latest_input[i] == '\n' ) )
-        {
-            strncpy(command, latest_input, (i - 0));
-            strncpy(args, "", 1);
-//printk("In 'command and args' found <CR> at string index %u\n", i);
-            i = input_byte_count;
-        }
-    }
 
-    if ( !flag_white_space_found )
+static void delete_char_under_cursor(void)
+{
+    if ( cursor_within_cmd_token >= index_within_cmd_token )
     {
-        strncpy(command, latest_input, input_byte_count);
+        return;
     }
 
-//printk("After parsing loop index i = %u,\nreturning . . .\n", i);
-
-    return rstatus;
+    memmove(&latest_command[cursor_within_cmd_token], &latest_command[cursor_within_cmd_token + 1],
+            (index_within_cmd_token - cursor_within_cmd_token));
+    --index_within_cmd_token;
+    redraw_latest_command();
 }
 
 
 
-static uint32_t command_handler(const char* latest_input)
+static void insert_char_at_cursor(const char character)
 {
-// --- VAR BEGIN ---
-//    uint32_t test_value = 0;
-    char command[SIZE_COMMAND_TOKEN];
-    char args[SIZE_COMMAND_INPUT_SUPPORTED];
-    uint32_t rstatus = 0;
-#if 0 // DEV BLOCK 1 START
-    char lbuf[SIZE_OF_MESSAGE_SHORT] = { 0 };
-#endif // DEV BLOCK 1 END
-// --- VAR END ---
+    if ( index_within_cmd_token >= (SIZE_COMMAND_TOKEN - 1) )
+    {
+        printk("Supported command length exceeded!\n");
+        printk("Press <ENTER> to process or <ESC> to start over.\n");
+        return;
+    }
 
-    memset(command, 0, sizeof(command));
-    memset(args, 0, sizeof(args));
-    rstatus = command_and_args_from_input(latest_input, command, args);
+// Typing at end of line, the common case, echoes one character:
+    if ( cursor_within_cmd_token == index_within_cmd_token )
+    {
+        latest_command[index_within_cmd_token] = character;
+        ++index_within_cmd_token;
+        ++cursor_within_cmd_token;
+        latest_command[index_within_cmd_token] = 0;
+        cli_uart_write(&character, 1);
+        return;
+    }
 
-// NEED TO CHECK return status of previous routine call here:
-    rstatus = store_args_from(args);
+    memmove(&latest_command[cursor_within_cmd_token + 1], &latest_command[cursor_within_cmd_token],
+            (index_within_cmd_token - cursor_within_cmd_token + 1));
+    latest_command[cursor_within_cmd_token] = character;
+    ++index_within_cmd_token;
+    ++cursor_within_cmd_token;
+    redraw_latest_command();
+}
 
-#if 0 // // DEV BLOCK 1 START
-    snprintf(lbuf, sizeof(lbuf), "parsed %u args from present input,\n\r", (argument_count + 0));
-    printk_cli(lbuf);
 
-    rstatus |= dev_show_args();
-#endif // DEV BLOCK 1 END
 
-    for ( int i = 0; i < ( sizeof(kd_command_set) / sizeof(struct cli_command_writers_api) ); i++ )
+static void move_cursor_to(const uint32_t position)
+{
+    if ( position > index_within_cmd_token )
     {
-        if ( strncmp(command, kd_command_set[i].token_to_represent_command, SIZE_COMMAND_TOKEN) == 0 )
-        {
-            rstatus = kd_command_set[i].handler(args);
-        }
+        return;
     }
 
-    return rstatus;
+    cursor_within_cmd_token = position;
+    redraw_latest_command();
 }
 
 
 
-uint32_t build_command_string(const char* latest_input, const struct device* callers_uart)
-{
-    uint32_t rstatus = 0;
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Replace command line with history entry one step older
+ *           (step +1) or newer (step -1).  Stepping newer than newest
+ *           entry leaves an empty line.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
 
+static void recall_history(const int32_t step)
+{
+    uint32_t depth = history_recall_depth;
+    uint32_t length = 0;
 
-// --- 1118 b DEV BEGIN ---
-    if ( latest_input[0] == 0x08 )    // . . . <BACKSPACE> key 
+    if ( step > 0 )
     {
-        delete_one_char_from_latest_command_string();
+        if ( depth >= cli_history_count() )
+            { return; }
+        depth++;
+    }
+    else
+    {
+        if ( depth == 0 )
+            { return; }
+        depth--;
     }
-//    else
-//    {
-//        flag_fresh_backspace_keypress = TRUE;
-//    }
-
 
-    if ( latest_input[0] == 0x2F )    // . . . '/' forward slash character
+    memset(latest_command, 0, sizeof(latest_command));
+    if ( depth > 0 )
     {
-        show_prompt_and_latest_command();
+        cli_history_entry(depth, latest_command, sizeof(latest_command), &length);
     }
 
-// --- 1118 b DEV END ---
+    history_recall_depth = depth;
+    index_within_cmd_token = length;
+    cursor_within_cmd_token = length;
+    redraw_latest_command();
+}
 
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-// - STEP - store and echo latest CLI character wise input
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-// If latest character printable and not '\r' . . . append latest command string:
-//    if ( (latest_input[0] >= 0x20) && (latest_input[0] < 0x7F) && (latest_input[0] != '\r') 
-    else if ( (latest_input[0] >= 0x20) && (latest_input[0] < 0x7F) && (latest_input[0] != '\r') 
-           && (latest_input[0] != 0x08) )
-//       ~~~~~~~~~~~~~~~~~~~~~~~~~    ~~~~~~~~~~~~~~~~~~~~~~~~    ~~~~~~~~~~~~~~~~~~~~~~~~~
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Step through ANSI escape sequence one character at a time.
+ *           Returns TRUE when character consumed.  A character other
+ *           than '[' or 'O' after <ESC> means <ESC> was pressed alone,
+ *           then line is cleared and character handled as usual.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+static uint32_t handle_escape_sequence(const char character)
+{
+    if ( escape_state == CLI_ESCAPE_SEEN )
     {
-        if ( index_within_cmd_token >= SIZE_COMMAND_TOKEN )
-        {
-            printk("Supported command length exceeded!\n");
-            printk("Press <ENTER> to process or <ESC> to start over.\n");
-        }
-        else
+        if (( character == '[' ) || ( character == 'O' ))
         {
-            latest_command[index_within_cmd_token] = latest_input[0];
-            ++index_within_cmd_token;
-            uart_poll_out(callers_uart, latest_input[0]);
+            escape_state = CLI_ESCAPE_CSI;
+            escape_parameter = 0;
+            return TRUE;
         }
-    }
-
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-// - STEP - respond to supported control characters
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-
-// If latest character is <ESC> then clear the latest captured command string:
 
-    else if ( latest_input[0] == 0x1B )    // . . . <ESCAPE> key 
-    {
+        escape_state = CLI_ESCAPE_NONE;
         clear_latest_command_string();
+        return ( character == 0x1B ? TRUE : FALSE );
     }
 
-#if 0
-// --- 1118 b DEV BEGIN ---
-    else if ( latest_input[0] == 0x08 )    // . . . <BACKSPACE> key 
+// Within control sequence, collect numeric parameter until final byte:
+    if (( character >= '0' ) && ( character <= '9' ))
     {
-        delete_one_char_from_latest_command_string();
+        escape_parameter = (escape_parameter * 10) + (character - '0');
+        return TRUE;
     }
-// --- 1118 b DEV END ---
-#endif
 
-// If latest character is <ENTER> then call the command handler:
+    escape_state = CLI_ESCAPE_NONE;
 
-    else if ( latest_input[0] == '\r' )
+    switch (character)
     {
-// --- 1115 DEV BEGIN ---
-// bug fix, attempting to correct overwriting of CLI prompt and latest command:
-//        uart_poll_out(callers_uart, latest_input[0]);
-        if ( strlen(latest_input) > 1 )
-        {
-            printk_cli("\n\r");
-        }
-        else
-        {
-            uart_poll_out(callers_uart, latest_input[0]);
-        }
-// --- 1115 DEV END ---
-
-        rstatus = command_handler(latest_command);
-        clear_latest_command_string();
+        case 'A': recall_history(1); break;                                  // up arrow
+        case 'B': recall_history(-1); break;                                 // down arrow
+        case 'C': move_cursor_to(cursor_within_cmd_token + 1); break;        // right arrow
+        case 'D':                                                            // left arrow
+            if ( cursor_within_cmd_token > 0 )
+                { move_cursor_to(cursor_within_cmd_token - 1); }
+            break;
+        case 'H': move_cursor_to(0); break;                                  // <HOME>
+        case 'F': move_cursor_to(index_within_cmd_token); break;             // <END>
+        case '~':
+            if (( escape_parameter == 1 ) || ( escape_parameter == 7 ))
+                { move_cursor_to(0); }
+            else if (( escape_parameter == 4 ) || ( escape_parameter == 8 ))
+                { move_cursor_to(index_within_cmd_token); }
+            else if ( escape_parameter == 3 )
+                { delete_char_under_cursor(); }
+            break;
+        default:
+            break;
     }
 
-    return rstatus;
-} 
+    return TRUE;
+}
 
 
-//----------------------------------------------------------------------
-// - SECTION - string parsing routines
-//----------------------------------------------------------------------
 
-uint32_t store_args_from(const char* input)
+void show_prompt_and_latest_command(void)
 {
-    uint32_t rstatus = 0;
-    uint32_t i = 0;          // 'i' indexes the length of passed input string
-    uint32_t present_arg_size = 0;
-    uint32_t present_arg_start = 0;
-    uint32_t input_length = strlen(input);
-// Note global 'argument_count' serves as our present argument index.
+    printk_cli("\n\r");
+    redraw_latest_command();
+}
 
-#ifdef DIAG_COMMAND_PARSING
-#endif
-#ifdef DIAG_STORE_ARGS
-printk("- store_args_from - starting to parse and store args . . .\n");
-#endif
 
-    clear_argument_array();
 
-#ifdef DIAG_STORE_ARGS
-printk("- store_args_from - args array cleared, input has length %u,\n", input_length);
-#endif
+//----------------------------------------------------------------------
+// - SECTION - command lookup
+//----------------------------------------------------------------------
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Gather commands registered by KD_CLI_COMMAND_DEFINE() into
+ *           kd_command_set[], insertion sorted by command token.  Runs
+ *           once, command count is small and fixed at build time.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
 
-    while(
-           ( i < input_length ) &&
-           ( argument_count < MAX_COUNT_SUPPORTED_ARGS ) &&
-           ( i < SIZE_COMMAND_INPUT_SUPPORTED ) &&
-           ( present_arg_size < SUPPORTED_ARG_LENGTH )
-         )
+static void sort_command_set(void)
+{
+    uint32_t i = 0;
+
+    implemented_command_count = 0;
+
+    STRUCT_SECTION_FOREACH(cli_command_writers_api, entry)
     {
-// Skip leading white space at start of input string and after each token parsed:
-        if ( (present_arg_size == 0) && (input[i] == 0x20) )
+        if ( implemented_command_count >= KD_APP_CLI_COMMAND_CAPACITY )
         {
-//            i++;
+            printk("- simple cli - WARNING more CLI commands registered than KD_APP_CLI_COMMAND_CAPACITY!\n");
+            break;
         }
-// Note the starting position of each successive argument:
-        else if ( (present_arg_size == 0) && (input[i] != 0x20) )
+
+        for ( i = implemented_command_count;
+              ( i > 0 ) && ( strcmp(kd_command_set[i - 1]->token_to_represent_command,
+                                    entry->token_to_represent_command) > 0 );
+              i-- )
         {
-#ifdef DIAG_STORE_ARGS
-printk("- store_args_from - found arg at %u . . .\n", i);
-#endif
-            present_arg_start = i;
-            present_arg_size++;
+            kd_command_set[i] = kd_command_set[i - 1];
         }
+        kd_command_set[i] = entry;
+        implemented_command_count++;
+    }
+}
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Binary search sorted command set for commands whose token
+ *           begins with given prefix.
+ *
+ *  @return  count of matching commands, contiguous from *first_match.
+ *           An exact match, when present, is always *first_match.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+static uint32_t commands_matching_prefix(const char* prefix, const uint32_t prefix_length,
+                                         uint32_t* first_match)
+{
+    uint32_t low = 0;
+    uint32_t high = implemented_command_count;
+    uint32_t middle = 0;
+
+    while ( low < high )
+    {
+        middle = low + ((high - low) / 2);
+        if ( strncmp(kd_command_set[middle]->token_to_represent_command, prefix, prefix_length) < 0 )
+            { low = middle + 1; }
+        else
+            { high = middle; }
+    }
+
+    *first_match = low;
+
+    for ( high = low; high < implemented_command_count; high++ )
+    {
+        if ( strncmp(kd_command_set[high]->token_to_represent_command, prefix, prefix_length) != 0 )
+            { break; }
+    }
+
+    return (high - low);
+}
+
+
+
+static void show_commands_matching(const uint32_t first_match, const uint32_t match_count)
+{
+    printk_cli("\n\r");
+    for ( uint32_t i = first_match; i < (first_match + match_count); i++ )
+    {
+        printk_cli(kd_command_set[i]->token_to_represent_command);
+        printk_cli("  ");
+    }
+}
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Find command by exact token, or by prefix which matches
+ *           one command only.  Ambiguous prefixes list candidates.
+ *           Command need not be null terminated, so it may be viewed in
+ *           place within command line.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+static const struct cli_command_writers_api* command_lookup(const char* command, const uint32_t length)
+{
+    uint32_t first_match = 0;
+    uint32_t match_count = 0;
+    const char* first_token;
+
+    if ( length == 0 )
+    {
+        return NULL;
+    }
+
+    match_count = commands_matching_prefix(command, length, &first_match);
+
+    if ( match_count == 0 )
+    {
+        return NULL;
+    }
+
+    first_token = kd_command_set[first_match]->token_to_represent_command;
+
+    if (( match_count == 1 ) || ( first_token[length] == 0 ))
+    {
+        return kd_command_set[first_match];
+    }
+
+    printk_cli("\n\rambiguous command, could be:");
+    show_commands_matching(first_match, match_count);
+    printk_cli("\n\r");
+    return NULL;
+}
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   On <TAB> extend partly typed command token to longest
+ *           prefix shared by all matching commands, adding a space
+ *           when one command matches.  When nothing can be added list
+ *           matching commands and redraw prompt.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+static void complete_latest_command(void)
+{
+    uint32_t first_match = 0;
+    uint32_t match_count = 0;
+    uint32_t typed_length = strlen(latest_command);
+    uint32_t common_length = 0;
+    const char* first_token;
+    const char* last_token;
+
+// Complete command token only, not arguments, and only with cursor at end of line:
+    if (( strchr(latest_command, ' ') != NULL ) || ( cursor_within_cmd_token != index_within_cmd_token ))
+    {
+        return;
+    }
+
+    match_count = commands_matching_prefix(latest_command, typed_length, &first_match);
+    if ( match_count == 0 )
+    {
+        return;
+    }
+
+// Tokens are sorted so prefix shared by all matches is that of first and last:
+    first_token = kd_command_set[first_match]->token_to_represent_command;
+    last_token = kd_command_set[first_match + match_count - 1]->token_to_represent_command;
+    while (( first_token[common_length] != 0 ) && ( first_token[common_length] == last_token[common_length] ))
+    {
+        common_length++;
+    }
+
+    if (( common_length == typed_length ) && ( match_count > 1 ))
+    {
+        show_commands_matching(first_match, match_count);
+        show_prompt_and_latest_command();
+        return;
+    }
+
+    while (( typed_length < common_length ) && ( index_within_cmd_token < (SIZE_COMMAND_TOKEN - 2) ))
+    {
+        latest_command[index_within_cmd_token] = first_token[typed_length];
+        ++index_within_cmd_token;
+        ++typed_length;
+    }
+
+    if ( match_count == 1 )
+    {
+        latest_command[index_within_cmd_token] = ' ';
+        ++index_within_cmd_token;
+    }
+
+    cursor_within_cmd_token = index_within_cmd_token;
+    redraw_latest_command();
+}
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Split command line into command token and argument spans,
+ *           look up command and pass it remainder of line.  Nothing is
+ *           copied, handler sees arguments in place in command line.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+static uint32_t command_handler(const char* latest_input)
+{
+// --- VAR BEGIN ---
+    uint32_t rstatus = 0;
+    uint32_t command_start = 0;
+    uint32_t command_length = 0;
+    const char* args = "";
+    const struct cli_command_writers_api* found;
+#if 0 // DEV BLOCK 1 START
+    char lbuf[SIZE_OF_MESSAGE_SHORT] = { 0 };
+#endif // DEV BLOCK 1 END
+// --- VAR END ---
+
+    while ( latest_input[command_start] == ' ' )
+        { command_start++; }
+
+    while (( latest_input[command_start + command_length] != 0 ) &&
+           ( latest_input[command_start + command_length] != ' ' ))
+        { command_length++; }
+
+    if ( latest_input[command_start + command_length] == ' ' )
+    {
+        args = &latest_input[command_start + command_length + 1];
+    }
+
+    rstatus = tokenize_args(args);
+
+#if 0 // // DEV BLOCK 1 START
+    snprintf(lbuf, sizeof(lbuf), "parsed %u args from present input,\n\r", (argument_count + 0));
+    printk_cli(lbuf);
+
+    rstatus |= dev_show_args();
+#endif // DEV BLOCK 1 END
+
+    found = command_lookup(&latest_input[command_start], command_length);
+
+    if ( found != NULL )
+    {
+        rstatus = found->handler(args);
+    }
+
+    return rstatus;
+}
+
+
+
+uint32_t build_command_string(const char* latest_input, const struct device* callers_uart)
+{
+    uint32_t rstatus = 0;
 
-        else if ( (present_arg_size > 0) && (input[i] == 0x20) )
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - STEP - continue any terminal escape sequence, e.g. arrow keys
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    if ( escape_state != CLI_ESCAPE_NONE )
+    {
+        if ( handle_escape_sequence(latest_input[0]) == TRUE )
         {
-#if 1
-            for ( int j = present_arg_start; j < i; j++ )
-            {
-                 argument_array[argument_count][j - present_arg_start] = input[j];
-            }
-            argument_count++;
-            present_arg_size = 0;
-#else
-int j = present_arg_start;
-printk("- store_args_from - found arg from %u to %u in input,\n", j, i);
-argument_count++;
-present_arg_size = 0;
-#endif
+            return rstatus;
         }
-        i++;
-    } // end processing while loop
+    }
 
-#ifdef DIAG_STORE_ARGS
-printk("- store_args_from - reached end of processing loop,\n");
-#endif
 
-// If end of input not white space then we have a final arg to store after prior while construct:
-    if ( present_arg_size > 0 )
+// --- 1118 b DEV BEGIN ---
+    if (( latest_input[0] == 0x08 ) || ( latest_input[0] == 0x7F ))    // . . . <BACKSPACE> key, or <DEL> as many terminals send
     {
-        for ( int j = present_arg_start; j < i; j++ )
+        delete_one_char_from_latest_command_string();
+    }
+
+    else if ( latest_input[0] == 0x2F )    // . . . '/' forward slash character
+    {
+        show_prompt_and_latest_command();
+    }
+// --- 1118 b DEV END ---
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - STEP - store and echo latest CLI character wise input
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+// If latest character printable then insert at cursor in latest command string:
+    else if ( (latest_input[0] >= 0x20) && (latest_input[0] < 0x7F) )
+    {
+        insert_char_at_cursor(latest_input[0]);
+    }
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - STEP - respond to supported control characters
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+// If latest character is <ESC> then wait for rest of escape sequence, or
+// on any other key clear the latest captured command string:
+
+    else if ( latest_input[0] == 0x1B )    // . . . <ESCAPE> key 
+    {
+        escape_state = CLI_ESCAPE_SEEN;
+    }
+
+    else if ( latest_input[0] == 0x01 )    // . . . ctrl-A, start of line
+    {
+        move_cursor_to(0);
+    }
+
+    else if ( latest_input[0] == 0x05 )    // . . . ctrl-E, end of line
+    {
+        move_cursor_to(index_within_cmd_token);
+    }
+
+    else if ( latest_input[0] == 0x15 )    // . . . ctrl-U, clear line
+    {
+        memset(latest_command, 0, sizeof(latest_command));
+        index_within_cmd_token = 0;
+        cursor_within_cmd_token = 0;
+        redraw_latest_command();
+    }
+
+// If latest character is <TAB> then complete partly typed command token:
+
+    else if ( latest_input[0] == 0x09 )    // . . . <TAB> key
+    {
+        complete_latest_command();
+    }
+
+// If latest character is <ENTER> then store line in history and call the command handler:
+
+    else if ( latest_input[0] == '\r' )
+    {
+        if ( strlen(latest_input) > 1 )
         {
-             argument_array[argument_count][j - present_arg_start] = input[j];
+            printk_cli("\n\r");
         }
-        argument_count++;
+        else
+        {
+            cli_uart_write(latest_input, 1);
+        }
+
+        cli_history_add(latest_command, index_within_cmd_token);
+        rstatus = command_handler(latest_command);
+        clear_latest_command_string();
     }
 
+    return rstatus;
+} 
 
-    if ( argument_count >= MAX_COUNT_SUPPORTED_ARGS )
-        { rstatus = WARNING_MORE_ARGS_FOUND_THAN_SUPPORTED; }
 
-    if ( i >= SIZE_COMMAND_INPUT_SUPPORTED )
-        { rstatus = WARNING_COMMAND_INPUT_LONGER_THAN_SUPPORTED; }
+//----------------------------------------------------------------------
+// - SECTION - string parsing routines
+//----------------------------------------------------------------------
 
-    if ( present_arg_size >= SUPPORTED_ARG_LENGTH )
-        { rstatus = WARNING_FOUND_ARG_LENGTH_LONGER_THAN_SUPPORTED; }
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Record offset and length of each space separated argument
+ *           in given input, relative to start of latest command line.
+ *           Input must point within latest_command.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+static uint32_t tokenize_args(const char* input)
+{
+    uint32_t rstatus = ROUTINE_OK;
+    uint32_t i = 0;
+    uint32_t start = 0;
+    uint32_t base = ( *input == 0 ? 0 : (uint32_t)(input - latest_command) );
+
+    clear_argument_array();
+
+    while ( input[i] != 0 )
+    {
+// Skip white space at start of input and between arguments:
+        if ( input[i] == ' ' )
+        {
+            i++;
+            continue;
+        }
+
+        start = i;
+        while (( input[i] != 0 ) && ( input[i] != ' ' ))
+            { i++; }
+
+        if ( argument_count >= MAX_COUNT_SUPPORTED_ARGS )
+        {
+            rstatus = WARNING_MORE_ARGS_FOUND_THAN_SUPPORTED;
+            break;
+        }
+
+        argument_spans[argument_count].offset = (uint16_t)(base + start);
+        argument_spans[argument_count].length = (uint16_t)(i - start);
+        argument_count++;
+    }
 
     return rstatus;
 }
 
 
 
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   View argument in place, no copy.  Argument is not null
+ *           terminated, use returned length.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+uint32_t arg_view(const uint32_t index_to_arg, const char** start, uint32_t* length)
+{
+    if ( index_to_arg >= argument_count )
+    {
+        return ( argument_count == 0 ? ERROR_NO_ARGS_PARSED : ERROR_TOO_FEW_ARGS_PARSED );
+    }
+
+    *start = &latest_command[argument_spans[index_to_arg].offset];
+    *length = argument_spans[index_to_arg].length;
+    return ROUTINE_OK;
+}
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Compare argument with given word, returns zero on match
+ *           like strcmp(), non-zero on mismatch or missing argument.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+uint32_t arg_compare(const uint32_t index_to_arg, const char* word)
+{
+    const char* start;
+    uint32_t length = 0;
+
+    if ( arg_view(index_to_arg, &start, &length) != ROUTINE_OK )
+    {
+        return 1;
+    }
+
+    if (( strncmp(start, word, length) == 0 ) && ( word[length] == 0 ))
+    {
+        return 0;
+    }
+
+    return 1;
+}
+
+
+
 /*
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
  *  @Note   This routine expects calling code to send pointer to
  *     memory that is large enough to hold a string of size
- *     SUPPORTED_ARG_LENGTH as defined in thread-simple-cli.h
+ *     SUPPORTED_ARG_LENGTH as defined in thread-simple-cli.h.  Longer
+ *     arguments are truncated, see arg_view() to avoid the copy.
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
  */
 
 uint32_t arg_n(const uint32_t requested_arg, char* return_arg)
 {
     uint32_t rstatus = ROUTINE_OK;
+    const char* start;
+    uint32_t length = 0;
+
+    rstatus = arg_view(requested_arg, &start, &length);
 
-    if ( requested_arg <= argument_count )
+    if ( rstatus == ROUTINE_OK )
     {
-//        strncpy(return_arg, argument_array[requested_arg], sizeof(argument_array[requested_arg]));
-        strncpy(return_arg, argument_array[requested_arg], SUPPORTED_ARG_LENGTH);
+        if ( length > (SUPPORTED_ARG_LENGTH - 1) )
+            { length = (SUPPORTED_ARG_LENGTH - 1); }
+        memcpy(return_arg, start, length);
+        return_arg[length] = 0;
     }
     else
     {
-        if ( argument_count == 0 )
-            { rstatus = ERROR_NO_ARGS_PARSED; }
-        else
-            { rstatus = ERROR_TOO_FEW_ARGS_PARSED; }
+        return_arg[0] = 0;
     }
 
     return rstatus;
@@ -754,77 +1258,91 @@ uint32_t arg_n(const uint32_t requested_arg, char* return_arg)
 
 uint32_t arg_is_decimal(const uint32_t index_to_arg, int* value_to_return)
 {
-    uint32_t tstatus = RESULT_ARG_NOT_DECIMAL;;  // test status
-    uint32_t arg_len = strlen(argument_array[index_to_arg]);
-    uint32_t multiplier = 1;
-
+    const char* start;
+    uint32_t length = 0;
+    int value = 0;
 
 // Bounds checking:
-
-    if (( index_to_arg >= 0 ) && ( index_to_arg < MAX_COUNT_SUPPORTED_ARGS ))
-        { }
-    else
+    if ( index_to_arg >= MAX_COUNT_SUPPORTED_ARGS )
         { return ERROR_CLI_ARGUMENT_INDEX_OUT_OF_RANGE; }
 
-
-    tstatus = RESULT_ARG_IS_DECIMAL;
-
-    for ( int i = 0; i < arg_len; i++ )
-    {
-        if ( ( argument_array[index_to_arg][i] < 0x30 ) || ( argument_array[index_to_arg][i] > 0x39 ) )
-        {
-            tstatus = RESULT_ARG_NOT_DECIMAL;  i = arg_len /* kick out */;
-        }
-    }
-
+    if (( arg_view(index_to_arg, &start, &length) != ROUTINE_OK ) || ( length == 0 ))
+        { return RESULT_ARG_NOT_DECIMAL; }
 
 // Note 0x30 is the ASCII value for the character zero '0':
-
-    if ( tstatus == RESULT_ARG_IS_DECIMAL )
+    for ( uint32_t i = 0; i < length; i++ )
     {
-        *value_to_return = 0;
-        for ( int i = (arg_len - 1); i >= 0; i-- )
-        {
-            *value_to_return += ( (argument_array[index_to_arg][i] - 0x30) * multiplier );
-            multiplier *= 10;
-        }
+        if ( ( start[i] < 0x30 ) || ( start[i] > 0x39 ) )
+            { return RESULT_ARG_NOT_DECIMAL; }
+        value = (value * 10) + (start[i] - 0x30);
     }
 
-    return tstatus;
+    *value_to_return = value;
+    return RESULT_ARG_IS_DECIMAL;
 }
 
 
 
-uint32_t arg_is_hex(const uint32_t arg, int* value_to_return)
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @brief    Test whether argument is hexadecimal, with or without
+ *             leading '0x', when so convert to integer value.  Same
+ *             return convention as arg_is_decimal().
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+uint32_t arg_is_hex(const uint32_t index_to_arg, int* value_to_return)
 {
-    return FALSE;
+    const char* start;
+    uint32_t length = 0;
+    uint32_t value = 0;
+    uint32_t i = 0;
+    char c = 0;
+
+    if ( index_to_arg >= MAX_COUNT_SUPPORTED_ARGS )
+        { return ERROR_CLI_ARGUMENT_INDEX_OUT_OF_RANGE; }
+
+    if ( arg_view(index_to_arg, &start, &length) != ROUTINE_OK )
+        { return RESULT_ARG_NOT_HEX; }
+
+    if (( length > 2 ) && ( start[0] == '0' ) && (( start[1] == 'x' ) || ( start[1] == 'X' )))
+        { i = 2; }
+
+// Empty, or more digits than fit in 32 bits:
+    if (( length == i ) || (( length - i ) > 8 ))
+        { return RESULT_ARG_NOT_HEX; }
+
+    for ( ; i < length; i++ )
+    {
+        c = start[i];
+        if (( c >= '0' ) && ( c <= '9' ))
+            { value = (value << 4) | (uint32_t)(c - '0'); }
+        else if (( c >= 'a' ) && ( c <= 'f' ))
+            { value = (value << 4) | (uint32_t)(c - 'a' + 10); }
+        else if (( c >= 'A' ) && ( c <= 'F' ))
+            { value = (value << 4) | (uint32_t)(c - 'A' + 10); }
+        else
+            { return RESULT_ARG_NOT_HEX; }
+    }
+
+    *value_to_return = (int)value;
+    return RESULT_ARG_IS_HEX;
 }
 
 
 
 uint32_t dec_value_at_arg_index(const uint32_t index_to_arg)
 {
-    uint32_t multiplier = 1;
-    uint32_t value_to_return = 0;
+    int value_to_return = 0;
 
 // Bounds checking:
-    if (( index_to_arg >= 0 ) && ( index_to_arg < MAX_COUNT_SUPPORTED_ARGS ))
-        { }
-    else
+    if ( index_to_arg >= MAX_COUNT_SUPPORTED_ARGS )
         { return ERROR_CLI_ARGUMENT_INDEX_OUT_OF_RANGE; }
 
-// Note 0x30 is the ASCII value for the character zero '0':
-    uint32_t arg_len = strlen(argument_array[index_to_arg]);
-    {
-        value_to_return = 0;
-        for ( int i = (arg_len - 1); i >= 0; i-- )
-        {
-            value_to_return += ( (argument_array[index_to_arg][i] - 0x30) * multiplier );
-            multiplier *= 10;
-        }
-    }
+    if ( arg_is_decimal(index_to_arg, &value_to_return) != RESULT_ARG_IS_DECIMAL )
+        { value_to_return = 0; }
 
-    return value_to_return;
+    return (uint32_t)value_to_return;
 }
 
 
@@ -841,7 +1359,7 @@ uint32_t dev_show_args(void)
         printk("- dev-show-args -\nPresent args:  ");
         for ( int i = 0; i < argument_count; i++ )
         {
-            printk("%s, ", argument_array[i]);
+            printk("%.*s, ", argument_spans[i].length, &latest_command[argument_spans[i].offset]);
         }
         printk("\n");
     }
@@ -856,9 +1374,7 @@ uint32_t dev_show_args(void)
 // - SECTION - command handlers
 //----------------------------------------------------------------------
 
-// *************************************************************************************************
-// - ADD COMMANDS - STEP 3:  add CLI routine definitions here
-// *************************************************************************************************
+// Commands for CLI itself, other commands register in their own modules:
 
 /*
  *  @Brief   Accept integer values 0-9 and map those to iis2dh Output
@@ -922,6 +1438,8 @@ uint32_t output_data_rate_handler(const char* args)
     return rstatus;
 }
 
+KD_CLI_COMMAND_DEFINE(odr, "odr", "IIS2DH Output Data Rate (ODR) set and get command", &output_data_rate_handler);
+
 
 
 uint32_t cli__help_message(const char* args)
@@ -939,10 +1457,10 @@ uint32_t cli__help_message(const char* args)
         snprintf(lbuf, SIZE_OF_MESSAGE_MEDIUM, " %*u)  %s%*s   . . . %s\n\r",
                    WIDTH_OF_BULLET_POINT,
                    (i + 1),
-                   kd_command_set[i].token_to_represent_command,
-                   (WIDTH_OF_COMMAND_TOKEN_OR_NAME - strlen(kd_command_set[i].token_to_represent_command)),
+                   kd_command_set[i]->token_to_represent_command,
+                   (WIDTH_OF_COMMAND_TOKEN_OR_NAME - strlen(kd_command_set[i]->token_to_represent_command)),
                    " ",
-                   kd_command_set[i].description
+                   kd_command_set[i]->description
                  );
 
         printk_cli(lbuf);
@@ -951,6 +1469,229 @@ uint32_t cli__help_message(const char* args)
     return ROUTINE_OK;
 }
 
+KD_CLI_COMMAND_DEFINE(help, "help", "show supported Kionix demo CLI commands", &cli__help_message);
+KD_CLI_COMMAND_DEFINE(question_mark, "?", "show supported Kionix demo CLI commands", &cli__help_message);
+
+
+
+uint32_t cli__history(const char* args)
+{
+    char lbuf[SIZE_COMMAND_TOKEN + 16];
+    char entry[SIZE_COMMAND_TOKEN];
+    uint32_t length = 0;
+    uint32_t count = cli_history_count();
+
+    printk_cli("\n\r");
+    for ( uint32_t back = count; back > 0; back-- )
+    {
+        if ( cli_history_entry(back, entry, sizeof(entry), &length) == ROUTINE_OK )
+        {
+            snprintf(lbuf, sizeof(lbuf), " %3u  %s\n\r", (count - back + 1), entry);
+            printk_cli(lbuf);
+        }
+    }
+
+    snprintf(lbuf, sizeof(lbuf), "%u of %u history bytes in use\n\r",
+      cli_history_bytes_used(), KD_APP_CLI_HISTORY_BYTES);
+    printk_cli(lbuf);
+
+    return ROUTINE_OK;
+}
+
+KD_CLI_COMMAND_DEFINE(history, "history", "show command history, recall with up and down arrows", &cli__history);
+
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - UART receive
+//----------------------------------------------------------------------
+
+#ifdef CLI_UART_INTERRUPT_DRIVEN
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   UART interrupt callback, moves every character in RX FIFO
+ *           into CLI ring buffer and wakes CLI thread once per burst.
+ *           Characters beyond ring capacity are read out of the FIFO
+ *           and counted, so RX interrupt does not stay asserted.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+static void cli_uart_isr(const struct device* dev, void* user_data)
+{
+    uint8_t byte;
+    uint8_t* data;
+    uint32_t stored = 0;
+    uint32_t claimed = 0;
+    int sent = 0;
+    k_spinlock_key_t key;
+
+    if ( !uart_irq_update(dev) )
+    {
+        return;
+    }
+
+    if ( uart_irq_rx_ready(dev) )
+    {
+        while ( uart_fifo_read(dev, &byte, 1) == 1 )
+        {
+            if ( ring_buf_put(&cli_rx_ring, &byte, 1) == 1 )
+                { stored++; }
+            else
+                { cli_rx_dropped_count++; }
+        }
+
+        if ( stored > 0 )
+        {
+            k_sem_give(&cli_rx_semaphore);
+        }
+    }
+
+    if ( uart_irq_tx_ready(dev) )
+    {
+        claimed = ring_buf_get_claim(&cli_tx_ring, &data, KD_APP_CLI_TX_BUFFER_SIZE);
+        if ( claimed > 0 )
+        {
+            sent = uart_fifo_fill(dev, data, claimed);
+            ring_buf_get_finish(&cli_tx_ring, ( sent > 0 ? sent : 0 ));
+            k_sem_give(&cli_tx_space_semaphore);
+        }
+        else
+        {
+// Disable only when still empty, a writer may have queued bytes and
+// enabled TX interrupt since claim above:
+            key = k_spin_lock(&cli_tx_lock);
+            if ( ring_buf_is_empty(&cli_tx_ring) )
+            {
+                uart_irq_tx_disable(dev);
+            }
+            k_spin_unlock(&cli_tx_lock, key);
+        }
+    }
+}
+#endif
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Select interrupt driven RX and TX for CLI UART when firmware
+ *           and UART driver support it, else leave CLI polling.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+static void cli_uart_start(const struct device* uart)
+{
+    cli_uart_interrupt_driven = 0;
+
+#ifdef CLI_UART_INTERRUPT_DRIVEN
+    uint8_t byte;
+
+    uart_irq_rx_disable(uart);
+    uart_irq_tx_disable(uart);
+
+    if ( uart_irq_callback_user_data_set(uart, cli_uart_isr, NULL) != 0 )
+    {
+        printk("- simple cli - UART lacks interrupt support, CLI polls for input\n");
+        return;
+    }
+
+// Discard any characters arrived before CLI ready:
+    while ( uart_fifo_read(uart, &byte, 1) == 1 ) { }
+
+    ring_buf_reset(&cli_rx_ring);
+    ring_buf_reset(&cli_tx_ring);
+    cli_uart_interrupt_driven = 1;
+    uart_irq_rx_enable(uart);
+#endif
+}
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Offer one received character to binary host protocol,
+ *           which claims it while a frame is arriving, else hand it
+ *           to text command line.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+static void cli_take_character(const uint8_t character, const struct device* uart)
+{
+    char latest_input[2] = { (char)character, 0 };
+    uint32_t command_line_empty = (( index_within_cmd_token == 0 ) && ( escape_state == CLI_ESCAPE_NONE ));
+
+    if ( host_protocol_claims_byte(character, command_line_empty) )
+    {
+        return;
+    }
+
+    build_command_string(latest_input, uart);
+}
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Block until CLI input available, then pass every received
+ *           character to cli_take_character() in arrival order.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+static void cli_uart_rx_process(const struct device* uart)
+{
+
+#ifdef CLI_UART_INTERRUPT_DRIVEN
+    if ( cli_uart_interrupt_driven )
+    {
+        uint8_t chunk[SIZE_CLI_RX_CHUNK];
+        uint32_t count = 0;
+
+        k_sem_take(&cli_rx_semaphore, K_FOREVER);
+
+        while ( (count = ring_buf_get(&cli_rx_ring, chunk, sizeof(chunk))) > 0 )
+        {
+            for ( int i = 0; i < count; i++ )
+            {
+                cli_take_character(chunk[i], uart);
+            }
+        }
+        return;
+    }
+#endif
+
+// Polled fallback, take all characters waiting in UART each pass:
+    unsigned char byte;
+
+    while ( uart_poll_in(uart, &byte) == 0 )
+    {
+        cli_take_character(byte, uart);
+    }
+
+    k_msleep(SLEEP_TIME__SIMPLE_CLI__MS);
+}
+
+
+
+uint32_t cli_rx_dropped_character_count(void)
+{
+    return cli_rx_dropped_count;
+}
+
+
+
+uint32_t cli_tx_dropped_byte_count(void)
+{
+    return (uint32_t)atomic_get(&cli_tx_dropped_count);
+}
+
+
+
+uint32_t cli_tx_wait_count_get(void)
+{
+    return (uint32_t)atomic_get(&cli_tx_wait_count);
+}
+
 
 
 
@@ -962,12 +1703,6 @@ uint32_t cli__help_message(const char* args)
 
 void simple_cli_thread_entry_point(void* arg1, void* arg2, void* arg3)
 {
-// --- VAR BEGIN ---
-    char lbuf[160];
-    memset(lbuf, 0, sizeof(lbuf));
-    unsigned char* msg = lbuf;
-// --- VAR END ---
-
 
 //#define UART2_NODE DT_PATH(soc, peripheral_50000000, uart_a000)
 
@@ -978,26 +1713,26 @@ void simple_cli_thread_entry_point(void* arg1, void* arg2, void* arg3)
 
     if ( uart_for_cli == NULL )
     {   
-        dmsg("Failed to assign pointer to UART2 device!\n", PROJECT_DIAG_LEVEL);
+        DMSG(THREAD_SIMPLE_CLI, KD_DIAG_ERRORS, "Failed to assign pointer to UART2 device!");
     } 
 
+    if ( uart_for_cli != NULL )
+    {
+        cli_uart_start(uart_for_cli);
+    }
+
     initialize_command_handler();
 
     while (1)
     {
         if ( uart_for_cli != NULL )
         {
-            memset(lbuf, 0, sizeof(lbuf));
-            msg = lbuf;
-            uart_poll_in(uart_for_cli, msg);
-
-            if ( strlen(msg) > 0 )
-            {
-                build_command_string(msg, uart_for_cli);
-            }
+            cli_uart_rx_process(uart_for_cli);
+        }
+        else
+        {
+            k_msleep(SLEEP_TIME__SIMPLE_CLI__MS);
         }
-
-        k_msleep(SLEEP_TIME__SIMPLE_CLI__MS);
     }
 
 } // end of thread entry point routine
@@ -1,6 +1,10 @@
 #ifndef _THREAD_SIMPLE_CLI
 #define _THREAD_SIMPLE_CLI
 
+#include <stdint.h>                // to provide define of uint32_t
+
+#include <toolchain.h>             // to provide STRUCT_SECTION_ITERABLE()
+
 /**
  *  Function to initialize Zephyr thread for STMicro IIS2DH driver code tests.
  */
@@ -11,15 +15,60 @@ int initialize_thread_simple_cli(void);
 // routine to send character stream to arbitrary, non-Zephyr-chosen UART:
 uint32_t printk_cli(const char* output);
 
+// routine to send bytes which may include 0x00, as binary host protocol frames do.
+// Bytes reach UART as one run, never split by other CLI output:
+uint32_t cli_uart_write_bytes(const uint8_t* bytes, const uint32_t count);
+
 // routine to share firmware's latest run-time argument count with commands factored into dedicated source files:
 uint32_t argument_count_from_cli_module(void);
 
+// Arguments are held as spans into latest command line, arg_view() and
+// arg_compare() read them in place, arg_n() copies one to caller's buffer:
+uint32_t arg_view(const uint32_t index_to_arg, const char** start, uint32_t* length);
+
+uint32_t arg_compare(const uint32_t index_to_arg, const char* word);
+
 uint32_t arg_n(const uint32_t requested_arg, char* return_arg);
 
 uint32_t arg_is_decimal(const uint32_t index_to_arg, int* value_to_return);
 
+uint32_t arg_is_hex(const uint32_t index_to_arg, int* value_to_return);
+
 uint32_t dec_value_at_arg_index(const uint32_t index_to_arg);
 
+// characters CLI UART received while CLI RX ring buffer was full:
+uint32_t cli_rx_dropped_character_count(void);
+
+// CLI output bytes discarded with TX buffer full, and times a caller waited for TX buffer room:
+uint32_t cli_tx_dropped_byte_count(void);
+uint32_t cli_tx_wait_count_get(void);
+
+
+
+// CLI command handlers accept text following command token, and return
+// a project return value:
+typedef uint32_t (*command_handler_t)(const char* argument_string);
+
+struct cli_command_writers_api
+{
+    const char* token_to_represent_command;
+    const char* description;
+    command_handler_t handler;
+};
+
+/*
+ *  Register a CLI command from any source file, e.g.
+ *
+ *    KD_CLI_COMMAND_DEFINE(version, "version", "show app version", &cli__kd_version);
+ *
+ *  Entries are gathered by linker into section 'cli_command_writers_api',
+ *  see src/cli-commands.ld, and CLI thread sorts them by token at start
+ *  up.  Name must be unique across the app, token need only be unique:
+ */
+#define KD_CLI_COMMAND_DEFINE(name, token, description, handler) \
+    const STRUCT_SECTION_ITERABLE(cli_command_writers_api, kd_cli_command_##name) = \
+    { token, description, handler }
+
 
 
 // 2021-11-18 - command factoring work:
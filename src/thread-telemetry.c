@@ -0,0 +1,283 @@
+/*
+ * ---------------------------------------------------------------------
+ *
+ *  @Project   Kionix Driver Demo
+ *
+ *  @File      thread-telemetry.c
+ *
+ *  @Brief     Per-thread CPU, stack and scheduling telemetry, see
+ *   thread-telemetry.h.
+ *
+ *  @Note      CPU use is share of cycles all threads, idle included,
+ *   ran since previous sample, as Zephyr thread analyzer computes it.
+ *   Times switched in come from scheduler usage analysis, which keeps
+ *   total and average cycles per run window, so windows = total /
+ *   average.  Without CONFIG_SCHED_THREAD_USAGE_ANALYSIS those counts
+ *   read zero.
+ *
+ * ---------------------------------------------------------------------
+ */
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - pound includes
+//----------------------------------------------------------------------
+
+#include <stdint.h>                // to provide define of uint32_t
+#include <string.h>                // to provide strncpy(), memset()
+
+#include <zephyr.h>
+
+#include "kd-app-config.h"
+#include "return-values.h"
+#include "thread-telemetry.h"
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - pound defines
+//----------------------------------------------------------------------
+
+#define TELEMETRY_SATURATE_U16(value) ( ( (value) > UINT16_MAX ) ? UINT16_MAX : (uint16_t)(value) )
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - file scoped variables
+//----------------------------------------------------------------------
+
+struct telemetry_sample
+{
+    uint16_t cpu_permille;
+    uint16_t stack_used;
+    uint16_t switches;
+};
+
+struct telemetry_slot
+{
+    k_tid_t thread;                // NULL while slot free
+    char name[TELEMETRY_THREAD_NAME_LENGTH];
+    uint32_t stack_size;
+    uint32_t first_sample;         // first sample with a full period of figures
+    uint64_t previous_execution_cycles;
+    uint64_t previous_windows;
+    uint32_t seen;                 // set by each pass which finds thread
+};
+
+static struct telemetry_slot slots[KD_APP_TELEMETRY_MAX_THREADS];
+static struct telemetry_sample history[KD_APP_TELEMETRY_HISTORY][KD_APP_TELEMETRY_MAX_THREADS];
+static uint32_t samples_taken;     // free running, history row is samples_taken % KD_APP_TELEMETRY_HISTORY
+static uint64_t previous_all_cycles;
+
+// Sampler on system work queue writes, CLI thread reads:
+K_MUTEX_DEFINE(telemetry_mutex);
+
+static struct k_work_delayable telemetry_work;
+
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - sampler
+//----------------------------------------------------------------------
+
+static struct telemetry_slot* slot_for_thread(const k_tid_t thread)
+{
+    struct telemetry_slot* free_slot = NULL;
+
+    for ( uint32_t i = 0; i < KD_APP_TELEMETRY_MAX_THREADS; i++ )
+    {
+        if ( slots[i].thread == thread )
+            { return &slots[i]; }
+        if (( slots[i].thread == NULL ) && ( free_slot == NULL ))
+            { free_slot = &slots[i]; }
+    }
+
+    if ( free_slot != NULL )
+    {
+        const char* name = k_thread_name_get(thread);
+
+        memset(free_slot, 0, sizeof(struct telemetry_slot));
+        free_slot->thread = thread;
+        strncpy(free_slot->name, ( name != NULL ? name : "unnamed" ), ( TELEMETRY_THREAD_NAME_LENGTH - 1 ));
+        free_slot->stack_size = thread->stack_info.size;
+// Pass which finds thread only takes its baseline counts:
+        free_slot->first_sample = ( samples_taken + 1 );
+    }
+
+    return free_slot;
+}
+
+
+
+static void sample_one_thread(const struct k_thread* cthread, void* user_data)
+{
+    k_tid_t thread = (k_tid_t)cthread;
+    uint64_t all_cycles_delta = *(uint64_t*)user_data;
+    struct telemetry_slot* slot = slot_for_thread(thread);
+    struct telemetry_sample* sample = NULL;
+    k_thread_runtime_stats_t stats;
+    uint64_t windows = 0;
+    size_t unused = 0;
+
+// More threads than slots, later ones go unrecorded:
+    if ( slot == NULL )
+        { return; }
+
+    sample = &history[( samples_taken % KD_APP_TELEMETRY_HISTORY )][( slot - slots )];
+    slot->seen = 1;
+
+    if ( k_thread_runtime_stats_get(thread, &stats) == 0 )
+    {
+        if (( all_cycles_delta > 0 ) && ( samples_taken >= slot->first_sample ))
+        {
+            sample->cpu_permille = TELEMETRY_SATURATE_U16(
+              ( ( stats.execution_cycles - slot->previous_execution_cycles ) * 1000 ) / all_cycles_delta );
+        }
+        slot->previous_execution_cycles = stats.execution_cycles;
+
+#ifdef CONFIG_SCHED_THREAD_USAGE_ANALYSIS
+        if ( stats.average_cycles > 0 )
+            { windows = ( stats.total_cycles / stats.average_cycles ); }
+#endif
+        if ( samples_taken >= slot->first_sample )
+            { sample->switches = TELEMETRY_SATURATE_U16( windows - slot->previous_windows ); }
+        slot->previous_windows = windows;
+    }
+
+    if ( k_thread_stack_space_get(thread, &unused) == 0 )
+    {
+        sample->stack_used = TELEMETRY_SATURATE_U16( slot->stack_size - unused );
+    }
+}
+
+
+
+static void telemetry_work_handler(struct k_work* work)
+{
+    k_thread_runtime_stats_t all;
+    uint64_t all_cycles_delta = 0;
+
+    ARG_UNUSED(work);
+
+    if ( k_thread_runtime_stats_all_get(&all) == 0 )
+    {
+        all_cycles_delta = ( all.execution_cycles - previous_all_cycles );
+        previous_all_cycles = all.execution_cycles;
+    }
+
+    k_mutex_lock(&telemetry_mutex, K_FOREVER);
+
+    for ( uint32_t i = 0; i < KD_APP_TELEMETRY_MAX_THREADS; i++ )
+        { slots[i].seen = 0; }
+
+    memset(history[( samples_taken % KD_APP_TELEMETRY_HISTORY )], 0, sizeof(history[0]));
+    k_thread_foreach_unlocked(sample_one_thread, &all_cycles_delta);
+
+// Threads which exited free their slots:
+    for ( uint32_t i = 0; i < KD_APP_TELEMETRY_MAX_THREADS; i++ )
+    {
+        if ( !slots[i].seen )
+            { slots[i].thread = NULL; }
+    }
+
+    samples_taken++;
+
+    k_mutex_unlock(&telemetry_mutex);
+
+    k_work_schedule(&telemetry_work, K_MSEC(KD_APP_TELEMETRY_PERIOD_MS));
+}
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - public routines
+//----------------------------------------------------------------------
+
+uint32_t initialize_thread_telemetry(void)
+{
+    k_work_init_delayable(&telemetry_work, telemetry_work_handler);
+    k_work_schedule(&telemetry_work, K_MSEC(KD_APP_TELEMETRY_PERIOD_MS));
+
+    return ROUTINE_OK;
+}
+
+
+
+uint32_t thread_telemetry_sample_count(void)
+{
+    return MIN(samples_taken, KD_APP_TELEMETRY_HISTORY);
+}
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Summarize latest 'window' samples of one thread slot, zero
+ *           meaning all samples held.  Samples before thread was first
+ *           seen are left out.  Returns KD__TELEMETRY_SLOT_EMPTY for a
+ *           free slot, KD__TELEMETRY_NO_SUCH_SLOT past last slot.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+uint32_t thread_telemetry_summary(const uint32_t slot_index, const uint32_t window,
+                                  struct thread_telemetry_summary* summary)
+{
+    struct telemetry_slot* slot = NULL;
+    const struct telemetry_sample* sample = NULL;
+    uint32_t count = 0;
+    uint32_t cpu_total = 0;
+    uint32_t switches_total = 0;
+    uint32_t rstatus = ROUTINE_OK;
+
+    if ( slot_index >= KD_APP_TELEMETRY_MAX_THREADS )
+    {
+        return KD__TELEMETRY_NO_SUCH_SLOT;
+    }
+
+    k_mutex_lock(&telemetry_mutex, K_FOREVER);
+
+    slot = &slots[slot_index];
+    count = thread_telemetry_sample_count();
+    if (( window > 0 ) && ( window < count ))
+        { count = window; }
+    count = ( samples_taken > slot->first_sample ? MIN(count, ( samples_taken - slot->first_sample )) : 0 );
+
+    if (( slot->thread == NULL ) || ( count == 0 ))
+    {
+        rstatus = KD__TELEMETRY_SLOT_EMPTY;
+    }
+    else
+    {
+        memset(summary, 0, sizeof(struct thread_telemetry_summary));
+        strncpy(summary->name, slot->name, ( TELEMETRY_THREAD_NAME_LENGTH - 1 ));
+        summary->stack_size = slot->stack_size;
+        summary->cpu_permille_min = UINT16_MAX;
+        summary->switches_min = UINT32_MAX;
+
+        for ( uint32_t i = 1; i <= count; i++ )
+        {
+            sample = &history[( ( samples_taken - i ) % KD_APP_TELEMETRY_HISTORY )][slot_index];
+
+            summary->stack_used_max = MAX(summary->stack_used_max, sample->stack_used);
+            summary->cpu_permille_min = MIN(summary->cpu_permille_min, sample->cpu_permille);
+            summary->cpu_permille_max = MAX(summary->cpu_permille_max, sample->cpu_permille);
+            summary->switches_min = MIN(summary->switches_min, sample->switches);
+            summary->switches_max = MAX(summary->switches_max, sample->switches);
+            cpu_total += sample->cpu_permille;
+            switches_total += sample->switches;
+        }
+
+        summary->cpu_permille_avg = (uint16_t)( cpu_total / count );
+        summary->switches_avg = ( switches_total / count );
+    }
+
+    k_mutex_unlock(&telemetry_mutex);
+
+    return rstatus;
+}
+
+
+
+// --- EOF ---
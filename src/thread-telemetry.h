@@ -0,0 +1,63 @@
+#ifndef _THREAD_TELEMETRY_H
+#define _THREAD_TELEMETRY_H
+
+/*
+ * ---------------------------------------------------------------------
+ *
+ *  @Project   Kionix Driver Demo
+ *
+ *  @File      thread-telemetry.h
+ *
+ *  @Brief     Background sampler of per-thread CPU use, stack high
+ *   water mark and times switched in, kept in a fixed history ring so
+ *   `st` command can show min, average and max over a window.  Data
+ *   to size thread stacks by, rather than guessing.
+ *
+ *   Sampler runs from system work queue every
+ *   KD_APP_TELEMETRY_PERIOD_MS, so costs no thread stack of its own.
+ *
+ * ---------------------------------------------------------------------
+ */
+
+#include <stdint.h>                // to provide define of uint32_t
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - symbols and structures to share with other modules
+//----------------------------------------------------------------------
+
+#define TELEMETRY_THREAD_NAME_LENGTH (24)
+
+// One thread's figures over a window of samples:
+struct thread_telemetry_summary
+{
+    char name[TELEMETRY_THREAD_NAME_LENGTH];
+    uint32_t stack_size;
+    uint32_t stack_used_max;       // high water mark, bytes
+    uint16_t cpu_permille_min;
+    uint16_t cpu_permille_avg;
+    uint16_t cpu_permille_max;
+    uint32_t switches_min;         // times switched in per sample period
+    uint32_t switches_avg;
+    uint32_t switches_max;
+};
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - routine prototypes
+//----------------------------------------------------------------------
+
+uint32_t initialize_thread_telemetry(void);
+
+// Count of samples held, up to KD_APP_TELEMETRY_HISTORY:
+uint32_t thread_telemetry_sample_count(void);
+
+// Summarize latest 'window' samples for thread slot 'slot', ROUTINE_OK while slots remain:
+uint32_t thread_telemetry_summary(const uint32_t slot, const uint32_t window,
+                                  struct thread_telemetry_summary* summary);
+
+
+
+#endif // _THREAD_TELEMETRY_H
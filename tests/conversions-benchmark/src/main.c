@@ -0,0 +1,213 @@
+/*
+ * ---------------------------------------------------------------------
+ *
+ *  @Project   Kionix Driver Demo
+ *
+ *  @File      tests/conversions-benchmark/src/main.c
+ *
+ *  @Brief     Compare two ways of decoding a FIFO block of IIS2DH
+ *   readings.  Old path, as FIFO readout did before readings were
+ *   unpacked once per block, calls float reading_in_g() on high byte
+ *   of each axis.  New path assembles 16-bit readings and converts
+ *   whole block with integer readings_to_milli_g().
+ *
+ *  @Note      native_posix simulated time stands still while code
+ *   runs, so benchmark reads host monotonic clock instead of kernel
+ *   cycle counter.
+ *
+ * ---------------------------------------------------------------------
+ */
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - pound includes
+//----------------------------------------------------------------------
+
+#include <stdlib.h>                // to provide abs()
+#include <time.h>                  // to provide host clock_gettime()
+
+#include <zephyr.h>
+#include <ztest.h>
+
+#include "common.h"
+#include "conversions.h"
+#include "iis2dh-registers.h"
+#include "return-values.h"
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - defines and file scoped
+//----------------------------------------------------------------------
+
+#ifndef CONFIG_ARCH_POSIX
+#error "benchmark reads host clock, native_posix only"
+#endif
+
+#define BYTES_PER_READING (6)
+#define READINGS_PER_BLOCK (32)
+#define BENCHMARK_BLOCKS (20000)
+
+static uint8_t raw_block[( READINGS_PER_BLOCK * BYTES_PER_READING )];
+
+static float old_results[( READINGS_PER_BLOCK * 3 )];
+static struct acc_reading_triplet unpacked[READINGS_PER_BLOCK];
+static struct acc_reading_triplet_milli_g new_results[READINGS_PER_BLOCK];
+
+static struct acc_milli_g_scale scale_2g_12_bit;
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - routines
+//----------------------------------------------------------------------
+
+static uint64_t host_time_ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ( ( (uint64_t)now.tv_sec * 1000000000ULL ) + (uint64_t)now.tv_nsec );
+}
+
+
+
+// Left justified 12-bit readings spanning -2 g to +2 g, low byte first:
+static void fill_raw_block(void)
+{
+    int16_t reading = 0;
+    uint32_t i = 0;
+    uint32_t axis = 0;
+
+    for ( i = 0; i < READINGS_PER_BLOCK; i++ )
+    {
+        for ( axis = 0; axis < 3; axis++ )
+        {
+            reading = (int16_t)( ( -2000 + (int32_t)( ( i * 3 + axis ) * 41 ) ) << 4 );
+            raw_block[( i * BYTES_PER_READING ) + ( axis * 2 ) + 0] = (uint8_t)( (uint16_t)reading & 0xFF );
+            raw_block[( i * BYTES_PER_READING ) + ( axis * 2 ) + 1] = (uint8_t)( (uint16_t)reading >> 8 );
+        }
+    }
+}
+
+
+
+static void old_decode_block(const uint8_t* raw, const uint32_t count)
+{
+    uint32_t i = 0;
+
+    for ( i = 0; i < count; i++ )
+    {
+        old_results[( i * 3 ) + 0] = reading_in_g((uint32_t)raw[( i * BYTES_PER_READING ) + 1], 0, 0);
+        old_results[( i * 3 ) + 1] = reading_in_g((uint32_t)raw[( i * BYTES_PER_READING ) + 3], 0, 0);
+        old_results[( i * 3 ) + 2] = reading_in_g((uint32_t)raw[( i * BYTES_PER_READING ) + 5], 0, 0);
+    }
+}
+
+
+
+// Same unpack thread-iis2dh.c does per FIFO block, then block conversion:
+static void new_decode_block(const uint8_t* raw, const uint32_t count)
+{
+    uint32_t i = 0;
+
+    for ( i = 0; i < count; i++ )
+    {
+        const uint8_t* r = &raw[( i * BYTES_PER_READING )];
+
+        unpacked[i].x = (uint16_t)( r[0] | ( r[1] << 8 ) );
+        unpacked[i].y = (uint16_t)( r[2] | ( r[3] << 8 ) );
+        unpacked[i].z = (uint16_t)( r[4] | ( r[5] << 8 ) );
+    }
+
+    readings_to_milli_g(unpacked, new_results, count, &scale_2g_12_bit);
+}
+
+
+
+// Nanoseconds per block, averaged over BENCHMARK_BLOCKS blocks:
+static uint32_t time_decode(void (*decode)(const uint8_t*, const uint32_t))
+{
+    uint64_t start = 0;
+    uint64_t elapsed = 0;
+    uint32_t i = 0;
+
+    decode(raw_block, READINGS_PER_BLOCK);
+
+    start = host_time_ns();
+    for ( i = 0; i < BENCHMARK_BLOCKS; i++ )
+    {
+        decode(raw_block, READINGS_PER_BLOCK);
+// Keep compiler from hoisting decode of unchanged input out of loop:
+        __asm__ volatile("" : : "r"(raw_block) : "memory");
+    }
+    elapsed = ( host_time_ns() - start );
+
+    return (uint32_t)( elapsed / BENCHMARK_BLOCKS );
+}
+
+
+
+static void* conversions_setup(void)
+{
+    zassert_equal(iis2dh_milli_g_scale(ACC_FULL_SCALE_2G, ACC_RESOLUTION_12_BIT, &scale_2g_12_bit), ROUTINE_OK, NULL);
+    fill_raw_block();
+    return NULL;
+}
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - tests
+//----------------------------------------------------------------------
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Old path gives m/s^2 from high byte only, 15.625 mg per
+ *           step at +/-2 g.  New path gives mg at 1 mg per digit, per
+ *           datasheet.  Results agree to within old step plus that
+ *           difference in scale.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+ZTEST(conversions_benchmark, test_new_decode_agrees_with_old)
+{
+    int32_t old_milli_g = 0;
+    int32_t new_milli_g = 0;
+    uint32_t i = 0;
+
+    old_decode_block(raw_block, READINGS_PER_BLOCK);
+    new_decode_block(raw_block, READINGS_PER_BLOCK);
+
+    for ( i = 0; i < READINGS_PER_BLOCK; i++ )
+    {
+        old_milli_g = (int32_t)( ( old_results[( i * 3 )] * 1000.0 ) / APPR_ACCELERATION_OF_GRAVITY );
+        new_milli_g = new_results[i].x;
+
+        zassert_true(abs(new_milli_g - old_milli_g) <= ( 16 + ( abs(new_milli_g) * 3 / 100 ) ),
+          "reading %u, old %d mg, new %d mg", i, old_milli_g, new_milli_g);
+    }
+}
+
+
+
+ZTEST(conversions_benchmark, test_benchmark_old_and_new_decode)
+{
+    uint32_t old_ns = time_decode(old_decode_block);
+    uint32_t new_ns = time_decode(new_decode_block);
+
+    TC_PRINT("decode of %u blocks of %u readings:\n", BENCHMARK_BLOCKS, READINGS_PER_BLOCK);
+    TC_PRINT("  old, reading_in_g() per axis high byte:    %u ns per block\n", old_ns);
+    TC_PRINT("  new, unpack and readings_to_milli_g():     %u ns per block\n", new_ns);
+
+    zassert_true(new_ns <= old_ns, "new decode slower, %u ns against %u ns", new_ns, old_ns);
+}
+
+
+
+ZTEST_SUITE(conversions_benchmark, NULL, conversions_setup, NULL, NULL, NULL);
+
+
+
+// --- EOF ---
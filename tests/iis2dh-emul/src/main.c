@@ -0,0 +1,383 @@
+/*
+ * ---------------------------------------------------------------------
+ *
+ *  @Project   Kionix Driver Demo
+ *
+ *  @File      tests/iis2dh-emul/src/main.c
+ *
+ *  @Brief     IIS2DH thread of app run against emulated IIS2DH on
+ *   native_posix.  Tests read sample ring as any consumer would, and
+ *   check readings for rate, delay and continuity.  Emulator X axis
+ *   counts up by one per reading generated, so a step other than one
+ *   between readings marks readings lost or repeated.
+ *
+ * ---------------------------------------------------------------------
+ */
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - pound includes
+//----------------------------------------------------------------------
+
+#include <string.h>                // to provide memset()
+
+#include <zephyr.h>
+#include <ztest.h>
+
+#include "return-values.h"
+#include "kd-app-config.h"
+#include "iis2dh-registers.h"
+#include "scoreboard.h"
+#include "kd-app-channels.h"
+#include "sample-ring.h"
+#include "thread-iis2dh.h"
+#include "emul-iis2dh.h"
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - defines
+//----------------------------------------------------------------------
+
+BUILD_ASSERT(KD_APP_DEFAULT_IIS2DH_OUTPUT_DATA_RATE == ODR_200_HZ, "tests below expect 200 Hz default ODR");
+
+#define IIS2DH_EMUL_ODR_IN_HZ (200)
+
+// IIS2DH thread sleeps 1300 ms after creation, then configures sensor:
+#define IIS2DH_THREAD_SETTLE_MS (1600)
+
+// Readings emulator FIFO holds, and time to fill it at ODR above:
+#define IIS2DH_FIFO_DEPTH (32)
+#define FIFO_FILL_TIME_MS ( ( IIS2DH_FIFO_DEPTH * 1000 ) / IIS2DH_EMUL_ODR_IN_HZ )
+
+// Time for FIFO to reach watermark, one drain per this period:
+#define WATERMARK_PERIOD_MS ( ( KD_APP_IIS2DH_FIFO_WATERMARK_LEVEL * 1000 ) / IIS2DH_EMUL_ODR_IN_HZ )
+
+// A drained block waits one watermark period in second drain buffer
+// before reaching ring, plus margin for drain and test thread wake:
+#define LATENCY_BOUND_MS ( WATERMARK_PERIOD_MS + 50 )
+
+// Readings drained but not yet in ring, plus those still below watermark:
+#define READINGS_IN_PIPELINE ( 2 * KD_APP_IIS2DH_FIFO_WATERMARK_LEVEL )
+
+#define PULL_BATCH_SIZE (32)
+
+// Three times FIFO_DRAIN_TIMEOUT_MS of thread-iis2dh.c, so every stalled drain times out:
+#define DRAIN_STALL_MS (150)
+
+#define RAMP_MASK (0x0FFF)
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - file scoped
+//----------------------------------------------------------------------
+
+struct pull_summary
+{
+    uint32_t readings;
+    uint32_t gaps;                 // steps of more than one in X ramp
+    uint32_t repeats;              // steps of zero in X ramp, stale data
+    uint32_t max_latency_us;       // ring record timestamp to pull
+};
+
+static k_tid_t iis2dh_tid;
+static uint32_t reader_id;
+
+KD_CHANNEL_SUBSCRIBER_DEFINE(test_temperature_subscriber, 2);
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - routines
+//----------------------------------------------------------------------
+
+static uint32_t ramp_value(const struct acc_sample_record* record)
+{
+    return ( ( record->xyz.x >> 4 ) & RAMP_MASK );
+}
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Pull readings from sample ring for duration_ms, polling
+ *           each millisecond, and summarize what arrived.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+static void pull_readings_for(const uint32_t duration_ms, struct pull_summary* summary)
+{
+    static struct acc_sample_record records[PULL_BATCH_SIZE];
+    struct sample_ring* ring = thread_iis2dh__sample_ring();
+    int64_t end_ms = ( k_uptime_get() + duration_ms );
+    uint32_t previous = 0;
+    uint32_t have_previous = 0;
+    uint32_t count = 0;
+    uint32_t latency_us = 0;
+    uint32_t step = 0;
+    uint32_t now = 0;
+    uint32_t i = 0;
+
+    memset(summary, 0, sizeof(*summary));
+
+    while ( k_uptime_get() < end_ms )
+    {
+        zassert_equal(sample_ring_pull(ring, reader_id, records, PULL_BATCH_SIZE, &count), ROUTINE_OK, NULL);
+        now = k_cycle_get_32();
+
+        for ( i = 0; i < count; i++ )
+        {
+            latency_us = k_cyc_to_us_floor32(now - records[i].timestamp);
+            summary->max_latency_us = MAX(summary->max_latency_us, latency_us);
+
+            if ( have_previous )
+            {
+                step = ( ( ramp_value(&records[i]) - previous ) & RAMP_MASK );
+                if ( step == 0 )
+                    { summary->repeats++; }
+                else if ( step != 1 )
+                    { summary->gaps++; }
+            }
+            previous = ramp_value(&records[i]);
+            have_previous = 1;
+        }
+        summary->readings += count;
+
+        if ( count < PULL_BATCH_SIZE )
+            { k_msleep(1); }
+    }
+}
+
+
+
+static void discard_pending_readings(void)
+{
+    static struct acc_sample_record records[PULL_BATCH_SIZE];
+    uint32_t count = 0;
+
+    do
+    {
+        sample_ring_pull(thread_iis2dh__sample_ring(), reader_id, records, PULL_BATCH_SIZE, &count);
+    } while ( count > 0 );
+}
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - test fixture
+//----------------------------------------------------------------------
+
+static void* iis2dh_emul_setup(void)
+{
+    zassert_equal(initialize_scoreboard(), ROUTINE_OK, NULL);
+    iis2dh_tid = (k_tid_t)initialize_thread_iis2dh_task();
+    k_msleep(IIS2DH_THREAD_SETTLE_MS);
+
+    zassert_equal(sample_ring_attach_reader(thread_iis2dh__sample_ring(), &reader_id), ROUTINE_OK, NULL);
+    return NULL;
+}
+
+
+
+static void iis2dh_emul_before(void* fixture)
+{
+    ARG_UNUSED(fixture);
+
+// Start each test on a block boundary with nothing queued for reader:
+    k_msleep(WATERMARK_PERIOD_MS);
+    discard_pending_readings();
+    emul_iis2dh_reset_stats();
+}
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - tests
+//----------------------------------------------------------------------
+
+ZTEST(iis2dh_emul, test_throughput_matches_output_data_rate)
+{
+    struct pull_summary summary;
+    struct emul_iis2dh_stats stats;
+
+    pull_readings_for(2000, &summary);
+    zassert_equal(emul_iis2dh_stats(&stats), ROUTINE_OK, NULL);
+
+    TC_PRINT("%u readings in 2 s, sensor generated %u, lost %u\n",
+      summary.readings, stats.readings_generated, stats.readings_lost);
+
+    zassert_within(stats.readings_generated, ( 2 * IIS2DH_EMUL_ODR_IN_HZ ), ( IIS2DH_EMUL_ODR_IN_HZ / 20 ),
+      "emulator generated %u readings", stats.readings_generated);
+    zassert_within(summary.readings, stats.readings_generated, READINGS_IN_PIPELINE,
+      "ring delivered %u of %u readings", summary.readings, stats.readings_generated);
+    zassert_equal(stats.readings_lost, 0, "sensor lost %u readings", stats.readings_lost);
+    zassert_equal(summary.gaps, 0, "%u gaps in readings", summary.gaps);
+    zassert_equal(summary.repeats, 0, "%u repeated readings", summary.repeats);
+}
+
+
+
+ZTEST(iis2dh_emul, test_latency_within_one_watermark_period)
+{
+    struct pull_summary summary;
+
+    pull_readings_for(1000, &summary);
+
+    TC_PRINT("worst drain to consumer latency %u us over %u readings, bound %u ms\n",
+      summary.max_latency_us, summary.readings, LATENCY_BOUND_MS);
+
+    zassert_true(summary.readings > 0, "no readings arrived");
+    zassert_true(summary.max_latency_us <= ( LATENCY_BOUND_MS * 1000 ),
+      "latency %u us above bound", summary.max_latency_us);
+}
+
+
+
+ZTEST(iis2dh_emul, test_overrun_marks_gap_and_stream_recovers)
+{
+    struct pull_summary summary;
+    struct emul_iis2dh_stats stats;
+
+// Keep IIS2DH thread from draining until FIFO has overrun several times over:
+    k_thread_suspend(iis2dh_tid);
+    k_msleep(3 * FIFO_FILL_TIME_MS);
+    k_thread_resume(iis2dh_tid);
+
+    pull_readings_for(500, &summary);
+    zassert_equal(emul_iis2dh_stats(&stats), ROUTINE_OK, NULL);
+
+    TC_PRINT("%u FIFO overruns, %u readings lost, %u gaps seen by consumer\n",
+      stats.fifo_overruns, stats.readings_lost, summary.gaps);
+
+    zassert_true(stats.fifo_overruns >= 1, "emulator FIFO never overran");
+    zassert_true(stats.readings_lost > 0, "no readings lost to overrun");
+    zassert_true(summary.gaps >= 1, "overrun left no gap in readings");
+    zassert_equal(summary.repeats, 0, "%u repeated readings", summary.repeats);
+
+// After overrun, readings flow at ODR again with no further loss:
+    emul_iis2dh_reset_stats();
+    pull_readings_for(1000, &summary);
+    zassert_equal(emul_iis2dh_stats(&stats), ROUTINE_OK, NULL);
+    zassert_equal(stats.readings_lost, 0, "sensor still losing readings");
+    zassert_equal(summary.gaps, 0, "%u gaps after recovery", summary.gaps);
+    zassert_within(summary.readings, IIS2DH_EMUL_ODR_IN_HZ, READINGS_IN_PIPELINE,
+      "%u readings in 1 s after recovery", summary.readings);
+}
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Each FIFO drain must hand consumers only readings it read
+ *           from sensor.  A drain which reported success without a
+ *           transfer would pass last block's buffer on again, seen
+ *           here as repeats, or as more readings delivered than the
+ *           sensor FIFO gave up.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+ZTEST(iis2dh_emul, test_fifo_drain_delivers_only_fresh_readings)
+{
+    struct pull_summary summary;
+    struct emul_iis2dh_stats stats;
+
+    pull_readings_for(1000, &summary);
+    zassert_equal(emul_iis2dh_stats(&stats), ROUTINE_OK, NULL);
+
+    TC_PRINT("%u readings delivered, %u read from FIFO in %u bus transfers, %u by callback\n",
+      summary.readings, stats.readings_read, stats.bus_transfers, stats.callback_transfers);
+
+    zassert_true(stats.readings_read > 0, "no FIFO drain reached emulator");
+    zassert_true(stats.callback_transfers > 0, "FIFO drains never took callback path");
+    zassert_equal(summary.repeats, 0, "%u stale readings delivered", summary.repeats);
+    zassert_true(summary.readings <= ( stats.readings_read + KD_APP_IIS2DH_FIFO_WATERMARK_LEVEL ),
+      "%u readings delivered, only %u read from FIFO", summary.readings, stats.readings_read);
+}
+
+
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Temperature request published on request channel reaches
+ *           IIS2DH thread with no scoreboard callback, and its reply
+ *           carries value emulator reports in OUT_TEMP_H.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+/*
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ *  @Brief   Stalled bus:  each drain outlives its wait and times out,
+ *           and its buffer stays with transfer until callback runs.
+ *           Readings of timed out drains are lost, never delivered
+ *           stale or twice, and stream recovers once bus does.
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ */
+
+ZTEST(iis2dh_emul, test_stalled_drain_times_out_and_stream_recovers)
+{
+    struct pull_summary summary;
+    struct emul_iis2dh_stats stats;
+    uint32_t timeouts_before = thread_iis2dh__fifo_drain_timeouts();
+    uint32_t timeouts = 0;
+
+    emul_iis2dh_set_transfer_cb_stall(DRAIN_STALL_MS);
+    pull_readings_for(1000, &summary);
+    emul_iis2dh_set_transfer_cb_stall(0);
+    zassert_equal(emul_iis2dh_stats(&stats), ROUTINE_OK, NULL);
+    timeouts = ( thread_iis2dh__fifo_drain_timeouts() - timeouts_before );
+
+    TC_PRINT("%u drains timed out, %u readings delivered of %u read from FIFO, %u gaps\n",
+      timeouts, summary.readings, stats.readings_read, summary.gaps);
+
+    zassert_true(timeouts > 0, "no drain timed out with bus stalled");
+    zassert_true(stats.callback_transfers > 0, "no stalled drain completed");
+    zassert_equal(summary.repeats, 0, "%u stale readings delivered", summary.repeats);
+    zassert_true(summary.readings <= ( stats.readings_read + KD_APP_IIS2DH_FIFO_WATERMARK_LEVEL ),
+      "%u readings delivered, only %u read from FIFO", summary.readings, stats.readings_read);
+
+// Let last stalled transfer finish, then readings flow at ODR again:
+    k_msleep(DRAIN_STALL_MS + WATERMARK_PERIOD_MS);
+    discard_pending_readings();
+    emul_iis2dh_reset_stats();
+    pull_readings_for(1000, &summary);
+    zassert_equal(emul_iis2dh_stats(&stats), ROUTINE_OK, NULL);
+    zassert_equal(stats.readings_lost, 0, "sensor still losing readings");
+    zassert_equal(summary.gaps, 0, "%u gaps after recovery", summary.gaps);
+    zassert_within(summary.readings, IIS2DH_EMUL_ODR_IN_HZ, READINGS_IN_PIPELINE,
+      "%u readings in 1 s after recovery", summary.readings);
+}
+
+
+
+ZTEST(iis2dh_emul, test_temperature_request_answered_on_channel)
+{
+    struct temperature_request* request = NULL;
+    const struct temperature_reading* reading = NULL;
+
+    emul_iis2dh_set_temperature(-7);
+    zassert_equal(kd_channel_subscribe(&temperature_channel, &test_temperature_subscriber), ROUTINE_OK, NULL);
+
+    request = kd_channel_claim(&temperature_request_channel, K_NO_WAIT);
+    zassert_not_null(request, "request channel pool empty");
+    request->timestamp = k_cycle_get_32();
+    zassert_equal(kd_channel_publish(request), ROUTINE_OK, NULL);
+
+// IIS2DH thread answers after its next FIFO drain:
+    zassert_equal(kd_channel_receive(&test_temperature_subscriber, (const void**)&reading,
+      K_MSEC(2 * WATERMARK_PERIOD_MS)), ROUTINE_OK, "no temperature reading published");
+    zassert_equal(reading->relative_degrees_c, -7, "reading %d C", reading->relative_degrees_c);
+    kd_channel_release(reading);
+
+    kd_channel_unsubscribe(&temperature_channel, &test_temperature_subscriber);
+    emul_iis2dh_set_temperature(25);
+}
+
+
+
+ZTEST_SUITE(iis2dh_emul, NULL, iis2dh_emul_setup, iis2dh_emul_before, NULL, NULL);
+
+
+
+// --- EOF ---
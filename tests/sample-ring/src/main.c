@@ -0,0 +1,310 @@
+/*
+ * ---------------------------------------------------------------------
+ *
+ *  @Project   Kionix Driver Demo
+ *
+ *  @File      tests/sample-ring/src/main.c
+ *
+ *  @Brief     Unit tests of lock-free sample ring:  record order as
+ *   array position and free running indices wrap, per reader overflow
+ *   accounting when producer laps a reader, and independently paced
+ *   readers.  Each record carries its push number in 'sequence', so
+ *   tests check order by sequence alone.
+ *
+ * ---------------------------------------------------------------------
+ */
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - pound includes
+//----------------------------------------------------------------------
+
+#include <string.h>                // to provide memset()
+
+#include <zephyr.h>
+#include <ztest.h>
+
+#include "return-values.h"
+#include "sample-ring.h"
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - defines and file scoped
+//----------------------------------------------------------------------
+
+#define TEST_RING_CAPACITY (8)
+#define TEST_RING_READABLE ( TEST_RING_CAPACITY - 1 )
+
+SAMPLE_RING_DEFINE(test_ring, TEST_RING_CAPACITY);
+
+// Push number of next record, and so its sequence value:
+static uint32_t next_sequence;
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - routines
+//----------------------------------------------------------------------
+
+static uint32_t push_records(const uint32_t count)
+{
+    struct acc_sample_record record;
+    uint32_t pushed = 0;
+    uint32_t i = 0;
+
+    for ( i = 0; i < count; i++ )
+    {
+        memset(&record, 0, sizeof(record));
+        record.sequence = next_sequence;
+        record.xyz.x = (uint16_t)next_sequence;
+        next_sequence++;
+
+        if ( sample_ring_push(&test_ring, &record) == ROUTINE_OK )
+            { pushed++; }
+    }
+
+    return pushed;
+}
+
+
+
+// Pull up to count records, checking they run in order from first_sequence:
+static void pull_and_check(const uint32_t reader_id, const uint32_t count, const uint32_t first_sequence)
+{
+    struct acc_sample_record records[TEST_RING_CAPACITY];
+    uint32_t pulled = 0;
+    uint32_t i = 0;
+
+    zassert_true(count <= TEST_RING_CAPACITY, NULL);
+    zassert_equal(sample_ring_pull(&test_ring, reader_id, records, count, &pulled), ROUTINE_OK, NULL);
+    zassert_equal(pulled, count, "pulled %u of %u records", pulled, count);
+
+    for ( i = 0; i < pulled; i++ )
+    {
+        zassert_equal(records[i].sequence, ( first_sequence + i ),
+          "record %u holds sequence %u, expected %u", i, records[i].sequence, ( first_sequence + i ));
+        zassert_equal(records[i].xyz.x, (uint16_t)( first_sequence + i ), NULL);
+    }
+}
+
+
+
+static void sample_ring_before(void* fixture)
+{
+    ARG_UNUSED(fixture);
+
+    memset(test_ring_records, 0, sizeof(test_ring_records));
+    atomic_set(&test_ring.head, 0);
+    atomic_set(&test_ring.readers_attached, 0);
+    atomic_set(&test_ring.overflow_count, 0);
+    for ( uint32_t i = 0; i < SAMPLE_RING_MAX_READERS; i++ )
+    {
+        atomic_set(&test_ring.tails[i], 0);
+        atomic_set(&test_ring.reader_overflows[i], 0);
+    }
+
+    next_sequence = 0;
+}
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - tests, wrap
+//----------------------------------------------------------------------
+
+ZTEST(sample_ring, test_order_kept_across_array_wrap)
+{
+    uint32_t reader = 0;
+
+    zassert_equal(sample_ring_attach_reader(&test_ring, &reader), ROUTINE_OK, NULL);
+
+    zassert_equal(push_records(5), 5, NULL);
+    pull_and_check(reader, 5, 0);
+
+// Next readable run of records starts at array position 5 and wraps:
+    zassert_equal(push_records(TEST_RING_READABLE), TEST_RING_READABLE, NULL);
+    zassert_equal(sample_ring_count_available(&test_ring, reader), TEST_RING_READABLE, NULL);
+    pull_and_check(reader, TEST_RING_READABLE, 5);
+    zassert_equal(sample_ring_count_available(&test_ring, reader), 0, NULL);
+    zassert_equal(sample_ring_reader_overflow_count(&test_ring, reader), 0, NULL);
+}
+
+
+
+ZTEST(sample_ring, test_free_running_indices_wrap_past_uint32_max)
+{
+    const uint32_t near_wrap = ( UINT32_MAX - 2 );
+    uint32_t reader = 0;
+
+    zassert_equal(sample_ring_attach_reader(&test_ring, &reader), ROUTINE_OK, NULL);
+    atomic_set(&test_ring.head, (atomic_val_t)near_wrap);
+    atomic_set(&test_ring.tails[reader], (atomic_val_t)near_wrap);
+
+    zassert_equal(push_records(TEST_RING_READABLE), TEST_RING_READABLE, NULL);
+    zassert_true((uint32_t)atomic_get(&test_ring.head) < near_wrap, "head did not wrap");
+    zassert_equal(sample_ring_count_available(&test_ring, reader), TEST_RING_READABLE, NULL);
+
+// Reader full across index wrap, one more push laps it by one:
+    zassert_equal(push_records(1), 1, NULL);
+    zassert_equal(sample_ring_count_available(&test_ring, reader), TEST_RING_READABLE, NULL);
+
+    pull_and_check(reader, 3, 1);
+    pull_and_check(reader, ( TEST_RING_READABLE - 3 ), 4);
+    zassert_equal(sample_ring_reader_overflow_count(&test_ring, reader), 1, NULL);
+}
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - tests, overflow
+//----------------------------------------------------------------------
+
+ZTEST(sample_ring, test_lapped_reader_skips_to_oldest_and_counts_loss)
+{
+    uint32_t reader = 0;
+
+    zassert_equal(sample_ring_attach_reader(&test_ring, &reader), ROUTINE_OK, NULL);
+
+// Producer never refuses a record:
+    zassert_equal(push_records(TEST_RING_CAPACITY + 3), ( TEST_RING_CAPACITY + 3 ), NULL);
+
+// Oldest records lost, reader resumes at oldest it may still read:
+    pull_and_check(reader, TEST_RING_READABLE, 4);
+    zassert_equal(sample_ring_reader_overflow_count(&test_ring, reader), 4, NULL);
+    zassert_equal(sample_ring_overflow_count(&test_ring), 4, NULL);
+
+    zassert_equal(push_records(2), 2, NULL);
+    pull_and_check(reader, 2, ( TEST_RING_CAPACITY + 3 ));
+    zassert_equal(sample_ring_reader_overflow_count(&test_ring, reader), 4, NULL);
+}
+
+
+
+ZTEST(sample_ring, test_no_overflow_without_readers)
+{
+    zassert_equal(push_records(3 * TEST_RING_CAPACITY), ( 3 * TEST_RING_CAPACITY ), NULL);
+    zassert_equal(sample_ring_overflow_count(&test_ring), 0, NULL);
+}
+
+
+
+//----------------------------------------------------------------------
+// - SECTION - tests, multiple readers
+//----------------------------------------------------------------------
+
+ZTEST(sample_ring, test_readers_pull_independently)
+{
+    uint32_t fast = 0;
+    uint32_t slow = 0;
+
+    zassert_equal(sample_ring_attach_reader(&test_ring, &fast), ROUTINE_OK, NULL);
+    zassert_equal(sample_ring_attach_reader(&test_ring, &slow), ROUTINE_OK, NULL);
+    zassert_not_equal(fast, slow, NULL);
+
+    zassert_equal(push_records(6), 6, NULL);
+    pull_and_check(fast, 6, 0);
+    pull_and_check(slow, 2, 0);
+
+// Slow reader gets lapped by two, fast reader loses nothing:
+    zassert_equal(push_records(5), 5, NULL);
+
+    zassert_equal(sample_ring_count_available(&test_ring, fast), 5, NULL);
+    zassert_equal(sample_ring_count_available(&test_ring, slow), TEST_RING_READABLE, NULL);
+    pull_and_check(fast, 5, 6);
+    pull_and_check(slow, TEST_RING_READABLE, 4);
+
+    zassert_equal(sample_ring_reader_overflow_count(&test_ring, fast), 0, NULL);
+    zassert_equal(sample_ring_reader_overflow_count(&test_ring, slow), 2, NULL);
+}
+
+
+
+ZTEST(sample_ring, test_idle_reader_does_not_hold_back_others)
+{
+    uint32_t active = 0;
+    uint32_t idle = 0;
+    uint32_t i = 0;
+
+    zassert_equal(sample_ring_attach_reader(&test_ring, &active), ROUTINE_OK, NULL);
+    zassert_equal(sample_ring_attach_reader(&test_ring, &idle), ROUTINE_OK, NULL);
+
+    for ( i = 0; i < 3; i++ )
+    {
+        zassert_equal(push_records(TEST_RING_READABLE), TEST_RING_READABLE, NULL);
+        pull_and_check(active, TEST_RING_READABLE, ( i * TEST_RING_READABLE ));
+    }
+
+    zassert_equal(sample_ring_reader_overflow_count(&test_ring, active), 0, NULL);
+
+// Idle reader wakes to newest records, and alone carries the loss:
+    pull_and_check(idle, TEST_RING_READABLE, ( 2 * TEST_RING_READABLE ));
+    zassert_equal(sample_ring_reader_overflow_count(&test_ring, idle), ( 2 * TEST_RING_READABLE ), NULL);
+    zassert_equal(sample_ring_overflow_count(&test_ring), ( 2 * TEST_RING_READABLE ), NULL);
+}
+
+
+
+ZTEST(sample_ring, test_reattached_reader_starts_without_overflows)
+{
+    uint32_t reader = 0;
+    uint32_t again = 0;
+
+    zassert_equal(sample_ring_attach_reader(&test_ring, &reader), ROUTINE_OK, NULL);
+    zassert_equal(push_records(2 * TEST_RING_CAPACITY), ( 2 * TEST_RING_CAPACITY ), NULL);
+    zassert_equal(sample_ring_count_available(&test_ring, reader), TEST_RING_READABLE, NULL);
+    pull_and_check(reader, 1, ( TEST_RING_CAPACITY + 1 ));
+    zassert_true(sample_ring_reader_overflow_count(&test_ring, reader) > 0, NULL);
+
+    zassert_equal(sample_ring_detach_reader(&test_ring, reader), ROUTINE_OK, NULL);
+    zassert_equal(sample_ring_attach_reader(&test_ring, &again), ROUTINE_OK, NULL);
+    zassert_equal(again, reader, NULL);
+    zassert_equal(sample_ring_reader_overflow_count(&test_ring, again), 0, NULL);
+    zassert_equal(sample_ring_count_available(&test_ring, again), 0, NULL);
+}
+
+
+
+ZTEST(sample_ring, test_new_reader_starts_at_head)
+{
+    uint32_t early = 0;
+    uint32_t late = 0;
+
+    zassert_equal(sample_ring_attach_reader(&test_ring, &early), ROUTINE_OK, NULL);
+    zassert_equal(push_records(3), 3, NULL);
+
+    zassert_equal(sample_ring_attach_reader(&test_ring, &late), ROUTINE_OK, NULL);
+    zassert_equal(sample_ring_count_available(&test_ring, late), 0, NULL);
+
+    zassert_equal(push_records(2), 2, NULL);
+    pull_and_check(late, 2, 3);
+    pull_and_check(early, 5, 0);
+}
+
+
+
+ZTEST(sample_ring, test_reader_slots_limited_and_checked)
+{
+    struct acc_sample_record record;
+    uint32_t reader = 0;
+    uint32_t pulled = 0;
+    uint32_t i = 0;
+
+    for ( i = 0; i < SAMPLE_RING_MAX_READERS; i++ )
+        { zassert_equal(sample_ring_attach_reader(&test_ring, &reader), ROUTINE_OK, NULL); }
+
+    zassert_equal(sample_ring_attach_reader(&test_ring, &reader), KD__SAMPLE_RING_NO_FREE_READER_SLOTS, NULL);
+    zassert_equal(sample_ring_detach_reader(&test_ring, SAMPLE_RING_MAX_READERS), KD__SAMPLE_RING_INVALID_READER, NULL);
+    zassert_equal(sample_ring_pull(&test_ring, SAMPLE_RING_MAX_READERS, &record, 1, &pulled),
+      KD__SAMPLE_RING_INVALID_READER, NULL);
+    zassert_equal(pulled, 0, NULL);
+}
+
+
+
+ZTEST_SUITE(sample_ring, NULL, NULL, sample_ring_before, NULL, NULL);
+
+
+
+// --- EOF ---
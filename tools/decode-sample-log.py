@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+#
+# ----------------------------------------------------------------------
+#
+#   Project:  Kionix Driver Demo
+#
+#      File:  decode-sample-log.py
+#
+#     Brief:  Render binary IIS2DH sample log records, as captured from
+#             the console UART after `binlog on`, to CSV.  Any text the
+#             firmware prints between records is skipped.  Record layout
+#             documented in src/thread-sample-log.h.
+#
+#     Usage:  decode-sample-log.py capture.bin > readings.csv
+#             decode-sample-log.py --cycles-per-second 32768 --full-scale 4 --resolution 10 capture.bin
+#
+# ----------------------------------------------------------------------
+
+import argparse
+import struct
+import sys
+
+
+SYNC = b"\xA5\x5A"
+FORMAT_VERSION = 1
+HEADER = struct.Struct("<2sBBII")
+TRIPLET = struct.Struct("<hhh")
+MAX_TRIPLETS_PER_RECORD = 32
+
+# Milli-g per digit by resolution in bits and full scale range in g, per
+# IIS2DH datasheet table 4.  Readings are left justified in 16 bits:
+MG_PER_DIGIT = {
+    8: {2: 16, 4: 32, 8: 64, 16: 192},
+    10: {2: 4, 4: 8, 8: 16, 16: 48},
+    12: {2: 1, 4: 2, 8: 4, 16: 12},
+}
+
+
+def records(data):
+    """Yield (sequence, timestamp, [(x, y, z), ...]) for each record found."""
+    i = data.find(SYNC)
+    while i >= 0 and i + HEADER.size <= len(data):
+        _, version, count, sequence, timestamp = HEADER.unpack_from(data, i)
+        end = i + HEADER.size + count * TRIPLET.size
+        if version != FORMAT_VERSION or not 1 <= count <= MAX_TRIPLETS_PER_RECORD or end > len(data):
+            i = data.find(SYNC, i + 1)
+            continue
+        triplets = [TRIPLET.unpack_from(data, i + HEADER.size + n * TRIPLET.size) for n in range(count)]
+        yield sequence, timestamp, triplets
+        i = data.find(SYNC, end)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Render binary IIS2DH sample log records to CSV.")
+    parser.add_argument("capture", nargs="?", help="raw UART capture, stdin when omitted")
+    parser.add_argument("--cycles-per-second", type=float, default=0,
+                        help="kernel cycle clock, when given adds a seconds column")
+    parser.add_argument("--full-scale", type=int, choices=sorted(MG_PER_DIGIT[8]),
+                        help="sensor full scale range in g, when given adds milli-g columns")
+    parser.add_argument("--resolution", type=int, choices=sorted(MG_PER_DIGIT), default=8,
+                        help="reading resolution in bits, 8 in low power mode (default)")
+    args = parser.parse_args()
+
+    if args.capture:
+        with open(args.capture, "rb") as f:
+            data = f.read()
+    else:
+        data = sys.stdin.buffer.read()
+
+    columns = ["sequence", "timestamp_cycles"]
+    if args.cycles_per_second:
+        columns.append("timestamp_s")
+    columns += ["x_raw", "y_raw", "z_raw"]
+    if args.full_scale:
+        columns += ["x_mg", "y_mg", "z_mg"]
+    print(",".join(columns))
+
+    expected_sequence = None
+    gaps = 0
+    for sequence, timestamp, triplets in records(data):
+        if expected_sequence is not None and sequence != expected_sequence:
+            gaps += 1
+        expected_sequence = sequence + len(triplets)
+
+        for n, xyz in enumerate(triplets):
+            row = [sequence + n, timestamp]
+            if args.cycles_per_second:
+                row.append("%.6f" % (timestamp / args.cycles_per_second))
+            row += list(xyz)
+            if args.full_scale:
+                shift = 16 - args.resolution
+                row += [(axis >> shift) * MG_PER_DIGIT[args.resolution][args.full_scale] for axis in xyz]
+            print(",".join(str(v) for v in row))
+
+    if gaps:
+        print("%d gaps in sequence numbers, readings dropped on target" % gaps, file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,193 @@
+#!/usr/bin/env python3
+#
+# ----------------------------------------------------------------------
+#
+#   Project:  Kionix Driver Demo
+#
+#      File:  kd-host.py
+#
+#     Brief:  Talk to firmware over the CLI UART with the binary framed
+#             host protocol, documented in src/host-protocol.h.  Text
+#             CLI stays usable on the same port between requests.
+#
+#     Usage:  kd-host.py /dev/ttyUSB0 ping
+#             kd-host.py /dev/ttyUSB0 read 0x20 6
+#             kd-host.py /dev/ttyUSB0 write 0x20 0x57
+#             kd-host.py /dev/ttyUSB0 odr 5
+#             kd-host.py /dev/ttyUSB0 stream --seconds 10 > readings.csv
+#
+#     Needs:  pyserial
+#
+# ----------------------------------------------------------------------
+
+import argparse
+import binascii
+import struct
+import sys
+import time
+
+import serial
+
+
+MSG_PING = 0x01
+MSG_READ_REGISTERS = 0x02
+MSG_WRITE_REGISTER = 0x03
+MSG_SET_ODR = 0x04
+MSG_STREAM_SAMPLES = 0x05
+MSG_REPLY = 0x80
+MSG_SAMPLE_RECORD = 0x90
+MSG_NACK = 0xFF
+
+NACK_REASONS = {1: "bad frame", 2: "unknown message", 3: "bad argument", 4: "sensor error"}
+
+# Sample record less its sync bytes, see src/thread-sample-log.h:
+RECORD_HEADER = struct.Struct("<BBII")
+TRIPLET = struct.Struct("<hhh")
+
+
+def cobs_encode(data):
+    out = bytearray()
+    block = bytearray()
+    for byte in data:
+        if byte == 0:
+            out.append(len(block) + 1)
+            out += block
+            block = bytearray()
+        else:
+            block.append(byte)
+            if len(block) == 254:
+                out.append(255)
+                out += block
+                block = bytearray()
+    out.append(len(block) + 1)
+    out += block
+    return bytes(out)
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            raise ValueError("bad COBS block")
+        out += data[i + 1:i + code]
+        i += code
+        if code != 255 and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+class HostLink:
+    def __init__(self, port, baud, timeout):
+        self.serial = serial.Serial(port, baud, timeout=0.05)
+        self.timeout = timeout
+        self.sequence = 0
+        self.pending = bytearray()
+
+    def send(self, message_type, data=b""):
+        self.sequence = (self.sequence + 1) & 0xFF
+        payload = bytes([message_type, self.sequence]) + bytes(data)
+        crc = binascii.crc_hqx(payload, 0xFFFF)
+        payload += struct.pack("<H", crc)
+        self.serial.write(b"\x00" + cobs_encode(payload) + b"\x00")
+        return self.sequence
+
+    def frames(self, deadline=None):
+        """Yield (type, sequence, data) for each good frame received.  Bytes
+        outside frames, such as CLI echo and log text, are skipped."""
+        while deadline is None or time.monotonic() < deadline:
+            self.pending += self.serial.read(512)
+            while b"\x00" in self.pending:
+                raw, _, rest = bytes(self.pending).partition(b"\x00")
+                self.pending = bytearray(rest)
+                if not raw:
+                    continue
+                try:
+                    payload = cobs_decode(raw)
+                except ValueError:
+                    continue
+                if len(payload) < 4:
+                    continue
+                body, crc = payload[:-2], struct.unpack("<H", payload[-2:])[0]
+                if binascii.crc_hqx(body, 0xFFFF) == crc:
+                    yield body[0], body[1], body[2:]
+
+    def request(self, message_type, data=b""):
+        sequence = self.send(message_type, data)
+        for reply_type, reply_sequence, reply in self.frames(time.monotonic() + self.timeout):
+            if reply_sequence != sequence:
+                continue
+            if reply_type == MSG_NACK:
+                reason = reply[1] if len(reply) > 1 else 0
+                raise RuntimeError("target refused request: %s" % NACK_REASONS.get(reason, reason))
+            if reply_type == message_type | MSG_REPLY:
+                return reply
+        raise TimeoutError("no reply to message 0x%02X" % message_type)
+
+
+def stream(link, seconds):
+    print("sequence,timestamp_cycles,x_raw,y_raw,z_raw")
+    link.request(MSG_STREAM_SAMPLES, b"\x01")
+    expected_sequence = None
+    gaps = 0
+    try:
+        deadline = time.monotonic() + seconds if seconds else None
+        for message_type, _, data in link.frames(deadline):
+            if message_type != MSG_SAMPLE_RECORD or len(data) < RECORD_HEADER.size:
+                continue
+            _, count, sequence, timestamp = RECORD_HEADER.unpack_from(data)
+            if expected_sequence is not None and sequence != expected_sequence:
+                gaps += 1
+            expected_sequence = sequence + count
+            for n in range(count):
+                xyz = TRIPLET.unpack_from(data, RECORD_HEADER.size + n * TRIPLET.size)
+                print(",".join(str(v) for v in (sequence + n, timestamp) + xyz))
+    except KeyboardInterrupt:
+        pass
+    finally:
+        link.request(MSG_STREAM_SAMPLES, b"\x00")
+    if gaps:
+        print("%d gaps in sequence numbers, readings dropped on target" % gaps, file=sys.stderr)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Binary host protocol client for Kionix Driver Demo.")
+    parser.add_argument("port", help="serial port of firmware CLI UART")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--timeout", type=float, default=1.0, help="seconds to wait for each reply")
+    commands = parser.add_subparsers(dest="command", required=True)
+    commands.add_parser("ping", help="show protocol and firmware versions")
+    read = commands.add_parser("read", help="read a block of IIS2DH registers")
+    read.add_argument("first", type=lambda s: int(s, 0))
+    read.add_argument("count", type=lambda s: int(s, 0), nargs="?", default=1)
+    write = commands.add_parser("write", help="write one IIS2DH register")
+    write.add_argument("register", type=lambda s: int(s, 0))
+    write.add_argument("value", type=lambda s: int(s, 0))
+    odr = commands.add_parser("odr", help="request IIS2DH output data rate, index as for CLI `odr`")
+    odr.add_argument("index", type=int)
+    stream_parser = commands.add_parser("stream", help="stream readings to stdout as CSV")
+    stream_parser.add_argument("--seconds", type=float, default=0, help="stop after this long, 0 runs until ctrl-C")
+    args = parser.parse_args()
+
+    link = HostLink(args.port, args.baud, args.timeout)
+
+    if args.command == "ping":
+        reply = link.request(MSG_PING)
+        print("protocol v%u, firmware %u.%u.%u" % tuple(reply[:4]))
+    elif args.command == "read":
+        reply = link.request(MSG_READ_REGISTERS, bytes([args.first, args.count]))
+        for n, value in enumerate(reply[2:]):
+            print("0x%02X: 0x%02X" % (reply[0] + n, value))
+    elif args.command == "write":
+        reply = link.request(MSG_WRITE_REGISTER, bytes([args.register, args.value]))
+        print("status %u" % reply[0])
+    elif args.command == "odr":
+        reply = link.request(MSG_SET_ODR, bytes([args.index]))
+        print("status %u" % reply[0])
+    elif args.command == "stream":
+        stream(link, args.seconds)
+
+
+if __name__ == "__main__":
+    main()